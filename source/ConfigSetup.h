@@ -39,17 +39,27 @@ EMP_BUILD_CONFIG(SymConfigBase,
     VALUE(DOMINANT_COUNT, size_t, 10, "Number of dominant hosts to select"),
     VALUE(FILE_PATH, std::string, "Data", "Output file path"),
     VALUE(FILE_NAME, std::string, "_data", "Root output file name"),
+    VALUE(DATA_FILE_FORMAT, std::string, "csv", "Format of data files: csv (text) or columnar (compressed binary columns with a schema header, written as .cols files; convert with symbulation_columnar_to_csv)"),
+    VALUE(ASYNC_OUTPUT, bool, 0, "Should output files be formatted and written by a background thread, so the simulation doesn't wait on the filesystem? (0 for no, 1 for yes)"),
+    VALUE(OUTPUT_QUEUE_SIZE, size_t, 1024, "With ASYNC_OUTPUT, how many rows (and other writes) can wait for the background writer before the simulation waits for it to catch up?"),
     VALUE(CURE, bool, 0, "Should all symbionts die (0 for no, 1 for yes)"),
     VALUE(CURE_UPDATES, int, 0, "How many updates should run before all symbionts die, will take the next update for effect"),
+    VALUE(STATS_THREADS, size_t, 1, "How many threads should be used to compute the tag matrix?"),
     
     GROUP(PHYLOGENY, "PHYLOGENY"),
     VALUE(PHYLOGENY, bool, 0, "Should the world keep track of host and symbiont phylogenies? (0 for no, 1 for yes)"),
     VALUE(TRACK_PHYLOGENY_INTERACTIONS, bool, 0, "Should the world keep track of interactions between hosts and symbionts, then write the count of all (including historical) interactions committed by tracked taxa? (0 for no, 1 for yes)?"),
     VALUE(WRITE_CURRENT_INTERACTION_COUNTS, bool, 0, "Should the world write the count of only-currently-present interactions? (0 for no, 1 for yes)"),
     VALUE(PHYLOGENY_SNAPSHOT_INTERVAL, int, 10001, "How often to output phylogeny snapshots"),
+    VALUE(PHYLOGENY_LOG, bool, 0, "Should phylogeny snapshots be appended to an incremental binary log (HostPhylogenyLog/SymPhylogenyLog .phylolog files, holding only the taxa that appeared, went extinct, or changed since the last snapshot) instead of each rewriting the whole phylogeny? Rebuild snapshots (with each taxon's values and counts as of that snapshot) with symbulation_phylogeny_log_to_csv (0 for no, 1 for yes)"),
     VALUE(NUM_PHYLO_BINS, size_t, 5, "How many bins should organisms be separated into if phylogeny is on?"),
     VALUE(PHYLOGENY_TAXON_TYPE, size_t, 0, "What are phylogeny taxa based on? 0 = binned genotypes values, 1 = exact phenotype values, 2 = bitset tag (for tag matching condition), 3 = individual-level"),
     VALUE(STORE_EXTINCT, bool, 0, "Should extinct taxa be stored? (0 for no, 1 for yes)"),
+    VALUE(PHYLOGENY_MAX_ANCESTOR_AGE, int, -1, "Remove ancestor taxa that went extinct more than this many updates ago (with the extinct lineage above them), to bound phylogeny memory in long runs (-1 keeps every ancestor)"),
+    VALUE(PHYLOGENY_MAX_ANCESTOR_DEPTH, int, -1, "Remove ancestor taxa that went extinct before the ancestor this many generations above every living taxon did; every living taxon keeps at least this many generations of ancestors (-1 keeps every ancestor)"),
+    VALUE(PHYLOGENY_PRUNE_INTERVAL, int, 1000, "How often, in updates, should PHYLOGENY_MAX_ANCESTOR_AGE and PHYLOGENY_MAX_ANCESTOR_DEPTH be applied?"),
+    VALUE(PHYLOGENY_COALESCE_EXTINCT, bool, 0, "With STORE_EXTINCT, should extinct taxa with no living descendants only be counted (in the PhylogenyMemory file) instead of each being stored? (0 for no, 1 for yes)"),
+    VALUE(PHYLOGENY_COMPACT_TAXON_DATA, bool, 0, "Should the data of taxa that go extinct be compacted into flat arrays to save memory? (0 for no, 1 for yes)"),
 
 
     GROUP(MUTATION, "Mutation"),
@@ -85,6 +95,7 @@ EMP_BUILD_CONFIG(SymConfigBase,
     VALUE(TAG_MUTATION_SIZE, double, 0.01, "What is the probability that any given position in the bitstring tag flips during mutation?"),
     VALUE(WRITE_TAG_MATRIX, bool, 0, "At the end of the experiment, should a similarity matrix of all persisting tags be generated?"),
     VALUE(TAG_MATRIX_SAMPLE_PROPORTION, double, 0.1, "What proportion of positions in the world should be sampled to produce the tag matrix from?"),
+    VALUE(TAG_MATRIX_FORMAT, std::string, "csv", "Format of the tag matrix: csv (text) or binary (compressed, written as a .tagm file; convert with symbulation_tag_matrix_to_csv)"),
     VALUE(STARTING_TAGS_ONE_PROB, double, 0, "What probability should initializing bits in tags have of being 1s? Hosted symbionts will be assigned their host's tag. (0 for basic, all-0 only tags)")
 )
 #endif
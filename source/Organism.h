@@ -6,6 +6,7 @@
 #include "ConfigSetup.h"
 #include "emp/Evolve/Systematics.hpp"
 #include "TaxonData.h"
+#include "OrganismPool.h"
 
 class Organism {
 
@@ -16,6 +17,11 @@ class Organism {
   Organism(const Organism &) = default;
   Organism(Organism &&) = default;
   virtual ~Organism() {}
+
+  // Organism memory is recycled through the OrganismPool (see OrganismPool.h).
+  // Deleting through an Organism pointer passes the size of the derived type.
+  static void* operator new(size_t size) { return OrganismPool::Get().Allocate(size); }
+  static void operator delete(void* ptr, size_t size) { OrganismPool::Get().Release(ptr, size); }
   Organism & operator=(const Organism &) = default;
   Organism & operator=(Organism &&) = default;
   virtual bool operator<(const Organism &other) const {
@@ -0,0 +1,116 @@
+#ifndef ORGANISM_POOL_H
+#define ORGANISM_POOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/*
+  Recycles the memory of dead organisms for new organisms of the same size.
+
+  Organism's class-specific operator new/delete route every organism
+  allocation through this pool, so it covers all the ways organisms are
+  created (emp::NewPtr in Reproduce/MakeNew, setup, stress escapees) and
+  destroyed (graveyard cleanup, emp::World removing hosts, host destructors
+  deleting their symbionts). Freed blocks go onto a free list for their size
+  class instead of back to malloc, and the next organism of that size reuses
+  them. Organism types have only a handful of distinct sizes, so size classes
+  are found with a short linear scan.
+
+  There is one pool per process, shared by all threads and guarded by a
+  mutex. An organism may be built on one thread and deleted on another (e.g.,
+  deaths deferred from scheduler threads to the main thread), so any thread
+  may free any block, and the next allocation on any thread can reuse it. Births and deaths are rare next to CPU cycles, so
+  the lock is cheap. Each free list holds at most MAX_FREE_BYTES, so a
+  population crash does not pin its peak memory forever.
+
+  The shared pool is never destroyed, so organisms can still be deleted
+  during static destruction or from threads that are exiting. The blocks on
+  its free lists are returned to the system at process exit.
+
+  NOTE - Only the organism objects themselves are recycled. Heap buffers that
+         organisms own (e.g. the CPU, program, and vectors in their hardware
+         state) are still freed and reallocated by their destructors and
+         constructors.
+*/
+class OrganismPool {
+public:
+  static constexpr size_t MAX_FREE_BYTES = 32 * 1024 * 1024;
+
+protected:
+  struct SizeClass {
+    size_t block_size;
+    size_t max_free;
+    std::vector<void*> free_blocks;
+  };
+
+  std::vector<SizeClass> size_classes;
+  std::mutex pool_lock; // Guards size_classes
+  bool recycling = true; // Guarded by pool_lock
+
+  SizeClass& GetSizeClass(size_t block_size) {
+    for (SizeClass& size_class : size_classes) {
+      if (size_class.block_size == block_size) return size_class;
+    }
+    const size_t max_free = (MAX_FREE_BYTES / block_size) + 1;
+    size_classes.push_back({block_size, max_free, {}});
+    return size_classes.back();
+  }
+
+public:
+  OrganismPool() = default;
+  OrganismPool(const OrganismPool&) = delete;
+  OrganismPool& operator=(const OrganismPool&) = delete;
+
+  ~OrganismPool() {
+    for (SizeClass& size_class : size_classes) {
+      for (void* block : size_class.free_blocks) ::operator delete(block);
+    }
+  }
+
+  // The process-wide pool used by Organism's operator new/delete
+  static OrganismPool& Get() {
+    static OrganismPool* pool = new OrganismPool(); // Never destroyed (see above)
+    return *pool;
+  }
+
+  // Turn recycling off (e.g., to benchmark against plain malloc). Blocks
+  // already on the free lists are still handed out.
+  void SetRecycling(bool recycle) {
+    std::lock_guard<std::mutex> lock(pool_lock);
+    recycling = recycle;
+  }
+
+  void* Allocate(size_t block_size) {
+    {
+      std::lock_guard<std::mutex> lock(pool_lock);
+      auto& free_blocks = GetSizeClass(block_size).free_blocks;
+      if (!free_blocks.empty()) {
+        void* block = free_blocks.back();
+        free_blocks.pop_back();
+        return block;
+      }
+    }
+    return ::operator new(block_size);
+  }
+
+  void Release(void* block, size_t block_size) {
+    {
+      std::lock_guard<std::mutex> lock(pool_lock);
+      SizeClass& size_class = GetSizeClass(block_size);
+      if (recycling && size_class.free_blocks.size() < size_class.max_free) {
+        size_class.free_blocks.push_back(block);
+        return;
+      }
+    }
+    ::operator delete(block);
+  }
+
+  size_t GetNumFree(size_t block_size) {
+    std::lock_guard<std::mutex> lock(pool_lock);
+    return GetSizeClass(block_size).free_blocks.size();
+  }
+};
+
+#endif
@@ -1,6 +1,10 @@
 #ifndef TAXONDATA_H
 #define TAXONDATA_H
 
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
 namespace datastruct {
 
   struct TaxonDataBase {
@@ -18,11 +22,51 @@ namespace datastruct {
       double GetIntVal() const {
         return int_val.GetMean();
       }
+
+      // Compacts data that won't change again (called when the taxon goes
+      // extinct, with PHYLOGENY_COMPACT_TAXON_DATA)
+      void Compact() { }
+
+      // Bytes held outside the taxon object itself (for memory reports)
+      size_t GetExtraBytes() const { return 0; }
   };
 
   struct HostTaxonData : TaxonDataBase {
         std::unordered_map<unsigned long long int, int> associated_syms;
-        void ClearInteractions() {associated_syms.clear();}
+        // associated_syms after Compact, sorted by symbiont taxon id
+        emp::vector<std::pair<unsigned long long int, int>> compact_syms;
+        void ClearInteractions() {associated_syms.clear(); compact_syms.clear();}
+
+        /**
+        * Input: A function taking a symbiont taxon id and an interaction count.
+        *
+        * Output: None
+        *
+        * Purpose: To visit every interaction, whether or not the data has been compacted.
+        */
+        template <typename FUN>
+        void ForEachInteraction(FUN fun) const {
+          for (auto & interaction : associated_syms) fun(interaction.first, interaction.second);
+          for (auto & interaction : compact_syms) fun(interaction.first, interaction.second);
+        }
+
+        // Moves the interactions into a flat sorted array, freeing the hash table
+        void Compact() {
+          if (associated_syms.empty()) return;
+          compact_syms.reserve(compact_syms.size() + associated_syms.size());
+          for (auto & interaction : associated_syms) compact_syms.emplace_back(interaction.first, interaction.second);
+          std::sort(compact_syms.begin(), compact_syms.end());
+          compact_syms.shrink_to_fit();
+          std::unordered_map<unsigned long long int, int>().swap(associated_syms);
+        }
+
+        size_t GetExtraBytes() const {
+          // A bucket pointer each, and a node (next pointer and entry) per interaction
+          return associated_syms.bucket_count() * sizeof(void*) +
+            associated_syms.size() * (sizeof(void*) + sizeof(std::pair<const unsigned long long int, int>)) +
+            compact_syms.capacity() * sizeof(std::pair<unsigned long long int, int>);
+        }
+
         void AddInteraction(emp::Ptr<emp::Taxon<taxon_info_t, TaxonDataBase>> sym) {
           if (emp::Has(associated_syms, sym->GetID())){
             associated_syms[sym->GetID()]++;
@@ -0,0 +1,93 @@
+// Benchmark: organism births+deaths/sec with and without the OrganismPool
+// recycling organism memory. Keeps a live population and, each step, deletes
+// a random organism and replaces it with the offspring of another (MakeNew),
+// like graveyard cleanup followed by a birth.
+//
+// Usage: ./symbulation_organism_pool.bench [births] [population size]
+//   - births: number of organisms replaced per configuration (default 200000)
+//   - population size: number of live organisms (default 10000)
+
+#include "../ConfigSetup.h"
+#include "../default_mode/DataNodes.h"
+#include "../default_mode/Host.h"
+#include "../default_mode/Symbiont.h"
+#include "../OrganismPool.h"
+
+#include "../sgp_mode/hardware/SGPHardwareSpec.h"
+#include "../sgp_mode/SGPConfigSetup.h"
+#include "../sgp_mode/SGPWorld.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "../default_mode/WorldSetup.cc"
+#include "../sgp_mode/SGPWorld.cc"
+#include "../sgp_mode/SGPWorldSetup.cc"
+#include "../sgp_mode/SGPWorldData.cc"
+#include "../sgp_mode/SGPW_InteractionMechanismSetup.cc"
+#include "../sgp_mode/SGPW_TaskProfileSetup.cc"
+
+// Replaces random members of population with offspring of other members
+double TimeChurn(emp::Random& random, emp::vector<emp::Ptr<Organism>>& population, size_t births) {
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < births; ++i) {
+    const size_t parent_id = random.GetUInt(population.size());
+    const size_t dead_id = random.GetUInt(population.size());
+    emp::Ptr<Organism> offspring = population[parent_id]->MakeNew();
+    population[dead_id].Delete();
+    population[dead_id] = offspring;
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+int main(int argc, char *argv[]) {
+  using sgp_world_t = sgpmode::SGPWorld;
+  using sgp_host_t = sgp_world_t::sgp_host_t;
+
+  size_t births = 200000;
+  size_t pop_size = 10000;
+  if (argc > 1) births = std::stoul(argv[1]);
+  if (argc > 2) pop_size = std::stoul(argv[2]);
+
+  std::cout << "org_type,pool,births,seconds,births_per_sec" << std::endl;
+  // Without the pool first: once recycling is on, freed blocks stay on the
+  // free lists.
+  for (bool recycling : {false, true}) {
+    OrganismPool::Get().SetRecycling(recycling);
+    for (const std::string org_type : {"default_host", "sgp_host"}) {
+      emp::Random random(2);
+      SymConfigBase config;
+      SymWorld world(random, &config);
+
+      sgpmode::SymConfigSGP sgp_config;
+      sgp_config.SEED(2);
+      sgp_config.GRID_X(10);
+      sgp_config.GRID_Y(10);
+      sgp_config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+      sgp_world_t sgp_world(random, &sgp_config);
+      sgp_world.Setup();
+      const auto sgp_program = sgp_world.GetProgramBuilder().CreateNotProgram(100);
+
+      emp::vector<emp::Ptr<Organism>> population;
+      for (size_t i = 0; i < pop_size; ++i) {
+        if (org_type == "default_host") {
+          population.push_back(emp::NewPtr<Host>(&random, &world, &config, random.GetDouble(-1, 1)));
+        } else {
+          population.push_back(emp::NewPtr<sgp_host_t>(&random, &sgp_world, &sgp_config, sgp_program));
+        }
+      }
+
+      const double seconds = TimeChurn(random, population, births);
+      for (emp::Ptr<Organism> org : population) org.Delete();
+
+      std::cout << org_type << ","
+                << (recycling ? "on" : "off") << ","
+                << births << ","
+                << seconds << ","
+                << ((double)births / seconds) << std::endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,88 @@
+// Benchmark: SGP host births/sec, comparing building offspring the way it was
+// done before genomes and jump tables were shared (deep-copy the program,
+// resolve every jump, mutate, then resolve every jump again) against
+// MakeNew + Mutate (share the parent's genome and jump table, and only
+// re-resolve what a mutation changed).
+//
+// Usage: ./symbulation_sgp_births.bench [births] [program length]
+//   - births: number of offspring built per configuration (default 200000)
+//   - program length: number of instructions in the parent's program (default 100)
+
+#include "../ConfigSetup.h"
+#include "../default_mode/DataNodes.h"
+#include "../default_mode/Host.h"
+#include "../default_mode/Symbiont.h"
+
+#include "../sgp_mode/hardware/SGPHardwareSpec.h"
+#include "../sgp_mode/SGPConfigSetup.h"
+#include "../sgp_mode/SGPWorld.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "../default_mode/WorldSetup.cc"
+#include "../sgp_mode/SGPWorld.cc"
+#include "../sgp_mode/SGPWorldSetup.cc"
+#include "../sgp_mode/SGPWorldData.cc"
+#include "../sgp_mode/SGPW_InteractionMechanismSetup.cc"
+#include "../sgp_mode/SGPW_TaskProfileSetup.cc"
+
+int main(int argc, char *argv[]) {
+  using world_t = sgpmode::SGPWorld;
+  using sgp_host_t = world_t::sgp_host_t;
+  using sgp_prog_t = world_t::sgp_prog_t;
+
+  size_t births = 200000;
+  size_t program_length = 100;
+  if (argc > 1) births = std::stoul(argv[1]);
+  if (argc > 2) program_length = std::stoul(argv[2]);
+
+  std::cout << "method,mut_rate,births,seconds,births_per_sec" << std::endl;
+  for (double mut_rate : {0.0, 0.0001, 0.001, 0.01}) {
+    for (const std::string method : {"copy_and_reset", "shared"}) {
+      sgpmode::SymConfigSGP config;
+      config.SEED(2);
+      config.GRID_X(10);
+      config.GRID_Y(10);
+      config.SGP_MUT_PER_BIT_RATE(mut_rate);
+      config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+
+      emp::Random random(config.SEED());
+      world_t world(random, &config);
+      world.Setup();
+
+      // Scramble an ancestor program so the parent has anchors and jumps.
+      sgp_prog_t parent_program = world.GetProgramBuilder().CreateNotProgram(program_length);
+      world.GetMutator().SetPerBitMutationRate(0.02);
+      world.GetMutator().MutateProgram(parent_program);
+      world.GetMutator().SetPerBitMutationRate(mut_rate);
+      emp::Ptr<sgp_host_t> parent = emp::NewPtr<sgp_host_t>(&random, &world, &config, parent_program);
+
+      const auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < births; ++i) {
+        if (method == "shared") {
+          emp::Ptr<Organism> offspring = parent->MakeNew();
+          offspring->Mutate();
+          offspring.Delete();
+        } else {
+          emp::Ptr<sgp_host_t> offspring = emp::NewPtr<sgp_host_t>(&random, &world, &config, parent->GetProgram());
+          sgp_prog_t program(offspring->GetProgram());
+          world.GetMutator().MutateProgram(program);
+          offspring->GetHardware().SetProgram(program);
+          offspring.Delete();
+        }
+      }
+      const auto stop = std::chrono::steady_clock::now();
+      const double seconds = std::chrono::duration<double>(stop - start).count();
+      parent.Delete();
+
+      std::cout << method << ","
+                << mut_rate << ","
+                << births << ","
+                << seconds << ","
+                << ((double)births / seconds) << std::endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,72 @@
+// Benchmark: SGP mode updates/sec as CYCLES_PER_UPDATE increases, with and
+// without batched CPU execution (BATCH_CPU_EXEC).
+//
+// Usage: ./symbulation_sgp_cpu_exec.bench [max cycles per update] [updates] [grid width]
+//   - max cycles per update: cycles per update doubles from 4 up to this value (default 128)
+//   - updates: number of timed updates per configuration (default 50)
+//   - grid width: world is grid width x grid width (default 50)
+
+#include "../ConfigSetup.h"
+#include "../default_mode/DataNodes.h"
+#include "../default_mode/Host.h"
+#include "../default_mode/Symbiont.h"
+
+#include "../sgp_mode/hardware/SGPHardwareSpec.h"
+#include "../sgp_mode/SGPConfigSetup.h"
+#include "../sgp_mode/SGPWorld.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "../default_mode/WorldSetup.cc"
+#include "../sgp_mode/SGPWorld.cc"
+#include "../sgp_mode/SGPWorldSetup.cc"
+#include "../sgp_mode/SGPWorldData.cc"
+#include "../sgp_mode/SGPW_InteractionMechanismSetup.cc"
+#include "../sgp_mode/SGPW_TaskProfileSetup.cc"
+
+int main(int argc, char *argv[]) {
+  size_t max_cycles = 128;
+  size_t updates = 50;
+  size_t grid_width = 50;
+  if (argc > 1) max_cycles = std::stoul(argv[1]);
+  if (argc > 2) updates = std::stoul(argv[2]);
+  if (argc > 3) grid_width = std::stoul(argv[3]);
+
+  std::cout << "cycles_per_update,batch_cpu_exec,updates,seconds,updates_per_sec,final_num_orgs" << std::endl;
+  for (size_t cycles = 4; cycles <= max_cycles; cycles *= 2) {
+    for (bool batch : {false, true}) {
+      sgpmode::SymConfigSGP config;
+      config.SEED(2);
+      config.GRID(1);
+      config.GRID_X(grid_width);
+      config.GRID_Y(grid_width);
+      config.POP_SIZE(grid_width * grid_width);
+      config.START_MOI(1);
+      config.FREE_LIVING_SYMS(0);
+      config.CYCLES_PER_UPDATE(cycles);
+      config.BATCH_CPU_EXEC(batch);
+      config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+
+      emp::Random random(config.SEED());
+      sgpmode::SGPWorld world(random, &config);
+      world.Setup();
+
+      const auto start = std::chrono::steady_clock::now();
+      for (size_t u = 0; u < updates; ++u) {
+        world.Update();
+      }
+      const auto stop = std::chrono::steady_clock::now();
+      const double seconds = std::chrono::duration<double>(stop - start).count();
+
+      std::cout << cycles << ","
+                << batch << ","
+                << updates << ","
+                << seconds << ","
+                << ((double)updates / seconds) << ","
+                << world.GetNumOrgs() << std::endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,68 @@
+// Benchmark: SGP mode updates/sec as the number of scheduler threads increases.
+//
+// Usage: ./symbulation_sgp_scheduler.bench [max threads] [updates] [grid width]
+//   - max threads: defaults to the number of hardware threads
+//   - updates: number of timed updates per thread count (default 100)
+//   - grid width: world is grid width x grid width (default 100)
+
+#include "../ConfigSetup.h"
+#include "../default_mode/DataNodes.h"
+#include "../default_mode/Host.h"
+#include "../default_mode/Symbiont.h"
+
+#include "../sgp_mode/hardware/SGPHardwareSpec.h"
+#include "../sgp_mode/SGPConfigSetup.h"
+#include "../sgp_mode/SGPWorld.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "../default_mode/WorldSetup.cc"
+#include "../sgp_mode/SGPWorld.cc"
+#include "../sgp_mode/SGPWorldSetup.cc"
+#include "../sgp_mode/SGPWorldData.cc"
+#include "../sgp_mode/SGPW_InteractionMechanismSetup.cc"
+#include "../sgp_mode/SGPW_TaskProfileSetup.cc"
+
+int main(int argc, char *argv[]) {
+  size_t max_threads = emp::Max(std::thread::hardware_concurrency(), 1u);
+  size_t updates = 100;
+  size_t grid_width = 100;
+  if (argc > 1) max_threads = std::stoul(argv[1]);
+  if (argc > 2) updates = std::stoul(argv[2]);
+  if (argc > 3) grid_width = std::stoul(argv[3]);
+
+  std::cout << "threads,updates,seconds,updates_per_sec,final_num_orgs" << std::endl;
+  for (size_t thread_count = 1; thread_count <= max_threads; ++thread_count) {
+    sgpmode::SymConfigSGP config;
+    config.SEED(2);
+    config.GRID(1);
+    config.GRID_X(grid_width);
+    config.GRID_Y(grid_width);
+    config.POP_SIZE(grid_width * grid_width);
+    config.START_MOI(1);
+    config.FREE_LIVING_SYMS(0);
+    config.THREAD_COUNT(thread_count);
+    config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+
+    emp::Random random(config.SEED());
+    sgpmode::SGPWorld world(random, &config);
+    world.Setup();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t u = 0; u < updates; ++u) {
+      world.Update();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+
+    std::cout << thread_count << ","
+              << updates << ","
+              << seconds << ","
+              << ((double)updates / seconds) << ","
+              << world.GetNumOrgs() << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,137 @@
+// Benchmark: filling the population-scanning data nodes, comparing a separate
+// loop over the world for each data node against the fused StatsEngine pass.
+//
+// Usage: ./symbulation_stats_engine.bench [world size] [passes]
+//   - world size: number of world positions (default 10000)
+//   - passes: number of times the data nodes are filled (default 1000)
+
+#include "../ConfigSetup.h"
+#include "../default_mode/DataNodes.h"
+#include "../default_mode/Host.h"
+#include "../default_mode/Symbiont.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "../default_mode/WorldSetup.cc"
+
+int main(int argc, char *argv[]) {
+  using pop_t = StatsEngine::pop_t;
+  using node_t = emp::DataMonitor<double>;
+
+  size_t world_size = 10000;
+  size_t passes = 1000;
+  if (argc > 1) world_size = std::stoul(argv[1]);
+  if (argc > 2) passes = std::stoul(argv[2]);
+
+  emp::Random random(2);
+  SymConfigBase config;
+  config.FREE_LIVING_SYMS(1);
+  config.SYM_LIMIT(3);
+  SymWorld world(random, &config);
+  world.Resize(world_size);
+  for (size_t i = 0; i < world_size; ++i) {
+    if (random.P(0.8)) {
+      emp::Ptr<Host> host = emp::NewPtr<Host>(&random, &world, &config, random.GetDouble(-1, 1));
+      world.AddOrgAt(host, i);
+      size_t num_syms = random.GetUInt(4);
+      for (size_t j = 0; j < num_syms; ++j) {
+        host->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, random.GetDouble(-1, 1)));
+      }
+    }
+    if (random.P(0.2)) {
+      world.AddOrgAt(emp::NewPtr<Symbiont>(&random, &world, &config, random.GetDouble(-1, 1)), emp::WorldPosition(0, i));
+    }
+  }
+  const pop_t pop = world.GetPop();
+  const pop_t sym_pop = world.GetSymPop();
+
+  // The same five data nodes for every method: host count, symbiont count,
+  // host interaction values, symbiont interaction values, and symbiont
+  // infection chances
+  const size_t NUM_NODES = 5;
+  auto checksum = [](emp::vector<node_t>& nodes) {
+    double total = 0;
+    for (node_t& node : nodes) total += node.GetTotal() + node.GetCount();
+    return total;
+  };
+
+  std::cout << "method,world_size,passes,ms_per_pass,checksum" << std::endl;
+  auto report = [&](const std::string& method, double seconds, double sum) {
+    std::cout << method << "," << world_size << "," << passes << ","
+              << (1000 * seconds / passes) << "," << sum << std::endl;
+  };
+
+  // One loop over the world per data node
+  emp::vector<node_t> scan_nodes(NUM_NODES);
+  const auto scan_start = std::chrono::steady_clock::now();
+  for (size_t pass = 0; pass < passes; ++pass) {
+    for (node_t& node : scan_nodes) node.Reset();
+    for (size_t i = 0; i < pop.size(); ++i) {
+      if (pop[i]) scan_nodes[0].AddDatum(1);
+    }
+    for (size_t i = 0; i < pop.size(); ++i) {
+      if (pop[i]) scan_nodes[1].AddDatum(pop[i]->GetSymbionts().size());
+      if (sym_pop[i]) scan_nodes[1].AddDatum(1);
+    }
+    for (size_t i = 0; i < pop.size(); ++i) {
+      if (pop[i]) scan_nodes[2].AddDatum(pop[i]->GetIntVal());
+    }
+    for (size_t i = 0; i < pop.size(); ++i) {
+      if (pop[i]) {
+        for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) scan_nodes[3].AddDatum(sym->GetIntVal());
+      }
+      if (sym_pop[i]) scan_nodes[3].AddDatum(sym_pop[i]->GetIntVal());
+    }
+    for (size_t i = 0; i < pop.size(); ++i) {
+      if (pop[i]) {
+        for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) scan_nodes[4].AddDatum(sym->GetInfectionChance());
+      }
+      if (sym_pop[i]) scan_nodes[4].AddDatum(sym_pop[i]->GetInfectionChance());
+    }
+  }
+  const auto scan_stop = std::chrono::steady_clock::now();
+  const double scan_checksum = checksum(scan_nodes);
+  report("per_node_scans", std::chrono::duration<double>(scan_stop - scan_start).count(), scan_checksum);
+
+  int result = 0;
+  emp::vector<node_t> nodes(NUM_NODES);
+  StatsEngine engine;
+  emp::vector<size_t> channels;
+  for (node_t& node : nodes) channels.push_back(engine.AddChannel(node));
+  engine.AddHostVisitor(channels[0], [channel = channels[0]](Organism&, StatsEngine::Emitter& out) {
+    out.Emit(channel, 1);
+  });
+  engine.AddVisitor(channels[1], [channel = channels[1]](Organism& host, StatsEngine::Emitter& out) {
+    out.Emit(channel, host.GetSymbionts().size());
+  }, StatsEngine::Skip{}, [channel = channels[1]](Organism&, StatsEngine::Emitter& out) {
+    out.Emit(channel, 1);
+  });
+  engine.AddHostVisitor(channels[2], [channel = channels[2]](Organism& host, StatsEngine::Emitter& out) {
+    out.Emit(channel, host.GetIntVal());
+  });
+  engine.AddSymVisitor(channels[3], [channel = channels[3]](Organism&, Organism& sym, StatsEngine::Emitter& out) {
+    out.Emit(channel, sym.GetIntVal());
+  }, [channel = channels[3]](Organism& sym, StatsEngine::Emitter& out) {
+    out.Emit(channel, sym.GetIntVal());
+  });
+  engine.AddSymVisitor(channels[4], [channel = channels[4]](Organism&, Organism& sym, StatsEngine::Emitter& out) {
+    out.Emit(channel, sym.GetInfectionChance());
+  }, [channel = channels[4]](Organism& sym, StatsEngine::Emitter& out) {
+    out.Emit(channel, sym.GetInfectionChance());
+  });
+
+  const auto engine_start = std::chrono::steady_clock::now();
+  for (size_t pass = 0; pass < passes; ++pass) {
+    engine.Run(pop, sym_pop);
+  }
+  const auto engine_stop = std::chrono::steady_clock::now();
+  const double engine_checksum = checksum(nodes);
+  report("stats_engine", std::chrono::duration<double>(engine_stop - engine_start).count(), engine_checksum);
+  if (engine_checksum != scan_checksum) {
+    std::cout << "Data nodes differ!" << std::endl;
+    result = 1;
+  }
+  return result;
+}
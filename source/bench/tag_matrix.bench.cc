@@ -0,0 +1,74 @@
+// Benchmark: computing a host-by-symbiont tag distance matrix (WRITE_TAG_MATRIX),
+// comparing calling emp::HammingMetric for every pair against TagDistanceMatrix
+// (packed words, vectorized popcounts, cache-blocked tiles) with one thread
+// and with several.
+//
+// Usage: ./symbulation_tag_matrix.bench [organisms] [threads]
+//   - organisms: number of host tags and of symbiont tags (default 10000)
+//   - threads: threads for the multithreaded run (default: hardware threads)
+
+#include "../ConfigSetup.h"
+#include "../default_mode/TagDistanceMatrix.h"
+
+#include "emp/matching/MatchBin.hpp"
+#include "emp/math/Random.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+int main(int argc, char *argv[]) {
+  using tag_t = emp::BitSet<TAG_LENGTH>;
+
+  size_t num_orgs = 10000;
+  size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  if (argc > 1) num_orgs = std::stoul(argv[1]);
+  if (argc > 2) num_threads = std::stoul(argv[2]);
+
+  emp::Random random(2);
+  emp::vector<tag_t> host_tags;
+  emp::vector<tag_t> sym_tags;
+  for (size_t i = 0; i < num_orgs; ++i) {
+    host_tags.push_back(tag_t(random, 0.5));
+    sym_tags.push_back(tag_t(random, 0.5));
+  }
+
+  // Per pair
+  emp::HammingMetric<TAG_LENGTH> metric;
+  double metric_checksum = 0;
+  const auto metric_start = std::chrono::steady_clock::now();
+  for (const tag_t& host_tag : host_tags) {
+    for (const tag_t& sym_tag : sym_tags) metric_checksum += metric(host_tag, sym_tag);
+  }
+  const auto metric_stop = std::chrono::steady_clock::now();
+
+  std::cout << "method,organisms,threads,seconds,ns_per_pair,checksum" << std::endl;
+  const double metric_seconds = std::chrono::duration<double>(metric_stop - metric_start).count();
+  const double pairs = (double) num_orgs * num_orgs;
+  std::cout << "hamming_metric," << num_orgs << ",1," << metric_seconds << ","
+            << (1e9 * metric_seconds / pairs) << "," << metric_checksum << std::endl;
+
+  int result = 0;
+  for (size_t threads : {(size_t) 1, num_threads}) {
+    const auto matrix_start = std::chrono::steady_clock::now();
+    TagDistanceMatrix<TAG_LENGTH> matrix;
+    for (const tag_t& tag : host_tags) matrix.AddRow(tag);
+    for (const tag_t& tag : sym_tags) matrix.AddColumn(tag);
+    matrix.Compute(threads);
+    const auto matrix_stop = std::chrono::steady_clock::now();
+
+    double matrix_checksum = 0;
+    for (size_t row = 0; row < num_orgs; ++row) {
+      for (size_t column = 0; column < num_orgs; ++column) matrix_checksum += matrix.GetDistance(row, column);
+    }
+    const double matrix_seconds = std::chrono::duration<double>(matrix_stop - matrix_start).count();
+    std::cout << "tag_distance_matrix," << num_orgs << "," << threads << "," << matrix_seconds << ","
+              << (1e9 * matrix_seconds / pairs) << "," << matrix_checksum << std::endl;
+    if (matrix_checksum != metric_checksum) {
+      std::cout << "Distances differ!" << std::endl;
+      result = 1;
+    }
+  }
+  return result;
+}
@@ -0,0 +1,37 @@
+// Benchmark: time to generate a LogicTaskIOBank (all nine two-input logic
+// tasks plus NOT) for several bank sizes.
+//
+// Usage: ./symbulation_task_io_bank_build.bench [max bank size]
+//   - max bank size: largest bank to generate (default 100000)
+
+#include "../sgp_mode/tasks/LogicTaskIOBank.h"
+
+#include "emp/math/Random.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[]) {
+  using namespace sgpmode::tasks;
+
+  size_t max_bank_size = 100000;
+  if (argc > 1) max_bank_size = std::stoul(argv[1]);
+
+  emp::Random random(2);
+  LogicTaskSet task_set;
+  task_set.AddTasksByName({"NOT", "NAND", "OR_NOT", "AND", "OR", "AND_NOT", "NOR", "XOR", "EQU"});
+  LogicTaskIOBank io_bank(random, task_set);
+
+  std::cout << "bank_size,seconds,envs_per_sec" << std::endl;
+  for (size_t bank_size = 1000; bank_size <= max_bank_size; bank_size *= 10) {
+    const auto start = std::chrono::steady_clock::now();
+    io_bank.GenerateBank(bank_size);
+    const auto stop = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+    std::cout << bank_size << ","
+              << seconds << ","
+              << ((double)bank_size / seconds) << std::endl;
+  }
+  return 0;
+}
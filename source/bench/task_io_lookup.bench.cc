@@ -0,0 +1,84 @@
+// Micro-benchmark: looking up which tasks an output value is correct for in a
+// LogicTaskIOBank::TaskIO, comparing the hash containers (IsValidOutput + GetTaskIDs)
+// against the compact sorted lookup (GetTaskMask).
+//
+// Usage: ./symbulation_task_io_lookup.bench [queries] [bank size]
+//   - queries: number of output values looked up per method (default 10000000)
+//   - bank size: number of task environments (default 1000)
+
+#include "../sgp_mode/tasks/LogicTaskIOBank.h"
+
+#include "emp/math/Random.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[]) {
+  using namespace sgpmode::tasks;
+  using output_t = LogicTaskIOBank::output_t;
+  using task_mask_t = LogicTaskIOBank::task_mask_t;
+
+  size_t num_queries = 10000000;
+  size_t bank_size = 1000;
+  if (argc > 1) num_queries = std::stoul(argv[1]);
+  if (argc > 2) bank_size = std::stoul(argv[2]);
+
+  emp::Random random(2);
+  LogicTaskSet task_set;
+  task_set.AddTasksByName({"NOT", "NAND", "OR_NOT", "AND", "OR", "AND_NOT", "NOR", "XOR", "EQU"});
+  LogicTaskIOBank io_bank(random, task_set);
+  io_bank.GenerateBank(bank_size);
+
+  // Queries are (environment, output) pairs. Organisms mostly output incorrect
+  // values, so only a quarter of the queries are correct outputs.
+  emp::vector<size_t> query_envs(num_queries);
+  emp::vector<output_t> query_outputs(num_queries);
+  for (size_t i = 0; i < num_queries; ++i) {
+    query_envs[i] = random.GetUInt(bank_size);
+    const auto& task_io = io_bank.GetIO(query_envs[i]);
+    if (random.P(0.25)) {
+      const size_t task_id = random.GetUInt(task_set.GetSize());
+      const auto& task_outputs = task_io.correct_outputs[task_id];
+      query_outputs[i] = task_outputs[random.GetUInt(task_outputs.size())].output;
+    } else {
+      query_outputs[i] = random.GetUInt();
+    }
+  }
+
+  // Hash containers
+  task_mask_t hash_checksum = 0;
+  const auto hash_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < num_queries; ++i) {
+    const auto& task_io = io_bank.GetIO(query_envs[i]);
+    const output_t output = query_outputs[i];
+    if (task_io.IsValidOutput(output)) {
+      for (size_t task_id : task_io.GetTaskIDs(output)) {
+        hash_checksum += task_mask_t{1} << task_id;
+      }
+    }
+  }
+  const auto hash_stop = std::chrono::steady_clock::now();
+
+  // Compact lookup
+  task_mask_t mask_checksum = 0;
+  const auto mask_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < num_queries; ++i) {
+    mask_checksum += io_bank.GetIO(query_envs[i]).GetTaskMask(query_outputs[i]);
+  }
+  const auto mask_stop = std::chrono::steady_clock::now();
+
+  const double hash_seconds = std::chrono::duration<double>(hash_stop - hash_start).count();
+  const double mask_seconds = std::chrono::duration<double>(mask_stop - mask_start).count();
+  std::cout << "method,queries,seconds,ns_per_query,checksum" << std::endl;
+  std::cout << "hash," << num_queries << "," << hash_seconds << ","
+            << (1e9 * hash_seconds / num_queries) << "," << hash_checksum << std::endl;
+  std::cout << "task_mask," << num_queries << "," << mask_seconds << ","
+            << (1e9 * mask_seconds / num_queries) << "," << mask_checksum << std::endl;
+
+  if (hash_checksum != mask_checksum) {
+    std::cout << "Lookup results differ!" << std::endl;
+    return 1;
+  }
+  return 0;
+}
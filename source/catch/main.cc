@@ -7,13 +7,20 @@
 
 #include "../test/default_mode_test/SymWorld.test.cc"
 #include "../test/default_mode_test/DataNodes.test.cc"
+#include "../test/default_mode_test/StatsEngine.test.cc"
+#include "../test/default_mode_test/ColumnarDataFile.test.cc"
+#include "../test/default_mode_test/AsyncOutput.test.cc"
+#include "../test/default_mode_test/OrganismPool.test.cc"
 #include "../test/default_mode_test/Host.test.cc"
 #include "../test/default_mode_test/Symbiont.test.cc"
 #include "../test/default_mode_test/HostSymbiontInteraction.test.cc"
 #include "../test/default_mode_test/HostSymbiontUnitTest.test.cc"
 #include "../test/default_mode_test/CureHosts.test.cc"
 #include "../test/default_mode_test/Phylogenies.test.cc"
+#include "../test/default_mode_test/PhylogenyLog.test.cc"
+#include "../test/default_mode_test/PhylogenyPruning.test.cc"
 #include "../test/default_mode_test/TagMatching.test.cc"
+#include "../test/default_mode_test/TagDistanceMatrix.test.cc"
 
 #include "../test/efficient_mode_test/EfficientSymbiont.test.cc"
 #include "../test/efficient_mode_test/EfficientHost.test.cc"
@@ -57,6 +64,11 @@
 
 
 #include "../test/sgp_mode_test/unit_tests/RingBuffer.test.cc"
+#include "../test/sgp_mode_test/unit_tests/ReproductionQueue.test.cc"
+#include "../test/sgp_mode_test/unit_tests/LogicTaskIOBank.test.cc"
+#include "../test/sgp_mode_test/unit_tests/CPUState.test.cc"
+#include "../test/sgp_mode_test/unit_tests/GenotypeRegistry.test.cc"
+#include "../test/sgp_mode_test/unit_tests/SGPMutator.test.cc"
 #include "../test/sgp_mode_test/unit_tests/Stacks.test.cc"
 #include "../test/sgp_mode_test/unit_tests/utils.test.cc"
 #include "../test/sgp_mode_test/unit_tests/SGPCureHosts.test.cc"
@@ -68,6 +80,8 @@
 #include "../test/sgp_mode_test/functional_tests/SGPSymbiont_Reproduce.test.cc"
 #include "../test/sgp_mode_test/functional_tests/TempChangingEnvironments.test.cc"
 #include "../test/sgp_mode_test/functional_tests/SGPWorld.test.cc"
+#include "../test/sgp_mode_test/functional_tests/SGPWorld_Threading.test.cc"
+#include "../test/sgp_mode_test/functional_tests/SGPWorld_Checkpoint.test.cc"
 
 // Anya's tests
 #include "../test/sgp_mode_test/unit_tests/SGPWorld.test.cc"
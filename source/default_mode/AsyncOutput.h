@@ -0,0 +1,280 @@
+#ifndef ASYNC_OUTPUT_H
+#define ASYNC_OUTPUT_H
+
+#include "../../Empirical/include/emp/base/assert.hpp"
+#include "../../Empirical/include/emp/base/Ptr.hpp"
+#include "../../Empirical/include/emp/data/DataFile.hpp"
+
+#include "ColumnarDataFile.h"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#ifndef __EMSCRIPTEN__
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+#endif
+
+/*
+  Runs output jobs (formatting, compressing, writing, and syncing files) on a
+  background thread, in the order they were pushed.
+
+  The queue is bounded: once capacity jobs are waiting, Push blocks until the
+  writer catches up (back-pressure), so a slow filesystem slows the
+  simulation down instead of growing memory without limit.
+
+  NOTE - The web build (Emscripten) has no writer thread or file syncing:
+         jobs run on the calling thread as soon as they're pushed.
+*/
+class AsyncWriter {
+protected:
+#ifndef __EMSCRIPTEN__
+  std::thread thread;
+#endif
+  std::mutex lock;
+  std::condition_variable has_jobs_cv;
+  std::condition_variable has_space_cv;
+  std::condition_variable idle_cv;
+  std::deque<std::function<void()>> jobs;
+  size_t capacity;
+  bool running_job = false;
+  bool stopping = false;
+  size_t blocked_pushes = 0;
+
+#ifndef __EMSCRIPTEN__
+  void Run() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+      has_jobs_cv.wait(guard, [this]() { return stopping || !jobs.empty(); });
+      if (jobs.empty()) return; // Stopping, with every job done
+      std::function<void()> job = std::move(jobs.front());
+      jobs.pop_front();
+      running_job = true;
+      has_space_cv.notify_one();
+      guard.unlock();
+      job();
+      guard.lock();
+      running_job = false;
+      if (jobs.empty()) idle_cv.notify_all();
+    }
+  }
+#endif
+
+public:
+  AsyncWriter(size_t _capacity) : capacity(_capacity > 0 ? _capacity : 1) {
+#ifndef __EMSCRIPTEN__
+    thread = std::thread(&AsyncWriter::Run, this);
+#endif
+  }
+
+  AsyncWriter(const AsyncWriter&) = delete;
+  AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+  ~AsyncWriter() { Stop(); }
+
+  /**
+   * Input: A job to run on the writer thread.
+   *
+   * Output: None
+   *
+   * Purpose: Queues the job, first waiting for space if the queue is full.
+   */
+  void Push(std::function<void()> job) {
+#ifdef __EMSCRIPTEN__
+    emp_assert(!stopping);
+    job();
+#else
+    std::unique_lock<std::mutex> guard(lock);
+    emp_assert(!stopping);
+    if (jobs.size() >= capacity) {
+      ++blocked_pushes;
+      has_space_cv.wait(guard, [this]() { return jobs.size() < capacity; });
+    }
+    jobs.push_back(std::move(job));
+    has_jobs_cv.notify_one();
+#endif
+  }
+
+  // Is every queued job done? (For jobs to check whether more are coming.)
+  bool IsIdle() {
+    std::lock_guard<std::mutex> guard(lock);
+    return jobs.empty();
+  }
+
+  // Waits until every queued job is done
+  void Wait() {
+    std::unique_lock<std::mutex> guard(lock);
+    idle_cv.wait(guard, [this]() { return jobs.empty() && !running_job; });
+  }
+
+  // Runs every queued job, then stops the writer thread
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      if (stopping) return;
+      stopping = true;
+    }
+#ifndef __EMSCRIPTEN__
+    has_jobs_cv.notify_one();
+    thread.join();
+#endif
+  }
+
+  size_t GetCapacity() const { return capacity; }
+
+  // Number of times Push had to wait for space in the queue
+  size_t GetBlockedPushes() {
+    std::lock_guard<std::mutex> guard(lock);
+    return blocked_pushes;
+  }
+
+  // Asks the OS to write a file's data through to storage (best effort)
+  static void SyncFile([[maybe_unused]] const std::string& filename) {
+#ifndef __EMSCRIPTEN__
+    const int fd = ::open(filename.c_str(), O_WRONLY);
+    if (fd < 0) return;
+    ::fsync(fd);
+    ::close(fd);
+#endif
+  }
+};
+
+/*
+  An emp::DataFile whose rows are written by an AsyncWriter.
+
+  Update runs the columns on the simulation thread, capturing each value in
+  binary without formatting it (see columnar::RowCapture), and queues the row.
+  The writer thread then formats it (CSV) or encodes it (columnar) and writes
+  it, flushing whenever it runs out of queued work.
+
+  NOTE - The writer must outlive the file, or Finish must be called (and the
+         writer stopped) first.
+*/
+class AsyncDataFile : public emp::DataFile {
+protected:
+  emp::Ptr<AsyncWriter> writer;
+  bool columnar_format;
+  bool finished = false;
+  bool schema_sent = false;
+  // Used on the simulation thread
+  columnar::RowCapture capture;
+  // Used on the writer thread
+  columnar::BlockEncoder encoder;
+  std::string line_buffer;
+
+  void FlushIfIdle() {
+    if (writer->IsIdle()) os->flush();
+  }
+
+public:
+  // NOTE - emp::DataFile opens the file; it's opened in text mode, which is
+  //        only a problem on platforms that translate line endings.
+  AsyncDataFile(
+    const std::string& in_filename,
+    emp::Ptr<AsyncWriter> _writer,
+    bool _columnar_format
+  ) :
+    emp::DataFile(in_filename),
+    writer(_writer),
+    columnar_format(_columnar_format),
+    encoder(*os)
+  { }
+
+  AsyncDataFile(const AsyncDataFile&) = delete;
+  AsyncDataFile& operator=(const AsyncDataFile&) = delete;
+
+  ~AsyncDataFile() {
+    if (!finished) {
+      Finish();
+      writer->Wait();
+    }
+  }
+
+  bool IsColumnar() const { return columnar_format; }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Queues the header line (CSV only; a columnar file's schema is
+   * written with its first row).
+   */
+  void PrintHeaderKeys() override {
+    if (columnar_format || finished) return;
+    std::string header = line_begin;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (i > 0) header += line_spacer;
+      header += keys[i];
+    }
+    header += line_end;
+    writer->Push([this, header = std::move(header)]() {
+      os->write(header.data(), (std::streamsize)header.size());
+      FlushIfIdle();
+    });
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Captures a row with every column's current value and queues it
+   * for the writer thread.
+   */
+  void Update() override {
+    // Nothing more can be written once the file is finished
+    if (finished) return;
+    for (auto& fun : pre_funs) fun();
+    columnar::Row row;
+    capture.Capture(funs, row);
+    if (columnar_format) {
+      if (schema_sent) {
+        writer->Push([this, row = std::move(row)]() {
+          encoder.AddRow(row);
+        });
+      } else {
+        schema_sent = true;
+        writer->Push([this, row = std::move(row), keys = keys, descs = descs]() {
+          encoder.WriteSchema(keys, descs, &row);
+          encoder.AddRow(row);
+        });
+      }
+    } else {
+      writer->Push([this, row = std::move(row)]() {
+        line_buffer.clear();
+        columnar::AppendCSVRow(line_buffer, row, line_begin, line_spacer, line_end);
+        os->write(line_buffer.data(), (std::streamsize)line_buffer.size());
+        FlushIfIdle();
+      });
+    }
+  }
+  using emp::DataFile::Update;
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Queues the file's last writes: any buffered columnar rows, a
+   * flush, and a sync to storage. Later updates are ignored.
+   */
+  void Finish() {
+    if (finished) return;
+    finished = true;
+    const bool write_schema = columnar_format && !schema_sent;
+    writer->Push([this, write_schema, keys = keys, descs = descs]() {
+      if (write_schema) encoder.WriteSchema(keys, descs, nullptr);
+      if (columnar_format) encoder.Finish();
+      os->flush();
+      AsyncWriter::SyncFile(filename);
+    });
+  }
+};
+
+#endif
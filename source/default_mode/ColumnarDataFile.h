@@ -0,0 +1,654 @@
+#ifndef COLUMNAR_DATA_FILE_H
+#define COLUMNAR_DATA_FILE_H
+
+#include "../../Empirical/include/emp/base/assert.hpp"
+#include "../../Empirical/include/emp/base/vector.hpp"
+#include "../../Empirical/include/emp/data/DataFile.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+
+/*
+  Compressed columnar binary data files (DATA_FILE_FORMAT columnar).
+
+  A ColumnarDataFile is an emp::DataFile, so the columns added by the
+  Setup*File functions (AddVar, AddMean, AddHistBin, ...) work unchanged.
+  Instead of formatting each value as text, the stream that columns print to
+  captures numbers in binary, and rows are buffered and written a block of
+  columns at a time. Use ColumnarDataReader (or symbulation_columnar_to_csv)
+  to read them back.
+
+  File layout:
+    - MAGIC (8 bytes)
+    - Schema: varint column count, then per column its type (1 byte), key,
+      and description (strings are a varint length followed by the bytes)
+    - Blocks of up to BLOCK_ROWS rows: varint row count, then per column its
+      encoding (1 byte), varint byte count, and encoded values
+  Encodings (the "previous value" starts at 0 in each block, so blocks can be
+  decoded independently):
+    - DELTA (INT and UINT columns): zigzag varint of the difference from the
+      previous value
+    - XOR_LOW / XOR_HIGH (FLOAT columns): varint of the value's bits XORed with
+      the previous value's bits, as is (XOR_LOW, good for values that change in
+      their low mantissa bits, like means) or byte-reversed (XOR_HIGH, good for
+      integral values, like counts). Each block uses whichever is shorter.
+    - TEXT (TEXT columns): per row, a varint length and the bytes
+*/
+namespace columnar {
+  enum class ColumnType : uint8_t { FLOAT = 0, INT = 1, UINT = 2, TEXT = 3 };
+  enum class Encoding : uint8_t { DELTA = 0, XOR_LOW = 1, XOR_HIGH = 2, TEXT = 3 };
+
+  constexpr char MAGIC[8] = {'S', 'Y', 'M', 'C', 'O', 'L', 'S', '1'};
+
+  inline void PutVarint(std::string& out, uint64_t val) {
+    while (val >= 0x80) {
+      out.push_back((char)(val | 0x80));
+      val >>= 7;
+    }
+    out.push_back((char)val);
+  }
+
+  // Returns false if the varint runs past end (or is too long)
+  inline bool GetVarint(const char*& pos, const char* end, uint64_t& val) {
+    val = 0;
+    for (size_t shift = 0; shift < 64 && pos < end; shift += 7) {
+      const uint8_t byte = (uint8_t)*pos++;
+      val |= (uint64_t)(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) return true;
+    }
+    return false;
+  }
+
+  inline void PutString(std::string& out, const std::string& str) {
+    PutVarint(out, str.size());
+    out += str;
+  }
+
+  inline bool GetString(const char*& pos, const char* end, std::string& str) {
+    uint64_t size = 0;
+    if (!GetVarint(pos, end, size) || size > (uint64_t)(end - pos)) return false;
+    str.assign(pos, size);
+    pos += size;
+    return true;
+  }
+
+  inline uint64_t ZigZag(int64_t val) {
+    return ((uint64_t)val << 1) ^ (uint64_t)(val >> 63);
+  }
+
+  inline int64_t UnZigZag(uint64_t val) {
+    return (int64_t)(val >> 1) ^ -(int64_t)(val & 1);
+  }
+
+  inline uint64_t ReverseBytes(uint64_t val) {
+    uint64_t reversed = 0;
+    for (size_t i = 0; i < 8; ++i) {
+      reversed = (reversed << 8) | (val & 0xff);
+      val >>= 8;
+    }
+    return reversed;
+  }
+
+  inline uint64_t DoubleBits(double val) {
+    uint64_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    return bits;
+  }
+
+  inline double BitsDouble(uint64_t bits) {
+    double val;
+    std::memcpy(&val, &bits, sizeof(val));
+    return val;
+  }
+
+  // Formats a value the way an emp::DataFile would have printed it
+  inline std::string FormatValue(ColumnType type, uint64_t bits) {
+    switch (type) {
+      case ColumnType::INT: return std::to_string((int64_t)bits);
+      case ColumnType::UINT: return std::to_string(bits);
+      default: {
+        // Same as an ostream's default floating-point formatting
+        char formatted[32];
+        std::snprintf(formatted, sizeof(formatted), "%g", BitsDouble(bits));
+        return formatted;
+      }
+    }
+  }
+
+  // One column's value in a row: a number, or (type TEXT) whatever text the
+  // column printed
+  struct Cell {
+    ColumnType type = ColumnType::TEXT;
+    uint64_t bits = 0;
+    std::string text;
+  };
+  using Row = emp::vector<Cell>;
+
+  /*
+    Captures a row from an emp::DataFile's column functions without formatting
+    numbers: the stream passed to the columns has its number formatting
+    replaced by a facet that records each number printed in binary.
+  */
+  class RowCapture {
+  protected:
+    // A number printed by a column
+    struct Captured {
+      ColumnType type;
+      uint64_t bits;
+      size_t text_pos; // Where it was printed among any text the column printed
+    };
+
+    class CaptureFacet : public std::num_put<char> {
+      emp::vector<Captured>& captured;
+      std::ostream& stream;
+
+      iter_type Capture(iter_type out, ColumnType type, uint64_t bits) const {
+        captured.push_back({type, bits, (size_t)stream.tellp()});
+        return out;
+      }
+
+    public:
+      CaptureFacet(emp::vector<Captured>& _captured, std::ostream& _stream) :
+        captured(_captured), stream(_stream) { }
+
+    protected:
+      iter_type do_put(iter_type out, std::ios_base&, char, bool val) const override {
+        return Capture(out, ColumnType::UINT, val);
+      }
+      iter_type do_put(iter_type out, std::ios_base&, char, long val) const override {
+        return Capture(out, ColumnType::INT, (uint64_t)(int64_t)val);
+      }
+      iter_type do_put(iter_type out, std::ios_base&, char, long long val) const override {
+        return Capture(out, ColumnType::INT, (uint64_t)(int64_t)val);
+      }
+      iter_type do_put(iter_type out, std::ios_base&, char, unsigned long val) const override {
+        return Capture(out, ColumnType::UINT, (uint64_t)val);
+      }
+      iter_type do_put(iter_type out, std::ios_base&, char, unsigned long long val) const override {
+        return Capture(out, ColumnType::UINT, (uint64_t)val);
+      }
+      iter_type do_put(iter_type out, std::ios_base&, char, double val) const override {
+        return Capture(out, ColumnType::FLOAT, DoubleBits(val));
+      }
+      iter_type do_put(iter_type out, std::ios_base&, char, long double val) const override {
+        return Capture(out, ColumnType::FLOAT, DoubleBits((double)val));
+      }
+      iter_type do_put(iter_type out, std::ios_base&, char, const void* val) const override {
+        return Capture(out, ColumnType::UINT, (uint64_t)(uintptr_t)val);
+      }
+    };
+
+    emp::vector<Captured> captured;
+    // Stream passed to columns; collects any text they print
+    std::ostringstream capture_stream;
+
+    // Returns what the current column printed as text (with any captured
+    // numbers formatted back in), and resets the capture stream.
+    std::string TakeText() {
+      const std::string printed = capture_stream.str();
+      std::string text;
+      size_t printed_pos = 0;
+      for (const Captured& value : captured) {
+        text.append(printed, printed_pos, value.text_pos - printed_pos);
+        text += FormatValue(value.type, value.bits);
+        printed_pos = value.text_pos;
+      }
+      text.append(printed, printed_pos, std::string::npos);
+      capture_stream.str(std::string());
+      return text;
+    }
+
+  public:
+    RowCapture() {
+      capture_stream.imbue(std::locale(capture_stream.getloc(), new CaptureFacet(captured, capture_stream)));
+    }
+    RowCapture(const RowCapture&) = delete;
+    RowCapture& operator=(const RowCapture&) = delete;
+
+    /**
+     * Input: A data file's column functions, and the row to fill.
+     *
+     * Output: None
+     *
+     * Purpose: Runs every column function, recording what it printed. A column
+     * that printed exactly one number (and no text) gets a numeric cell;
+     * anything else becomes a text cell.
+     */
+    template <typename FUNS_T>
+    void Capture(FUNS_T& funs, Row& row) {
+      row.resize(funs.size());
+      for (size_t column = 0; column < funs.size(); ++column) {
+        captured.clear();
+        funs[column](capture_stream);
+        Cell& cell = row[column];
+        if (capture_stream.tellp() <= 0 && captured.size() == 1) {
+          cell.type = captured[0].type;
+          cell.bits = captured[0].bits;
+          cell.text.clear();
+        } else {
+          cell.type = ColumnType::TEXT;
+          cell.bits = 0;
+          cell.text = TakeText();
+        }
+      }
+    }
+  };
+
+  // Formats a captured row as a line of an emp::DataFile
+  inline void AppendCSVRow(
+    std::string& out,
+    const Row& row,
+    const std::string& line_begin,
+    const std::string& line_spacer,
+    const std::string& line_end
+  ) {
+    out += line_begin;
+    for (size_t column = 0; column < row.size(); ++column) {
+      if (column > 0) out += line_spacer;
+      const Cell& cell = row[column];
+      if (cell.type == ColumnType::TEXT) out += cell.text;
+      else out += FormatValue(cell.type, cell.bits);
+    }
+    out += line_end;
+  }
+
+  /*
+    Writes captured rows to a stream in the columnar format: the schema,
+    then blocks of BLOCK_ROWS rows.
+  */
+  class BlockEncoder {
+  public:
+    // Rows buffered before a block is written (and flushed) to the stream
+    static constexpr size_t BLOCK_ROWS = 256;
+
+  protected:
+    std::ostream& out;
+    // Column types are set from the first row
+    emp::vector<ColumnType> column_types;
+    // Buffered rows of the current block, per column
+    emp::vector<emp::vector<uint64_t>> column_values;
+    emp::vector<emp::vector<std::string>> column_text;
+    size_t block_rows = 0;
+    bool schema_written = false;
+
+    std::string out_buffer;
+    std::string chunk;
+    std::string alt_chunk;
+
+    // Converts a number to the type of its column
+    static uint64_t Convert(const Cell& cell, ColumnType column_type) {
+      if (cell.type == column_type) return cell.bits;
+      if (column_type == ColumnType::FLOAT) {
+        const double val = (cell.type == ColumnType::INT) ? (double)(int64_t)cell.bits : (double)cell.bits;
+        return DoubleBits(val);
+      }
+      if (cell.type == ColumnType::FLOAT) {
+        return (uint64_t)(int64_t)BitsDouble(cell.bits);
+      }
+      return cell.bits; // INT <-> UINT
+    }
+
+    // Parses text printed by a numeric column (e.g., a column that printed
+    // nothing, or more than one value)
+    static uint64_t Parse(const std::string& text, ColumnType column_type) {
+      switch (column_type) {
+        case ColumnType::INT: return (uint64_t)std::strtoll(text.c_str(), nullptr, 10);
+        case ColumnType::UINT: return std::strtoull(text.c_str(), nullptr, 10);
+        default:
+          if (text.empty()) return DoubleBits(std::numeric_limits<double>::quiet_NaN());
+          return DoubleBits(std::strtod(text.c_str(), nullptr));
+      }
+    }
+
+    void EncodeColumn(size_t column) {
+      chunk.clear();
+      const ColumnType type = column_types[column];
+      if (type == ColumnType::TEXT) {
+        out_buffer.push_back((char)Encoding::TEXT);
+        for (const std::string& text : column_text[column]) {
+          PutString(chunk, text);
+        }
+        column_text[column].clear();
+      } else if (type == ColumnType::FLOAT) {
+        alt_chunk.clear();
+        uint64_t prev = 0;
+        for (uint64_t bits : column_values[column]) {
+          PutVarint(chunk, bits ^ prev);
+          PutVarint(alt_chunk, ReverseBytes(bits ^ prev));
+          prev = bits;
+        }
+        if (alt_chunk.size() < chunk.size()) {
+          out_buffer.push_back((char)Encoding::XOR_HIGH);
+          chunk.swap(alt_chunk);
+        } else {
+          out_buffer.push_back((char)Encoding::XOR_LOW);
+        }
+        column_values[column].clear();
+      } else {
+        out_buffer.push_back((char)Encoding::DELTA);
+        uint64_t prev = 0;
+        for (uint64_t bits : column_values[column]) {
+          PutVarint(chunk, ZigZag((int64_t)(bits - prev)));
+          prev = bits;
+        }
+        column_values[column].clear();
+      }
+      PutVarint(out_buffer, chunk.size());
+      out_buffer += chunk;
+    }
+
+    void WriteBlock() {
+      if (block_rows == 0) return;
+      out_buffer.clear();
+      PutVarint(out_buffer, block_rows);
+      for (size_t column = 0; column < column_types.size(); ++column) {
+        EncodeColumn(column);
+      }
+      out.write(out_buffer.data(), (std::streamsize)out_buffer.size());
+      out.flush();
+      block_rows = 0;
+    }
+
+  public:
+    BlockEncoder(std::ostream& _out) : out(_out) { }
+
+    bool HasSchema() const { return schema_written; }
+
+    /**
+     * Input: Each column's key and description, and the first row (or null if
+     * there are no rows).
+     *
+     * Output: None
+     *
+     * Purpose: Writes the schema. Each column's type is set from what it
+     * printed in the first row.
+     */
+    void WriteSchema(
+      const emp::vector<std::string>& keys,
+      const emp::vector<std::string>& descs,
+      const Row* first_row
+    ) {
+      emp_assert(!schema_written);
+      emp_assert(first_row == nullptr || first_row->size() == keys.size());
+      out_buffer.assign(MAGIC, sizeof(MAGIC));
+      PutVarint(out_buffer, keys.size());
+      for (size_t column = 0; column < keys.size(); ++column) {
+        const ColumnType type = first_row ? (*first_row)[column].type : ColumnType::FLOAT;
+        column_types.push_back(type);
+        column_values.emplace_back();
+        column_text.emplace_back();
+        out_buffer.push_back((char)type);
+        PutString(out_buffer, keys[column]);
+        PutString(out_buffer, (column < descs.size()) ? descs[column] : "");
+      }
+      out.write(out_buffer.data(), (std::streamsize)out_buffer.size());
+      schema_written = true;
+    }
+
+    void AddRow(const Row& row) {
+      emp_assert(schema_written);
+      emp_assert(row.size() == column_types.size(),
+        "Columns can't be added to a columnar data file after its first row");
+      for (size_t column = 0; column < column_types.size(); ++column) {
+        const ColumnType type = column_types[column];
+        const Cell& cell = row[column];
+        if (type == ColumnType::TEXT) {
+          column_text[column].push_back(
+            (cell.type == ColumnType::TEXT) ? cell.text : FormatValue(cell.type, cell.bits)
+          );
+        } else if (cell.type == ColumnType::TEXT) {
+          column_values[column].push_back(Parse(cell.text, type));
+        } else {
+          column_values[column].push_back(Convert(cell, type));
+        }
+      }
+      if (++block_rows == BLOCK_ROWS) WriteBlock();
+    }
+
+    // Writes any buffered rows
+    void Finish() {
+      WriteBlock();
+      out.flush();
+    }
+  };
+}
+
+class ColumnarDataFile : public emp::DataFile {
+public:
+  using ColumnType = columnar::ColumnType;
+  using Encoding = columnar::Encoding;
+
+  static constexpr size_t BLOCK_ROWS = columnar::BlockEncoder::BLOCK_ROWS;
+
+protected:
+  columnar::RowCapture capture;
+  columnar::Row row;
+  columnar::BlockEncoder encoder;
+
+public:
+  // NOTE - emp::DataFile opens the file; it's opened in text mode, which is
+  //        only a problem on platforms that translate line endings.
+  ColumnarDataFile(const std::string& in_filename) :
+    emp::DataFile(in_filename, "", "", ""),
+    encoder(*os)
+  { }
+
+  ColumnarDataFile(const ColumnarDataFile&) = delete;
+  ColumnarDataFile& operator=(const ColumnarDataFile&) = delete;
+
+  ~ColumnarDataFile() {
+    if (!encoder.HasSchema()) encoder.WriteSchema(keys, descs, nullptr);
+    encoder.Finish();
+  }
+
+  /**
+   * Input: The name of a data file (e.g., ending in .data or .csv).
+   *
+   * Output: The name to use for its columnar version.
+   *
+   * Purpose: Swaps a data file's extension for .cols.
+   */
+  static std::string GetFilename(const std::string& filename) {
+    return std::filesystem::path(filename).replace_extension(".cols").string();
+  }
+
+  // The schema (keys and descriptions) is written with the first row instead
+  void PrintHeaderKeys() override { }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Records a row with every column's current value. The schema is
+   * written with the first row (which sets each column's type), and rows are
+   * written to the file a block at a time.
+   */
+  void Update() override {
+    for (auto& fun : pre_funs) fun();
+    capture.Capture(funs, row);
+    if (!encoder.HasSchema()) encoder.WriteSchema(keys, descs, &row);
+    encoder.AddRow(row);
+  }
+  using emp::DataFile::Update;
+};
+
+/*
+  Reads a file written by a ColumnarDataFile.
+*/
+class ColumnarDataReader {
+public:
+  using ColumnType = columnar::ColumnType;
+  using Encoding = columnar::Encoding;
+
+  struct Column {
+    std::string key;
+    std::string desc;
+    ColumnType type = ColumnType::FLOAT;
+    emp::vector<uint64_t> values;  // Value bits, for FLOAT, INT, and UINT columns
+    emp::vector<std::string> text; // For TEXT columns
+  };
+
+protected:
+  emp::vector<Column> columns;
+  size_t num_rows = 0;
+
+  bool DecodeColumn(Column& column, Encoding encoding, size_t rows, const char* pos, const char* end) {
+    const bool encoding_matches =
+      (column.type == ColumnType::TEXT) ? (encoding == Encoding::TEXT) :
+      (column.type == ColumnType::FLOAT) ? (encoding == Encoding::XOR_LOW || encoding == Encoding::XOR_HIGH) :
+      (encoding == Encoding::DELTA);
+    if (!encoding_matches) return false;
+    uint64_t prev = 0;
+    for (size_t row = 0; row < rows; ++row) {
+      if (encoding == Encoding::TEXT) {
+        std::string text;
+        if (!columnar::GetString(pos, end, text)) return false;
+        column.text.push_back(std::move(text));
+        continue;
+      }
+      uint64_t encoded = 0;
+      if (!columnar::GetVarint(pos, end, encoded)) return false;
+      uint64_t bits = 0;
+      switch (encoding) {
+        case Encoding::XOR_LOW: bits = prev ^ encoded; break;
+        case Encoding::XOR_HIGH: bits = prev ^ columnar::ReverseBytes(encoded); break;
+        default: bits = prev + (uint64_t)columnar::UnZigZag(encoded); break;
+      }
+      column.values.push_back(bits);
+      prev = bits;
+    }
+    return pos == end;
+  }
+
+public:
+  /**
+   * Input: The file to read, and a string to hold an error message if it
+   * can't be read.
+   *
+   * Output: Whether the file was read.
+   *
+   * Purpose: Reads a whole columnar data file.
+   */
+  bool Load(const std::string& filename, std::string& error) {
+    columns.clear();
+    num_rows = 0;
+    std::ifstream in_file(filename, std::ios::binary);
+    if (!in_file) {
+      error = "Unable to open data file: " + filename;
+      return false;
+    }
+    const std::string contents(
+      (std::istreambuf_iterator<char>(in_file)),
+      std::istreambuf_iterator<char>()
+    );
+    const std::string corrupt_error = "Not a columnar data file, or truncated: " + filename;
+    const char* pos = contents.data();
+    const char* end = pos + contents.size();
+
+    if (contents.size() < sizeof(columnar::MAGIC) ||
+        std::memcmp(pos, columnar::MAGIC, sizeof(columnar::MAGIC)) != 0) {
+      error = corrupt_error;
+      return false;
+    }
+    pos += sizeof(columnar::MAGIC);
+    uint64_t num_columns = 0;
+    if (!columnar::GetVarint(pos, end, num_columns) || num_columns > (uint64_t)(end - pos)) {
+      error = corrupt_error;
+      return false;
+    }
+    columns.resize(num_columns);
+    for (Column& column : columns) {
+      if (pos == end || (uint8_t)*pos > (uint8_t)ColumnType::TEXT) {
+        error = corrupt_error;
+        return false;
+      }
+      column.type = (ColumnType)*pos++;
+      if (!columnar::GetString(pos, end, column.key) || !columnar::GetString(pos, end, column.desc)) {
+        error = corrupt_error;
+        return false;
+      }
+    }
+
+    while (pos < end) {
+      uint64_t rows = 0;
+      if (!columnar::GetVarint(pos, end, rows)) {
+        error = corrupt_error;
+        return false;
+      }
+      for (Column& column : columns) {
+        uint64_t size = 0;
+        if (pos == end) {
+          error = corrupt_error;
+          return false;
+        }
+        const Encoding encoding = (Encoding)*pos++;
+        if (!columnar::GetVarint(pos, end, size) || size > (uint64_t)(end - pos) ||
+            rows > size || !DecodeColumn(column, encoding, rows, pos, pos + size)) {
+          error = corrupt_error;
+          return false;
+        }
+        pos += size;
+      }
+      num_rows += rows;
+    }
+    return true;
+  }
+
+  size_t GetNumColumns() const { return columns.size(); }
+  size_t GetNumRows() const { return num_rows; }
+  const Column& GetColumn(size_t column) const { return columns[column]; }
+
+  // Returns the index of the column with the given key (or GetNumColumns())
+  size_t FindColumn(const std::string& key) const {
+    for (size_t column = 0; column < columns.size(); ++column) {
+      if (columns[column].key == key) return column;
+    }
+    return columns.size();
+  }
+
+  double GetDouble(size_t column, size_t row) const {
+    const Column& col = columns[column];
+    emp_assert(col.type != ColumnType::TEXT);
+    switch (col.type) {
+      case ColumnType::INT: return (double)(int64_t)col.values[row];
+      case ColumnType::UINT: return (double)col.values[row];
+      default: return columnar::BitsDouble(col.values[row]);
+    }
+  }
+
+  // Returns a value as an emp::DataFile would have printed it
+  std::string GetText(size_t column, size_t row) const {
+    const Column& col = columns[column];
+    if (col.type == ColumnType::TEXT) return col.text[row];
+    return columnar::FormatValue(col.type, col.values[row]);
+  }
+
+  // Writes the file as CSV, the way an emp::DataFile would have
+  void WriteCSV(std::ostream& out) const {
+    for (size_t column = 0; column < columns.size(); ++column) {
+      if (column > 0) out << ",";
+      out << columns[column].key;
+    }
+    out << "\n";
+    for (size_t row = 0; row < num_rows; ++row) {
+      for (size_t column = 0; column < columns.size(); ++column) {
+        if (column > 0) out << ",";
+        out << GetText(column, row);
+      }
+      out << "\n";
+    }
+  }
+};
+
+#endif
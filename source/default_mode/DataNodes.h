@@ -3,6 +3,7 @@
 
 #include "../../Empirical/include/emp/io/File.hpp"
 
+#include "ColumnarDataFile.h"
 #include "SymWorld.h"
 
 /**
@@ -14,6 +15,8 @@
 */
 void SymWorld::CreateDataFiles(){
   int TIMING_REPEAT = my_config->DATA_INT();
+  // Data nodes only need to scan the population on updates the files write
+  SetDataNodeInterval(TIMING_REPEAT);
   std::string file_ending = "_SEED"+std::to_string(my_config->SEED())+".data";
 
   SetupHostIntValFile(my_config->FILE_PATH()+"HostVals"+my_config->FILE_NAME()+file_ending).SetTimingRepeat(TIMING_REPEAT);
@@ -27,6 +30,86 @@ void SymWorld::CreateDataFiles(){
   if (my_config->TAG_MATCHING()) {
     SetupTagDistFile(my_config->FILE_PATH() + "TagDist" + my_config->FILE_NAME() + file_ending).SetTimingRepeat(TIMING_REPEAT);
   }
+  if (my_config->PHYLOGENY()) {
+    SetupPhylogenyMemoryFile(my_config->FILE_PATH() + "PhylogenyMemory" + my_config->FILE_NAME() + file_ending).SetTimingRepeat(TIMING_REPEAT);
+  }
+}
+
+/**
+ * Input: The name of the data file to create.
+ *
+ * Output: The address of the DataFile that has been created (owned by the
+ * world, which updates it).
+ *
+ * Purpose: To create a data file in the configured DATA_FILE_FORMAT, written
+ * by the background writer if ASYNC_OUTPUT is on. This replaces
+ * emp::World::SetupFile, so every Setup*File function writes the configured
+ * way without changes to its columns. Columnar files swap the file's
+ * extension for .cols (see ColumnarDataFile).
+ */
+emp::DataFile & SymWorld::SetupFile(const std::string & filename){
+  const std::string & format = my_config->DATA_FILE_FORMAT();
+  if (format != "csv" && format != "columnar") {
+    std::cout << "Unrecognized DATA_FILE_FORMAT: " << format << " (expected csv or columnar)" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  const bool columnar_format = (format == "columnar");
+  const std::string file_name = columnar_format ? ColumnarDataFile::GetFilename(filename) : filename;
+
+  if (my_config->ASYNC_OUTPUT()) {
+    if (!output_writer) output_writer = emp::NewPtr<AsyncWriter>(my_config->OUTPUT_QUEUE_SIZE());
+    emp::Ptr<AsyncDataFile> file = emp::NewPtr<AsyncDataFile>(file_name, output_writer, columnar_format);
+    async_files.push_back(file);
+    return AddDataFile(file);
+  }
+  if (columnar_format) {
+    return AddDataFile(emp::NewPtr<ColumnarDataFile>(file_name));
+  }
+  return emp::World<Organism>::SetupFile(file_name);
+}
+
+/**
+ * Input: The name of the file to write, and its contents.
+ *
+ * Output: None.
+ *
+ * Purpose: To write a whole output file, on the background writer if
+ * ASYNC_OUTPUT is on (the contents are copied, so the caller can move on).
+ */
+void SymWorld::WriteOutputFile(const std::string & filename, const std::string & contents){
+  if (!my_config->ASYNC_OUTPUT()) {
+    std::ofstream out_file(filename);
+    out_file << contents;
+    return;
+  }
+  if (!output_writer) output_writer = emp::NewPtr<AsyncWriter>(my_config->OUTPUT_QUEUE_SIZE());
+  output_writer->Push([filename, contents]() {
+    std::ofstream out_file(filename);
+    out_file << contents;
+    out_file.close();
+    AsyncWriter::SyncFile(filename);
+  });
+}
+
+/**
+ * Input: None.
+ *
+ * Output: None.
+ *
+ * Purpose: To write out everything the background writer still has queued
+ * (including the last block of every columnar file), sync the data files
+ * to storage, and stop the writer. Called when the world is destroyed; data
+ * files are not updated after this.
+ */
+void SymWorld::FinishOutput(){
+  if (!output_writer) return;
+  for (emp::Ptr<AsyncDataFile> file : async_files) {
+    file->Finish();
+  }
+  async_files.clear();
+  output_writer->Stop();
+  output_writer.Delete();
+  output_writer = nullptr;
 }
 
 /**
@@ -238,89 +321,55 @@ emp::DataFile& SymWorld::SetupReproHistFile(const std::string& filename) {
  * the host systematic information
  */
 void SymWorld::WritePhylogenyFile(const std::string & filename) {
-  sym_sys->Snapshot("SymSnapshot_"+filename);
-  host_sys->Snapshot("HostSnapshot_"+filename);
+  if (my_config->PHYLOGENY_LOG()) {
+    // Only the taxa that changed since the last snapshot are written
+    sym_phylo_log->WriteSnapshot(GetUpdate());
+    host_phylo_log->WriteSnapshot(GetUpdate());
+  }
+  else {
+    sym_sys->Snapshot("SymSnapshot_"+filename);
+    host_sys->Snapshot("HostSnapshot_"+filename);
+  }
 
   if (my_config->TRACK_PHYLOGENY_INTERACTIONS()) {
-    emp::File interaction_file;
+    std::ostringstream interaction_file;
     // interaction_file << "host, symbiont, host_interaction, sym_interaction, count";
-    interaction_file << "host, symbiont, count";
-
-    for (emp::Ptr<taxon_t::host_taxon_t> t : host_sys->GetActive()) {
-      for (auto interaction : t->GetData().associated_syms) {
-        // It feels like there should be a better way to do this, but all the
-        // obvious solutions involved converting all these values to the same
-        // numerical type, which doesn't end well (since they're a mix of large
-        // integers and small floating points)
-        interaction_file << emp::to_string(t->GetID()) + "," +
-          emp::to_string(interaction.first) + "," +
-          // emp::to_string(t->GetInfo()) + "," + 
-          // emp::to_string(interaction.first->GetInfo()) + "," + 
-          emp::to_string(interaction.second);
-      }
-    }
+    interaction_file << "host, symbiont, count\n";
 
-    for (emp::Ptr<taxon_t::host_taxon_t> t : host_sys->GetAncestors()) {
-      for (auto interaction : t->GetData().associated_syms) {
-        // It feels like there should be a better way to do this, but all the
-        // obvious solutions involved converting all these values to the same
-        // numerical type, which doesn't end well (since they're a mix of large
-        // integers and small floating points)
-        interaction_file << emp::to_string(t->GetID()) + "," +
-          emp::to_string(interaction.first) + "," +
-          // emp::to_string(t->GetInfo()) + "," + 
-          // emp::to_string(interaction.first->GetInfo()) + "," + 
-          emp::to_string(interaction.second);
-      }
-    }
-
-    for (emp::Ptr<taxon_t::host_taxon_t> t : host_sys->GetOutside()) {
-      for (auto interaction : t->GetData().associated_syms) {
-        // It feels like there should be a better way to do this, but all the
-        // obvious solutions involved converting all these values to the same
-        // numerical type, which doesn't end well (since they're a mix of large
-        // integers and small floating points)
-        interaction_file << emp::to_string(t->GetID()) + "," +
-          emp::to_string(interaction.first) + "," +
-          // emp::to_string(t->GetInfo()) + "," + 
-          // emp::to_string(interaction.first->GetInfo()) + "," + 
-          emp::to_string(interaction.second);
+    auto write_interactions = [&interaction_file](const auto & taxa) {
+      for (emp::Ptr<taxon_t::host_taxon_t> t : taxa) {
+        t->GetData().ForEachInteraction([&interaction_file, t](unsigned long long int sym_id, int count) {
+          interaction_file << t->GetID() << ',' << sym_id << ',' << count << '\n';
+        });
       }
-    }
+    };
+    write_interactions(host_sys->GetActive());
+    write_interactions(host_sys->GetAncestors());
+    write_interactions(host_sys->GetOutside());
 
-    interaction_file.Write("InteractionSnapshot_" + filename);
+    WriteOutputFile("InteractionSnapshot_" + filename, interaction_file.str());
   }
   if (my_config->WRITE_CURRENT_INTERACTION_COUNTS()) {
-    emp::File cur_interaction_file;
-    cur_interaction_file << "host,symbiont,count";
+    std::ostringstream cur_interaction_file;
+    cur_interaction_file << "host,symbiont,count\n";
     std::unordered_map<unsigned long long int, std::unordered_map<unsigned long long int, int>> current_interactions;
 
     for (size_t i = 0; i < GetSize(); i++) {
       if (IsOccupied(i)) {
         unsigned long long int host_taxon = pop[i]->GetTaxon()->GetID();
         for (auto sym : pop[i]->GetSymbionts()) {
-          unsigned long long int sym_taxon = sym->GetTaxon()->GetID();
-          if (!current_interactions.contains(host_taxon)) {
-            std::unordered_map<unsigned long long int, int> syms_map = { std::pair(sym_taxon, 1) };
-            current_interactions.emplace(host_taxon, syms_map);
-          }
-          else if (!current_interactions.at(host_taxon).contains(sym_taxon)) {
-            current_interactions.at(host_taxon).emplace(sym_taxon, 1);
-          }
-          else {
-            current_interactions.at(host_taxon).at(sym_taxon)++;
-          }
+          current_interactions[host_taxon][sym->GetTaxon()->GetID()]++;
         }
       }
     }
 
-    for (auto host_pair : current_interactions) {
-      for (auto sym_pair : host_pair.second) {
-        cur_interaction_file << emp::to_string(host_pair.first) + "," + emp::to_string(sym_pair.first) + "," + emp::to_string(sym_pair.second);
+    for (auto & host_pair : current_interactions) {
+      for (auto & sym_pair : host_pair.second) {
+        cur_interaction_file << host_pair.first << ',' << sym_pair.first << ',' << sym_pair.second << '\n';
       }
     }
 
-    cur_interaction_file.Write("CurrentInteractionsSnapshot_" + filename);
+    WriteOutputFile("CurrentInteractionsSnapshot_" + filename, cur_interaction_file.str());
   }
 
 }
@@ -507,7 +556,7 @@ emp::DataFile& SymWorld::SetupTagDistFile(const std::string& filename) {
  * concluded
  */
 void SymWorld::WriteOrgDumpFile(const std::string& filename) {
-  std::ofstream out_file(filename);
+  std::ostringstream out_file;
   out_file << "host_int,sym_int,host_repro_count,host_towards_partner_count,host_from_partner_count," << 
     "sym_repro_count,sym_towards_partner_count,sym_from_partner_count";
   if (my_config->TAG_MATCHING()) {
@@ -543,46 +592,75 @@ void SymWorld::WriteOrgDumpFile(const std::string& filename) {
       out_file << "\n";
     }
   }
-  out_file.close();
+  WriteOutputFile(filename, out_file.str());
 }
 
+/**
+ * Input: The address of the string representing the file to be created.
+ *
+ * Output: None.
+ *
+ * Purpose: To write the tag distance from every sampled host to every
+ * symbiont of a sampled host, in the configured TAG_MATRIX_FORMAT (binary
+ * files swap the file's extension for .tagm). With the Hamming metric, the
+ * matrix is computed with TagDistanceMatrix, split across STATS_THREADS
+ * threads.
+ */
 void SymWorld::WriteTagMatrixFile(const std::string& filename) {
-  std::ofstream out_file(filename);
+  const std::string & format = my_config->TAG_MATRIX_FORMAT();
+  if (format != "csv" && format != "binary") {
+    std::cout << "Unrecognized TAG_MATRIX_FORMAT: " << format << " (expected csv or binary)" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  const bool binary_format = (format == "binary");
 
   emp::vector<size_t> sampled_positions = emp::Choose(GetRandom(), GetSize(), my_config->TAG_MATRIX_SAMPLE_PROPORTION() * GetSize());
 
-  // write the host position of every sym
-  out_file << ',';
+  // Rows are labeled with each host's position, and columns with the host
+  // position of each sym (with multi-infection, column labels aren't unique)
+  emp::vector<size_t> host_positions;
+  emp::vector<size_t> sym_host_positions;
+  emp::vector<emp::Ptr<Organism>> symbionts;
   for (size_t i : sampled_positions) {
     if (IsOccupied(i)) {
-      if (pop[i]->HasSym()) {
-        emp::vector<emp::Ptr<Organism>> symbionts = pop[i]->GetSymbionts();
-        for (size_t j = 0; j < symbionts.size(); j++) {
-          out_file << i << ","; // for mulit-infection, have non-unique ids (or change this!)
-        }
+      host_positions.push_back(i);
+      for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) {
+        sym_host_positions.push_back(i);
+        symbionts.push_back(sym);
       }
     }
   }
-  out_file << "\n";
 
-  // for every host, calculate the tag distance to every sym
-  for (size_t k : sampled_positions) {
-    if (IsOccupied(k)) {
-      out_file << k << ',';
-
-      // calculate tag distance to every sym
-      for (size_t i : sampled_positions) {
-        if (IsOccupied(i) && pop[i]->HasSym()) {
-          emp::vector<emp::Ptr<Organism>> symbionts = pop[i]->GetSymbionts();
-          for (size_t j = 0; j < symbionts.size(); j++) {
-            out_file << (*tag_metric)(pop[k]->GetTag(), symbionts[j]->GetTag()) << ",";
-          }
-        }
+  std::string out_file;
+  if (hamming_tag_metric) {
+    TagDistanceMatrix<TAG_LENGTH> matrix;
+    for (size_t k : host_positions) matrix.AddRow(pop[k]->GetTag());
+    for (emp::Ptr<Organism> sym : symbionts) matrix.AddColumn(sym->GetTag());
+    matrix.Compute(my_config->STATS_THREADS());
+    if (binary_format) matrix.AppendBinary(out_file, host_positions, sym_host_positions);
+    else matrix.AppendCSV(out_file, host_positions, sym_host_positions);
+  }
+  else {
+    emp::vector<double> distances;
+    distances.reserve(host_positions.size() * symbionts.size());
+    for (size_t k : host_positions) {
+      for (emp::Ptr<Organism> sym : symbionts) {
+        distances.push_back((*tag_metric)(pop[k]->GetTag(), sym->GetTag()));
       }
-      out_file << "\n";
+    }
+    auto distance = [&distances, &symbionts](size_t row, size_t column) {
+      return distances[row * symbionts.size() + column];
+    };
+    if (binary_format) {
+      tagmatrix::AppendBinary(out_file, tagmatrix::ValueKind::DISTANCES, TAG_LENGTH, host_positions, sym_host_positions,
+        [&distance](size_t row, size_t column) { return columnar::DoubleBits(distance(row, column)); });
+    }
+    else {
+      tagmatrix::AppendCSV(out_file, host_positions, sym_host_positions,
+        [&distance](std::string& csv, size_t row, size_t column) { tagmatrix::AppendDistance(csv, distance(row, column)); });
     }
   }
-  out_file.close();
+  WriteOutputFile(binary_format ? tagmatrix::GetBinaryFilename(filename) : filename, out_file);
 }
 
   emp::DataFile & SymWorld::SetupSymDiversityFile(const std::string & filename) {
@@ -641,6 +719,42 @@ void SymWorld::WriteTagMatrixFile(const std::string& filename) {
     return file;
   }
 
+/**
+ * Input: The address of the string representing the file to be created's name
+ *
+ * Output: The address of the DataFile that has been created.
+ *
+ * Purpose: To set up the file that will be used to track how many taxa the host
+ * and symbiont phylogenies hold, and roughly how much memory they use (to
+ * choose PHYLOGENY_MAX_ANCESTOR_AGE or PHYLOGENY_MAX_ANCESTOR_DEPTH for long runs)
+ */
+emp::DataFile & SymWorld::SetupPhylogenyMemoryFile(const std::string & filename) {
+  auto & file = SetupFile(filename);
+  // Visits every taxon, so only done on updates the file is written
+  file.AddPreFun([this]() {
+    host_phylo_memory = host_phylo_pruner->GetMemoryUse();
+    sym_phylo_memory = sym_phylo_pruner->GetMemoryUse();
+    phylo_memory_bytes = host_phylo_memory.bytes + sym_phylo_memory.bytes;
+  });
+  file.AddVar(update, "update", "Update");
+  file.AddVar(host_phylo_memory.active, "host_active_taxa", "Number of host taxa with living organisms");
+  file.AddVar(host_phylo_memory.ancestors, "host_ancestor_taxa", "Number of extinct host taxa with living descendants");
+  file.AddVar(host_phylo_memory.outside, "host_outside_taxa", "Number of stored extinct host taxa without living descendants");
+  file.AddVar(host_phylo_memory.coalesced, "host_coalesced_taxa", "Number of extinct host taxa counted instead of stored");
+  file.AddVar(host_phylo_memory.removed, "host_removed_taxa", "Number of host ancestor taxa removed by the age and depth limits");
+  file.AddVar(host_phylo_memory.bytes, "host_bytes", "Estimated bytes used by host taxa");
+  file.AddVar(sym_phylo_memory.active, "sym_active_taxa", "Number of symbiont taxa with living organisms");
+  file.AddVar(sym_phylo_memory.ancestors, "sym_ancestor_taxa", "Number of extinct symbiont taxa with living descendants");
+  file.AddVar(sym_phylo_memory.outside, "sym_outside_taxa", "Number of stored extinct symbiont taxa without living descendants");
+  file.AddVar(sym_phylo_memory.coalesced, "sym_coalesced_taxa", "Number of extinct symbiont taxa counted instead of stored");
+  file.AddVar(sym_phylo_memory.removed, "sym_removed_taxa", "Number of symbiont ancestor taxa removed by the age and depth limits");
+  file.AddVar(sym_phylo_memory.bytes, "sym_bytes", "Estimated bytes used by symbiont taxa");
+  file.AddVar(phylo_memory_bytes, "total_bytes", "Estimated bytes used by both phylogenies");
+  file.PrintHeaderKeys();
+
+  return file;
+}
+
 /**
  * Input: None
  *
@@ -653,13 +767,9 @@ void SymWorld::WriteTagMatrixFile(const std::string& filename) {
 emp::DataMonitor<int>& SymWorld::GetHostCountDataNode() {
   if(!data_node_hostcount) {
     data_node_hostcount.New();
-    OnUpdate([this](size_t){
-      data_node_hostcount -> Reset();
-      for (size_t i = 0; i< pop.size(); i++){
-        if (IsOccupied(i)){
-          data_node_hostcount->AddDatum(1);
-        }
-      }
+    size_t channel = stats_engine.AddChannel(*data_node_hostcount);
+    stats_engine.AddHostVisitor(channel, [channel](Organism&, StatsEngine::Emitter& out){
+      out.Emit(channel, 1);
     });
   }
   return *data_node_hostcount;
@@ -678,16 +788,11 @@ emp::DataMonitor<int>& SymWorld::GetHostCountDataNode() {
 emp::DataMonitor<int>& SymWorld::GetSymCountDataNode() {
   if(!data_node_symcount) {
     data_node_symcount.New();
-    OnUpdate([this](size_t){
-      data_node_symcount -> Reset();
-      for (size_t i = 0; i < pop.size(); i++){
-        if(IsOccupied(i)){
-          data_node_symcount->AddDatum((pop[i]->GetSymbionts()).size());
-        }
-        if(sym_pop[i]){
-          data_node_symcount->AddDatum(1);
-        }
-      }
+    size_t channel = stats_engine.AddChannel(*data_node_symcount);
+    stats_engine.AddVisitor(channel, [channel](Organism& host, StatsEngine::Emitter& out){
+      out.Emit(channel, host.GetSymbionts().size());
+    }, StatsEngine::Skip{}, [channel](Organism&, StatsEngine::Emitter& out){
+      out.Emit(channel, 1);
     });
   }
   return *data_node_symcount;
@@ -706,13 +811,9 @@ emp::DataMonitor<int>& SymWorld::GetSymCountDataNode() {
 emp::DataMonitor<int>& SymWorld::GetCountHostedSymsDataNode(){
   if (!data_node_hostedsymcount) {
     data_node_hostedsymcount.New();
-    OnUpdate([this](size_t){
-      data_node_hostedsymcount->Reset();
-      for (size_t i = 0; i< pop.size(); i++){
-        if (IsOccupied(i)){
-          data_node_hostedsymcount->AddDatum(pop[i]->GetSymbionts().size());
-        }
-      }
+    size_t channel = stats_engine.AddChannel(*data_node_hostedsymcount);
+    stats_engine.AddHostVisitor(channel, [channel](Organism& host, StatsEngine::Emitter& out){
+      out.Emit(channel, host.GetSymbionts().size());
     });
   }
   return *data_node_hostedsymcount;
@@ -731,13 +832,9 @@ emp::DataMonitor<int>& SymWorld::GetCountHostedSymsDataNode(){
 emp::DataMonitor<int>& SymWorld::GetCountFreeSymsDataNode(){
   if (!data_node_freesymcount) {
     data_node_freesymcount.New();
-    OnUpdate([this](size_t){
-      data_node_freesymcount->Reset();
-      for (size_t i = 0; i< pop.size(); i++){
-        if (sym_pop[i]){
-          data_node_freesymcount->AddDatum(1);
-        }
-      }
+    size_t channel = stats_engine.AddChannel(*data_node_freesymcount);
+    stats_engine.AddFreeSymVisitor(channel, [channel](Organism&, StatsEngine::Emitter& out){
+      out.Emit(channel, 1);
     });
   }
   return *data_node_freesymcount;
@@ -757,17 +854,10 @@ emp::DataMonitor<int>& SymWorld::GetUninfectedHostsDataNode() {
   //keep track of host organisms that are uninfected
   if(!data_node_uninf_hosts) {
     data_node_uninf_hosts.New();
-    OnUpdate([this](size_t){
-  data_node_uninf_hosts -> Reset();
-
-  for (size_t i = 0; i < pop.size(); i++) {
-    if(IsOccupied(i)) {
-      if((pop[i]->GetSymbionts()).empty()) {
-        data_node_uninf_hosts->AddDatum(1);
-      }
-    } //endif
-  } //end for
-}); //end OnUpdate
+    size_t channel = stats_engine.AddChannel(*data_node_uninf_hosts);
+    stats_engine.AddHostVisitor(channel, [channel](Organism& host, StatsEngine::Emitter& out){
+      if (host.GetSymbionts().empty()) out.Emit(channel, 1);
+    });
   } //end if
   return *data_node_uninf_hosts;
 }
@@ -787,13 +877,9 @@ emp::DataMonitor<int>& SymWorld::GetUninfectedHostsDataNode() {
 emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetHostIntValDataNode() {
   if (!data_node_hostintval) {
     data_node_hostintval.New();
-    OnUpdate([this](size_t){
-      data_node_hostintval->Reset();
-      for (size_t i = 0; i< pop.size(); i++){
-        if (IsOccupied(i)){
-          data_node_hostintval->AddDatum(pop[i]->GetIntVal());
-        }
-      }
+    size_t channel = stats_engine.AddChannel(*data_node_hostintval);
+    stats_engine.AddHostVisitor(channel, [channel](Organism& host, StatsEngine::Emitter& out){
+      out.Emit(channel, host.GetIntVal());
     });
   }
   data_node_hostintval->SetupBins(-1.0, 1.1, 21);
@@ -813,20 +899,11 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetHostIntValDataNode(
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetSymIntValDataNode() {
   if (!data_node_symintval) {
     data_node_symintval.New();
-    OnUpdate([this](size_t){
-      data_node_symintval->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-          size_t sym_size = syms.size();
-          for(size_t j=0; j< sym_size; j++){
-            data_node_symintval->AddDatum(syms[j]->GetIntVal());
-          }//close for
-        }
-        if (sym_pop[i]) {
-          data_node_symintval->AddDatum(sym_pop[i]->GetIntVal());
-        } //close if
-      }//close for
+    size_t channel = stats_engine.AddChannel(*data_node_symintval);
+    stats_engine.AddSymVisitor(channel, [channel](Organism&, Organism& sym, StatsEngine::Emitter& out){
+      out.Emit(channel, sym.GetIntVal());
+    }, [channel](Organism& sym, StatsEngine::Emitter& out){
+      out.Emit(channel, sym.GetIntVal());
     });
   }
   data_node_symintval->SetupBins(-1.0, 1.1, 21);
@@ -846,13 +923,9 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetSymIntValDataNode()
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetFreeSymIntValDataNode() {
   if (!data_node_freesymintval) {
     data_node_freesymintval.New();
-    OnUpdate([this](size_t){
-      data_node_freesymintval->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (sym_pop[i]) {
-          data_node_freesymintval->AddDatum(sym_pop[i]->GetIntVal());
-        } //close if
-      }//close for
+    size_t channel = stats_engine.AddChannel(*data_node_freesymintval);
+    stats_engine.AddFreeSymVisitor(channel, [channel](Organism& sym, StatsEngine::Emitter& out){
+      out.Emit(channel, sym.GetIntVal());
     });
   }
   data_node_freesymintval->SetupBins(-1.0, 1.1, 21);
@@ -871,17 +944,9 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetFreeSymIntValDataNod
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetHostedSymIntValDataNode() {
   if (!data_node_hostedsymintval) {
     data_node_hostedsymintval.New();
-    OnUpdate([this](size_t){
-      data_node_hostedsymintval->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-          size_t sym_size = syms.size();
-          for(size_t j=0; j< sym_size; j++){
-            data_node_hostedsymintval->AddDatum(syms[j]->GetIntVal());
-          }//close for
-        }//close if
-      }//close for
+    size_t channel = stats_engine.AddChannel(*data_node_hostedsymintval);
+    stats_engine.AddHostedSymVisitor(channel, [channel](Organism&, Organism& sym, StatsEngine::Emitter& out){
+      out.Emit(channel, sym.GetIntVal());
     });
   }
   data_node_hostedsymintval->SetupBins(-1.0, 1.1, 21);
@@ -901,20 +966,11 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetHostedSymIntValDataN
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetSymInfectChanceDataNode() {
   if (!data_node_syminfectchance) {
     data_node_syminfectchance.New();
-    OnUpdate([this](size_t){
-      data_node_syminfectchance->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-          size_t sym_size = syms.size();
-          for(size_t j=0; j< sym_size; j++){
-            data_node_syminfectchance->AddDatum(syms[j]->GetInfectionChance());
-          }//close for
-        }
-        if (sym_pop[i]) {
-          data_node_syminfectchance->AddDatum(sym_pop[i]->GetInfectionChance());
-        } //close if
-      }//close for
+    size_t channel = stats_engine.AddChannel(*data_node_syminfectchance);
+    stats_engine.AddSymVisitor(channel, [channel](Organism&, Organism& sym, StatsEngine::Emitter& out){
+      out.Emit(channel, sym.GetInfectionChance());
+    }, [channel](Organism& sym, StatsEngine::Emitter& out){
+      out.Emit(channel, sym.GetInfectionChance());
     });
   }
   data_node_syminfectchance->SetupBins(0, 1.1, 11);
@@ -935,13 +991,9 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetSymInfectChanceDataN
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetFreeSymInfectChanceDataNode() {
   if (!data_node_freesyminfectchance) {
     data_node_freesyminfectchance.New();
-    OnUpdate([this](size_t){
-      data_node_freesyminfectchance->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (sym_pop[i]) {
-          data_node_freesyminfectchance->AddDatum(sym_pop[i]->GetInfectionChance());
-        } //close if
-      }//close for
+    size_t channel = stats_engine.AddChannel(*data_node_freesyminfectchance);
+    stats_engine.AddFreeSymVisitor(channel, [channel](Organism& sym, StatsEngine::Emitter& out){
+      out.Emit(channel, sym.GetInfectionChance());
     });
   }
   data_node_freesyminfectchance->SetupBins(0, 1.1, 11);
@@ -961,17 +1013,9 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetFreeSymInfectChanceD
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetHostedSymInfectChanceDataNode() {
   if (!data_node_hostedsyminfectchance) {
     data_node_hostedsyminfectchance.New();
-    OnUpdate([this](size_t){
-      data_node_hostedsyminfectchance->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-          size_t sym_size = syms.size();
-          for(size_t j=0; j< sym_size; j++){
-            data_node_hostedsyminfectchance->AddDatum(syms[j]->GetInfectionChance());
-          }//close for
-        }
-      }//close for
+    size_t channel = stats_engine.AddChannel(*data_node_hostedsyminfectchance);
+    stats_engine.AddHostedSymVisitor(channel, [channel](Organism&, Organism& sym, StatsEngine::Emitter& out){
+      out.Emit(channel, sym.GetInfectionChance());
     });
   }
   data_node_hostedsyminfectchance->SetupBins(0, 1.1, 11);
@@ -1102,20 +1146,10 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetVerticalTransmissio
 emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode() {
   if (!data_node_tag_dist) {
     data_node_tag_dist.New();
-    OnUpdate([this](size_t) {
-      data_node_tag_dist->Reset();
-      for (size_t i = 0; i < pop.size(); i++) {
-        if (IsOccupied(i)) {
-          if (pop[i]->HasSym()) {
-            emp::vector<emp::Ptr<Organism>> symbionts = pop[i]->GetSymbionts();
-            for (size_t j = 0; j < symbionts.size(); j++) {
-              double distance = (*tag_metric)(pop[i]->GetTag(), symbionts[j]->GetTag());
-              data_node_tag_dist->AddDatum(distance);
-            }
-          }
-        } //endif
-      } //end for
-    }); //end OnUpdate
+    size_t channel = stats_engine.AddChannel(*data_node_tag_dist);
+    stats_engine.AddHostedSymVisitor(channel, [this, channel](Organism& host, Organism& sym, StatsEngine::Emitter& out){
+      out.Emit(channel, (*tag_metric)(host.GetTag(), sym.GetTag()));
+    });
   } //end if
   data_node_tag_dist->SetupBins(0, 1.1, 11);
   return *data_node_tag_dist;
@@ -1133,14 +1167,10 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
 emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   if (!data_node_host_permissiveness) {
     data_node_host_permissiveness.New();
-    OnUpdate([this](size_t) {
-      data_node_host_permissiveness->Reset();
-      for (size_t i = 0; i < pop.size(); i++) {
-        if (IsOccupied(i)) {
-          data_node_host_permissiveness->AddDatum(pop[i]->GetTagPermissiveness());
-        } //endif
-      } //end for
-    }); //end OnUpdate
+    size_t channel = stats_engine.AddChannel(*data_node_host_permissiveness);
+    stats_engine.AddHostVisitor(channel, [channel](Organism& host, StatsEngine::Emitter& out){
+      out.Emit(channel, host.GetTagPermissiveness());
+    });
   } //end if
   return *data_node_host_permissiveness;
 }
@@ -1149,24 +1179,20 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetWithinHostVarianceDataNode() {
     if (!data_node_within_host_variance) {
       data_node_within_host_variance.New();
-      OnUpdate([this](size_t){
-        data_node_within_host_variance->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost() && pop[i]->HasSym()) {
-	          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-	          size_t sym_size = syms.size();
-            if (sym_size > 1) { // Can't take the variance of 1 thing
-              emp::vector<double> int_vals(sym_size);
-              for(size_t j=0; j< sym_size; j++){
-                int_vals[j] = syms[j]->GetIntVal();
-              }//close for
-              data_node_within_host_variance->AddDatum(emp::Variance(int_vals));
-            } else {
-              data_node_within_host_variance->AddDatum(0);
-            }
-
-          } //close if
-	      }//close for
+      size_t channel = stats_engine.AddChannel(*data_node_within_host_variance);
+      stats_engine.AddHostVisitor(channel, [channel](Organism& host, StatsEngine::Emitter& out){
+        if (!host.IsHost() || !host.HasSym()) return;
+        emp::vector<emp::Ptr<Organism>>& syms = host.GetSymbionts();
+        size_t sym_size = syms.size();
+        if (sym_size > 1) { // Can't take the variance of 1 thing
+          emp::vector<double> int_vals(sym_size);
+          for(size_t j=0; j< sym_size; j++){
+            int_vals[j] = syms[j]->GetIntVal();
+          }//close for
+          out.Emit(channel, emp::Variance(int_vals));
+        } else {
+          out.Emit(channel, 0);
+        }
       });
     }
     return *data_node_within_host_variance;
@@ -1175,19 +1201,16 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetWithinHostMeanDataNode() {
     if (!data_node_within_host_mean) {
       data_node_within_host_mean.New();
-      OnUpdate([this](size_t){
-        data_node_within_host_mean->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost() && pop[i]->HasSym()) {
-	          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-	          size_t sym_size = syms.size();
-	          emp::vector<double> int_vals(sym_size);
-            for(size_t j=0; j< sym_size; j++){
-	            int_vals[j] = syms[j]->GetIntVal();
-	          }//close for
-            data_node_within_host_mean->AddDatum(emp::Mean(int_vals));
-	        }//close if
-	      }//close for
+      size_t channel = stats_engine.AddChannel(*data_node_within_host_mean);
+      stats_engine.AddHostVisitor(channel, [channel](Organism& host, StatsEngine::Emitter& out){
+        if (!host.IsHost() || !host.HasSym()) return;
+        emp::vector<emp::Ptr<Organism>>& syms = host.GetSymbionts();
+        size_t sym_size = syms.size();
+        emp::vector<double> int_vals(sym_size);
+        for(size_t j=0; j< sym_size; j++){
+          int_vals[j] = syms[j]->GetIntVal();
+        }//close for
+        out.Emit(channel, emp::Mean(int_vals));
       });
     }
     return *data_node_within_host_mean;
@@ -1206,17 +1229,13 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<size_t>& SymWorld::GetHostReproCountDataNode() {
     if (!data_node_host_repro_count) {
       data_node_host_repro_count.New();
-      OnUpdate([this](size_t) {
-        data_node_host_repro_count->Reset();
-        data_node_sym_repro_count->Reset();
-        for (size_t i = 0; i < pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost()) {
-            data_node_host_repro_count->AddDatum(pop[i]->GetReproCount());
-            for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) {
-              data_node_sym_repro_count->AddDatum(sym->GetReproCount());
-            }
-          }
-        }
+      size_t host_channel = stats_engine.AddChannel(*data_node_host_repro_count);
+      size_t sym_channel = stats_engine.AddChannel(GetSymReproCountDataNode());
+      stats_engine.AddHostVisitor(host_channel, [host_channel](Organism& host, StatsEngine::Emitter& out) {
+        if (host.IsHost()) out.Emit(host_channel, host.GetReproCount());
+      });
+      stats_engine.AddHostedSymVisitor(sym_channel, [sym_channel](Organism& host, Organism& sym, StatsEngine::Emitter& out) {
+        if (host.IsHost()) out.Emit(sym_channel, sym.GetReproCount());
       });
     }
     return *data_node_host_repro_count;
@@ -1252,23 +1271,21 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<double>& SymWorld::GetHostTowardsPartnerRateDataNode() {
     if (!data_node_host_towards_partner_rate) {
       data_node_host_towards_partner_rate.New();
-      OnUpdate([this](size_t) {
-        data_node_host_towards_partner_rate->Reset();
-        data_node_host_from_partner_rate->Reset();
-        data_node_sym_towards_partner_rate->Reset();
-        data_node_sym_from_partner_rate->Reset();
-
-        for (size_t i = 0; i < pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost()) {
-            data_node_host_towards_partner_rate->AddDatum((double)pop[i]->GetTowardsPartnerCount() / (double)pop[i]->GetReproCount());
-            data_node_host_from_partner_rate->AddDatum((double)pop[i]->GetFromPartnerCount() / (double)pop[i]->GetReproCount());
-            for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) {
-              data_node_sym_towards_partner_rate->AddDatum((double)sym->GetTowardsPartnerCount() / (double)sym->GetReproCount());
-              data_node_sym_from_partner_rate->AddDatum((double)sym->GetFromPartnerCount() / (double)sym->GetReproCount());
-            }
-          }
-        }
-        });
+      size_t host_towards = stats_engine.AddChannel(*data_node_host_towards_partner_rate);
+      size_t host_from = stats_engine.AddChannel(GetHostFromPartnerRateDataNode());
+      size_t sym_towards = stats_engine.AddChannel(GetSymTowardsPartnerRateDataNode());
+      size_t sym_from = stats_engine.AddChannel(GetSymFromPartnerRateDataNode());
+
+      stats_engine.AddHostVisitor(host_towards, [host_towards, host_from](Organism& host, StatsEngine::Emitter& out) {
+        if (!host.IsHost()) return;
+        out.Emit(host_towards, (double)host.GetTowardsPartnerCount() / (double)host.GetReproCount());
+        out.Emit(host_from, (double)host.GetFromPartnerCount() / (double)host.GetReproCount());
+      });
+      stats_engine.AddHostedSymVisitor(sym_towards, [sym_towards, sym_from](Organism& host, Organism& sym, StatsEngine::Emitter& out) {
+        if (!host.IsHost()) return;
+        out.Emit(sym_towards, (double)sym.GetTowardsPartnerCount() / (double)sym.GetReproCount());
+        out.Emit(sym_from, (double)sym.GetFromPartnerCount() / (double)sym.GetReproCount());
+      });
     }
     return *data_node_host_towards_partner_rate;
   }
@@ -1335,6 +1352,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
     if (!data_node_host_tag_richness) {
       data_node_host_tag_richness.New();
       OnUpdate([this](size_t) {
+        if (!ShouldCollectDataNodes(update)) return;
         emp::vector<emp::BitSet<TAG_LENGTH>> host_tags;
         emp::vector<emp::BitSet<TAG_LENGTH>> symbiont_tags;
         data_node_host_tag_richness->Reset();
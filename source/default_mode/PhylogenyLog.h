@@ -0,0 +1,465 @@
+#ifndef PHYLOGENY_LOG_H
+#define PHYLOGENY_LOG_H
+
+#include "../../Empirical/include/emp/base/assert.hpp"
+#include "../../Empirical/include/emp/base/Ptr.hpp"
+#include "../../Empirical/include/emp/base/vector.hpp"
+
+#include "ColumnarDataFile.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/*
+  Incremental binary phylogeny logs (PHYLOGENY_LOG).
+
+  Instead of rewriting every taxon at each phylogeny snapshot, a PhylogenyLog
+  appends only what changed since the previous snapshot: the taxa that
+  appeared, went extinct, or were pruned, and the living taxa whose values
+  changed. Use PhylogenyLogReader (or symbulation_phylogeny_log_to_csv) to
+  rebuild the full snapshot at any logged update.
+
+  File layout:
+    - MAGIC (8 bytes)
+    - Schema: varint column count, then per column its type (1 byte) and key
+      (a varint length followed by the bytes)
+    - Records, each a kind (1 byte) followed by:
+      - BIRTH: varint id, varint parent id + 1 (0 for none), origin time,
+        and the taxon's values
+      - EXTINCT: varint id, destruction time, and the taxon's final values
+      - PRUNE: varint id (pruned, or removed by a PhylogenyPruner)
+      - SNAPSHOT: varint update (everything before it is the snapshot)
+      - UPDATE: varint id, and the living taxon's new values
+    A taxon's values are its counts (see COUNT_KEYS) as varints, then each
+    column's value. Times and column values are 8-byte little-endian doubles.
+
+  NOTE - A taxon's values are taken at the first snapshot after it appears
+         (or when it goes extinct, if that's sooner), at every later snapshot
+         where they changed, and when it goes extinct. So a rebuilt snapshot
+         has the values the taxa had at that snapshot.
+*/
+namespace phylolog {
+  enum class RecordKind : uint8_t { BIRTH = 0, EXTINCT = 1, PRUNE = 2, SNAPSHOT = 3, UPDATE = 4 };
+  enum class ColumnType : uint8_t { FLOAT = 0, INT = 1 };
+
+  constexpr char MAGIC[8] = {'S', 'Y', 'M', 'P', 'H', 'Y', 'L', '2'};
+
+  // Counts logged for every taxon, as in an emp::Systematics snapshot
+  constexpr size_t NUM_COUNTS = 4;
+  constexpr const char* COUNT_KEYS[NUM_COUNTS] = {"num_orgs", "tot_orgs", "num_offspring", "total_offspring"};
+
+  inline void PutDouble(std::string& out, double val) {
+    uint64_t bits = columnar::DoubleBits(val);
+    for (size_t i = 0; i < 8; ++i) {
+      out.push_back((char)(bits & 0xff));
+      bits >>= 8;
+    }
+  }
+
+  inline bool GetDouble(const char*& pos, const char* end, double& val) {
+    if (end - pos < 8) return false;
+    uint64_t bits = 0;
+    for (size_t i = 0; i < 8; ++i) bits |= (uint64_t)(uint8_t)pos[i] << (8 * i);
+    pos += 8;
+    val = columnar::BitsDouble(bits);
+    return true;
+  }
+
+  // Formats a column value the way the matching snapshot function prints it
+  inline std::string FormatColumn(ColumnType type, double val) {
+    if (type == ColumnType::INT) return std::to_string((int64_t)val);
+    return std::to_string(val);
+  }
+}
+
+/*
+  Logs one emp::Systematics' changes for later reconstruction. SymWorld
+  connects RecordNew, RecordExtinct, and RecordPrune to the systematics'
+  signals, and calls WriteSnapshot every PHYLOGENY_SNAPSHOT_INTERVAL.
+
+  The file is opened (and its schema written) at the first snapshot, so
+  every column must be added before then.
+*/
+template <typename TAXON>
+class PhylogenyLog {
+public:
+  using taxon_t = TAXON;
+
+protected:
+  std::string filename;
+  std::ofstream out_file;
+  emp::vector<std::function<double(const TAXON&)>> column_funs;
+  emp::vector<phylolog::ColumnType> column_types;
+  emp::vector<std::string> column_keys;
+
+  // A living taxon, and the values last logged for it (empty until its
+  // birth is logged)
+  struct LiveTaxon {
+    emp::Ptr<TAXON> taxon;
+    std::string logged_values;
+  };
+
+  // Records waiting for the next snapshot
+  std::string buffer;
+  // Living taxa by id (ids grow as taxa appear, so this is also birth order)
+  std::map<size_t, LiveTaxon> live_taxa;
+  // Scratch space for a living taxon's current values
+  std::string values_buffer;
+  size_t num_snapshots = 0;
+
+  void PutValues(std::string& out, const TAXON& taxon) {
+    columnar::PutVarint(out, taxon.GetNumOrgs());
+    columnar::PutVarint(out, taxon.GetTotOrgs());
+    columnar::PutVarint(out, taxon.GetNumOff());
+    columnar::PutVarint(out, taxon.GetTotalOffspring());
+    for (auto& fun : column_funs) phylolog::PutDouble(out, fun(taxon));
+  }
+
+  void PutBirth(const TAXON& taxon, const std::string& values) {
+    buffer.push_back((char)phylolog::RecordKind::BIRTH);
+    columnar::PutVarint(buffer, taxon.GetID());
+    columnar::PutVarint(buffer, taxon.GetParent() ? taxon.GetParent()->GetID() + 1 : 0);
+    phylolog::PutDouble(buffer, taxon.GetOriginationTime());
+    buffer += values;
+  }
+
+public:
+  PhylogenyLog(const std::string& _filename) : filename(_filename) { }
+
+  PhylogenyLog(const PhylogenyLog&) = delete;
+  PhylogenyLog& operator=(const PhylogenyLog&) = delete;
+
+  const std::string& GetFilename() const { return filename; }
+  size_t GetNumSnapshots() const { return num_snapshots; }
+  // Bytes of records waiting for the next snapshot
+  size_t GetBufferedBytes() const { return buffer.size(); }
+
+  /**
+   * Input: A function computing a value from a taxon, and the column's key.
+   *
+   * Output: None
+   *
+   * Purpose: Adds a column to the log (the equivalent of
+   * emp::Systematics::AddSnapshotFun). Integral values are written back out
+   * as integers.
+   */
+  template <typename FUN>
+  void AddColumn(FUN fun, const std::string& key) {
+    emp_assert(!out_file.is_open(), "Columns must be added before the first snapshot");
+    using value_t = std::decay_t<decltype(fun(std::declval<const TAXON&>()))>;
+    column_funs.emplace_back([fun](const TAXON& taxon) { return (double)fun(taxon); });
+    column_types.push_back(std::is_integral<value_t>::value ? phylolog::ColumnType::INT : phylolog::ColumnType::FLOAT);
+    column_keys.push_back(key);
+  }
+
+  // Connected to emp::Systematics::OnNew
+  void RecordNew(emp::Ptr<TAXON> taxon) {
+    live_taxa[taxon->GetID()].taxon = taxon;
+  }
+
+  // Connected to emp::Systematics::OnExtinct
+  void RecordExtinct(emp::Ptr<TAXON> taxon) {
+    values_buffer.clear();
+    PutValues(values_buffer, *taxon);
+    // The taxon may be pruned (and deleted) before the next snapshot
+    auto it = live_taxa.find(taxon->GetID());
+    if (it != live_taxa.end()) {
+      if (it->second.logged_values.empty()) PutBirth(*taxon, values_buffer);
+      live_taxa.erase(it);
+    }
+    buffer.push_back((char)phylolog::RecordKind::EXTINCT);
+    columnar::PutVarint(buffer, taxon->GetID());
+    phylolog::PutDouble(buffer, taxon->GetDestructionTime());
+    buffer += values_buffer;
+  }
+
+  // Connected to emp::Systematics::OnPrune (unless pruned taxa are kept)
+  void RecordPrune(emp::Ptr<TAXON> taxon) {
+    RecordRemoved(taxon->GetID());
+  }
+
+  // Records a taxon removed from the phylogeny some other way (by a
+  // PhylogenyPruner's limits)
+  void RecordRemoved(size_t id) {
+    buffer.push_back((char)phylolog::RecordKind::PRUNE);
+    columnar::PutVarint(buffer, id);
+  }
+
+  /**
+   * Input: The current update.
+   *
+   * Output: None
+   *
+   * Purpose: Appends everything that changed since the last snapshot to the
+   * log, followed by a snapshot marker.
+   *
+   * NOTE - Every living taxon's values are computed to find the ones that
+   *        changed, but only those are written.
+   */
+  void WriteSnapshot(size_t update) {
+    for (auto& [id, live] : live_taxa) {
+      values_buffer.clear();
+      PutValues(values_buffer, *live.taxon);
+      if (live.logged_values.empty()) {
+        PutBirth(*live.taxon, values_buffer);
+      } else if (values_buffer != live.logged_values) {
+        buffer.push_back((char)phylolog::RecordKind::UPDATE);
+        columnar::PutVarint(buffer, id);
+        buffer += values_buffer;
+      } else {
+        continue;
+      }
+      live.logged_values.swap(values_buffer);
+    }
+    buffer.push_back((char)phylolog::RecordKind::SNAPSHOT);
+    columnar::PutVarint(buffer, update);
+
+    if (!out_file.is_open()) {
+      out_file.open(filename, std::ios::binary | std::ios::trunc);
+      if (!out_file) {
+        std::cout << "Unable to open phylogeny log: " << filename << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      std::string schema(phylolog::MAGIC, sizeof(phylolog::MAGIC));
+      columnar::PutVarint(schema, column_keys.size());
+      for (size_t i = 0; i < column_keys.size(); ++i) {
+        schema.push_back((char)column_types[i]);
+        columnar::PutString(schema, column_keys[i]);
+      }
+      out_file.write(schema.data(), (std::streamsize)schema.size());
+    }
+    out_file.write(buffer.data(), (std::streamsize)buffer.size());
+    out_file.flush();
+    buffer.clear();
+    ++num_snapshots;
+  }
+};
+
+/*
+  Reads a phylogeny log and rebuilds full snapshots from it.
+*/
+class PhylogenyLogReader {
+public:
+  using ColumnType = phylolog::ColumnType;
+  using RecordKind = phylolog::RecordKind;
+
+  struct Taxon {
+    size_t id = 0;
+    bool has_parent = false;
+    size_t parent_id = 0;
+    double origin_time = 0;
+    double destruction_time = std::numeric_limits<double>::infinity();
+    std::array<size_t, phylolog::NUM_COUNTS> counts{}; // See phylolog::COUNT_KEYS
+    emp::vector<double> values;
+  };
+
+protected:
+  struct Record {
+    RecordKind kind;
+    size_t id = 0; // The update, for SNAPSHOT records
+    size_t parent = 0; // Parent id + 1 (or 0)
+    double time = 0;
+    std::array<size_t, phylolog::NUM_COUNTS> counts{};
+    emp::vector<double> values;
+  };
+
+  emp::vector<ColumnType> column_types;
+  emp::vector<std::string> column_keys;
+  emp::vector<Record> records;
+  // Index of each snapshot's SNAPSHOT record
+  emp::vector<size_t> snapshot_records;
+
+public:
+  /**
+   * Input: The file to read, and a string to hold an error message if it
+   * can't be read.
+   *
+   * Output: Whether the file was read.
+   *
+   * Purpose: Reads a whole phylogeny log. A record cut off at the end (by a
+   * run that didn't finish) is an error; records after the last snapshot are
+   * ignored.
+   */
+  bool Load(const std::string& filename, std::string& error) {
+    column_types.clear();
+    column_keys.clear();
+    records.clear();
+    snapshot_records.clear();
+    std::ifstream in_file(filename, std::ios::binary);
+    if (!in_file) {
+      error = "Unable to open phylogeny log: " + filename;
+      return false;
+    }
+    const std::string contents(
+      (std::istreambuf_iterator<char>(in_file)),
+      std::istreambuf_iterator<char>()
+    );
+    const std::string corrupt_error = "Not a phylogeny log, or truncated: " + filename;
+    const char* pos = contents.data();
+    const char* end = pos + contents.size();
+
+    if (contents.size() < sizeof(phylolog::MAGIC) ||
+        std::memcmp(pos, phylolog::MAGIC, sizeof(phylolog::MAGIC)) != 0) {
+      error = corrupt_error;
+      return false;
+    }
+    pos += sizeof(phylolog::MAGIC);
+    uint64_t num_columns = 0;
+    if (!columnar::GetVarint(pos, end, num_columns) || num_columns > (uint64_t)(end - pos)) {
+      error = corrupt_error;
+      return false;
+    }
+    column_types.resize(num_columns);
+    column_keys.resize(num_columns);
+    for (size_t i = 0; i < num_columns; ++i) {
+      if (pos == end || (uint8_t)*pos > (uint8_t)ColumnType::INT) {
+        error = corrupt_error;
+        return false;
+      }
+      column_types[i] = (ColumnType)*pos++;
+      if (!columnar::GetString(pos, end, column_keys[i])) {
+        error = corrupt_error;
+        return false;
+      }
+    }
+
+    while (pos < end) {
+      Record record;
+      record.kind = (RecordKind)*pos++;
+      uint64_t id = 0;
+      bool ok = columnar::GetVarint(pos, end, id);
+      record.id = id;
+      switch (record.kind) {
+        case RecordKind::BIRTH: {
+          uint64_t parent = 0;
+          ok = ok && columnar::GetVarint(pos, end, parent);
+          record.parent = parent;
+        }
+        [[fallthrough]];
+        case RecordKind::EXTINCT:
+          ok = ok && phylolog::GetDouble(pos, end, record.time);
+        [[fallthrough]];
+        case RecordKind::UPDATE:
+          for (size_t& count : record.counts) {
+            uint64_t val = 0;
+            ok = ok && columnar::GetVarint(pos, end, val);
+            count = val;
+          }
+          record.values.resize(num_columns);
+          for (double& val : record.values) ok = ok && phylolog::GetDouble(pos, end, val);
+          break;
+        case RecordKind::PRUNE:
+          break;
+        case RecordKind::SNAPSHOT:
+          snapshot_records.push_back(records.size());
+          break;
+        default:
+          ok = false;
+      }
+      if (!ok) {
+        error = corrupt_error;
+        return false;
+      }
+      records.push_back(std::move(record));
+    }
+    return true;
+  }
+
+  size_t GetNumColumns() const { return column_keys.size(); }
+  const std::string& GetColumnKey(size_t column) const { return column_keys[column]; }
+  size_t GetNumSnapshots() const { return snapshot_records.size(); }
+  size_t GetSnapshotUpdate(size_t snapshot) const { return records[snapshot_records[snapshot]].id; }
+
+  // Returns the index of the last snapshot at or before an update (or
+  // GetNumSnapshots() if there isn't one)
+  size_t FindSnapshot(size_t update) const {
+    size_t found = GetNumSnapshots();
+    for (size_t snapshot = 0; snapshot < GetNumSnapshots(); ++snapshot) {
+      if (GetSnapshotUpdate(snapshot) <= update) found = snapshot;
+    }
+    return found;
+  }
+
+  /**
+   * Input: The index of a snapshot.
+   *
+   * Output: Every taxon in the phylogeny at that snapshot, by id.
+   *
+   * Purpose: Rebuilds a full snapshot by replaying the log up to it.
+   */
+  emp::vector<Taxon> GetSnapshot(size_t snapshot) const {
+    emp_assert(snapshot < GetNumSnapshots());
+    std::map<size_t, Taxon> taxa;
+    for (size_t i = 0; i < snapshot_records[snapshot]; ++i) {
+      const Record& record = records[i];
+      switch (record.kind) {
+        case RecordKind::BIRTH: {
+          Taxon& taxon = taxa[record.id];
+          taxon.id = record.id;
+          taxon.has_parent = record.parent > 0;
+          taxon.parent_id = record.parent > 0 ? record.parent - 1 : 0;
+          taxon.origin_time = record.time;
+          taxon.counts = record.counts;
+          taxon.values = record.values;
+          break;
+        }
+        case RecordKind::EXTINCT:
+        case RecordKind::UPDATE: {
+          auto it = taxa.find(record.id);
+          if (it == taxa.end()) break;
+          if (record.kind == RecordKind::EXTINCT) it->second.destruction_time = record.time;
+          it->second.counts = record.counts;
+          it->second.values = record.values;
+          break;
+        }
+        case RecordKind::PRUNE:
+          taxa.erase(record.id);
+          break;
+        default:
+          break;
+      }
+    }
+    emp::vector<Taxon> result;
+    result.reserve(taxa.size());
+    for (auto& entry : taxa) {
+      // Like emp::Systematics, a taxon whose parent was removed has none
+      if (entry.second.has_parent && !taxa.count(entry.second.parent_id)) entry.second.has_parent = false;
+      result.push_back(std::move(entry.second));
+    }
+    return result;
+  }
+
+  // Writes a snapshot as CSV: the logged columns, then the columns every
+  // emp::Systematics snapshot has that the log can rebuild
+  void WriteSnapshotCSV(size_t snapshot, std::ostream& out) const {
+    for (const std::string& key : column_keys) out << key << ",";
+    out << "id,ancestor_list,origin_time,destruction_time";
+    for (const char* key : phylolog::COUNT_KEYS) out << "," << key;
+    out << "\n";
+    for (const Taxon& taxon : GetSnapshot(snapshot)) {
+      for (size_t column = 0; column < column_keys.size(); ++column) {
+        out << phylolog::FormatColumn(column_types[column], taxon.values[column]) << ",";
+      }
+      out << taxon.id << ",";
+      if (taxon.has_parent) out << "[" << taxon.parent_id << "]";
+      else out << "[NONE]";
+      out << "," << columnar::FormatValue(columnar::ColumnType::FLOAT, columnar::DoubleBits(taxon.origin_time))
+          << "," << columnar::FormatValue(columnar::ColumnType::FLOAT, columnar::DoubleBits(taxon.destruction_time));
+      for (size_t count : taxon.counts) out << "," << count;
+      out << "\n";
+    }
+  }
+};
+
+#endif
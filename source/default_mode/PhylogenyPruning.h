@@ -0,0 +1,192 @@
+#ifndef PHYLOGENY_PRUNING_H
+#define PHYLOGENY_PRUNING_H
+
+#include "../../Empirical/include/emp/base/Ptr.hpp"
+#include "../../Empirical/include/emp/base/vector.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
+
+/*
+  Phylogeny memory use, as reported by PhylogenyPruner::GetMemoryUse.
+*/
+struct PhylogenyMemoryUse {
+  size_t active = 0;
+  size_t ancestors = 0;
+  size_t outside = 0;
+  // Extinct taxa counted instead of stored (PHYLOGENY_COALESCE_EXTINCT)
+  size_t coalesced = 0;
+  // Ancestor taxa removed by the age and depth limits
+  size_t removed = 0;
+  // Estimated bytes held by the taxa and their data
+  size_t bytes = 0;
+
+  size_t GetNumTaxa() const { return active + ancestors + outside; }
+};
+
+/*
+  Bounds the memory one emp::Systematics uses in long runs, with these
+  policies (each off by default):
+    - Age limit: every PHYLOGENY_PRUNE_INTERVAL updates, ancestors that went
+      extinct more than max_ancestor_age updates ago are removed.
+    - Depth limit: every PHYLOGENY_PRUNE_INTERVAL updates, ancestors are
+      removed if they went extinct before the max_ancestor_depth-th ancestor
+      of every living taxon did. Every living taxon keeps at least that many
+      generations of ancestors.
+    - Coalescing: extinct taxa with no living descendants are counted and
+      deleted, instead of each being stored (with STORE_EXTINCT).
+    - Compacting: when a taxon goes extinct, its data is compacted into flat
+      arrays (see HostTaxonData::Compact).
+
+  NOTE - Both limits use emp::Systematics::RemoveBefore, which only removes
+         a taxon along with every ancestor above it, so the phylogeny is cut
+         from the root down and never loses a lineage's recent history.
+*/
+template <typename SYS, typename TAXON>
+class PhylogenyPruner {
+protected:
+  emp::Ptr<SYS> sys;
+  int max_ancestor_age;
+  int max_ancestor_depth;
+  bool coalesce_extinct;
+  bool compact_taxon_data;
+  size_t coalesced = 0;
+  size_t removed = 0;
+  // Called with the id of each taxon the limits remove (for the phylogeny log)
+  std::function<void(size_t)> on_remove;
+
+  // Rough sizes of a taxon's entry in the systematics' tracking set and in
+  // its parent's offspring set
+  static constexpr size_t SET_ENTRY_BYTES = 3 * sizeof(void*);
+  static constexpr size_t TREE_ENTRY_BYTES = 5 * sizeof(void*);
+
+  void CollectIds(std::unordered_set<size_t>& ids) const {
+    for (emp::Ptr<TAXON> taxon : sys->GetAncestors()) ids.insert(taxon->GetID());
+    for (emp::Ptr<TAXON> taxon : sys->GetOutside()) ids.insert(taxon->GetID());
+  }
+
+  template <typename SET>
+  size_t CountBytes(const SET& taxa) const {
+    size_t bytes = 0;
+    for (emp::Ptr<TAXON> taxon : taxa) {
+      bytes += sizeof(TAXON) + SET_ENTRY_BYTES + TREE_ENTRY_BYTES + taxon->GetData().GetExtraBytes();
+    }
+    return bytes;
+  }
+
+public:
+  PhylogenyPruner(
+    emp::Ptr<SYS> _sys,
+    int _max_ancestor_age,
+    int _max_ancestor_depth,
+    bool _coalesce_extinct,
+    bool _compact_taxon_data
+  ) :
+    sys(_sys),
+    max_ancestor_age(_max_ancestor_age),
+    max_ancestor_depth(_max_ancestor_depth),
+    coalesce_extinct(_coalesce_extinct),
+    compact_taxon_data(_compact_taxon_data)
+  {
+    if (coalesce_extinct) {
+      sys->SetStoreOutside(false);
+      std::function<void(emp::Ptr<TAXON>)> count_pruned = [this](emp::Ptr<TAXON>) { ++coalesced; };
+      sys->OnPrune(count_pruned);
+    }
+    if (compact_taxon_data) {
+      std::function<void(emp::Ptr<TAXON>)> compact = [](emp::Ptr<TAXON> taxon) { taxon->GetData().Compact(); };
+      sys->OnExtinct(compact);
+    }
+  }
+
+  PhylogenyPruner(const PhylogenyPruner&) = delete;
+  PhylogenyPruner& operator=(const PhylogenyPruner&) = delete;
+
+  bool HasLimits() const { return max_ancestor_age >= 0 || max_ancestor_depth >= 0; }
+
+  void OnRemove(const std::function<void(size_t)>& fun) { on_remove = fun; }
+
+  /**
+   * Input: The current update.
+   *
+   * Output: The update before which (extinct) ancestors may be removed, or
+   * 0 if the limits don't remove any.
+   *
+   * Purpose: Combines the age and depth limits, taking whichever removes
+   * more.
+   */
+  double GetRemovalCutoff(size_t update) const {
+    double cutoff = 0;
+    if (max_ancestor_age >= 0 && update > (size_t)max_ancestor_age) {
+      cutoff = (double)(update - max_ancestor_age);
+    }
+    if (max_ancestor_depth >= 0) {
+      // A living max_ancestor_depth-th ancestor (destruction time infinity)
+      // protects its descendants by itself, so it adds no limit
+      double depth_cutoff = (double)(update + 1);
+      for (emp::Ptr<TAXON> taxon : sys->GetActive()) {
+        emp::Ptr<TAXON> ancestor = taxon;
+        for (int depth = 0; depth < max_ancestor_depth && ancestor->GetParent(); ++depth) {
+          ancestor = ancestor->GetParent();
+        }
+        depth_cutoff = std::min(depth_cutoff, ancestor->GetDestructionTime());
+      }
+      cutoff = std::max(cutoff, depth_cutoff);
+    }
+    return cutoff;
+  }
+
+  /**
+   * Input: The current update.
+   *
+   * Output: The number of taxa removed.
+   *
+   * Purpose: Applies the age and depth limits.
+   */
+  size_t Prune(size_t update) {
+    if (!HasLimits()) return 0;
+    const double cutoff = GetRemovalCutoff(update);
+    if (cutoff <= 0) return 0;
+
+    std::unordered_set<size_t> before;
+    CollectIds(before);
+    sys->RemoveBefore((int)cutoff);
+    std::unordered_set<size_t> after;
+    CollectIds(after);
+
+    emp::vector<size_t> removed_ids;
+    for (size_t id : before) {
+      if (!after.count(id)) removed_ids.push_back(id);
+    }
+    // Sorted, so the log is the same from run to run
+    std::sort(removed_ids.begin(), removed_ids.end());
+    if (on_remove) {
+      for (size_t id : removed_ids) on_remove(id);
+    }
+    removed += removed_ids.size();
+    return removed_ids.size();
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: The number of taxa tracked, removed, and coalesced, and an
+   * estimate of the bytes they use.
+   *
+   * Purpose: Reports phylogeny memory use (for choosing limits). This visits
+   * every taxon, so call it only as often as it's written.
+   */
+  PhylogenyMemoryUse GetMemoryUse() const {
+    PhylogenyMemoryUse use;
+    use.active = sys->GetNumActive();
+    use.ancestors = sys->GetNumAncestors();
+    use.outside = sys->GetNumOutside();
+    use.coalesced = coalesced;
+    use.removed = removed;
+    use.bytes = CountBytes(sys->GetActive()) + CountBytes(sys->GetAncestors()) + CountBytes(sys->GetOutside());
+    return use;
+  }
+};
+
+#endif
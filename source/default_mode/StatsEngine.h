@@ -0,0 +1,212 @@
+#ifndef STATS_ENGINE_H
+#define STATS_ENGINE_H
+
+#include "../../Empirical/include/emp/data/DataNode.hpp"
+#include "../../Empirical/include/emp/math/math.hpp"
+#include "../Organism.h"
+
+#include <type_traits>
+
+/*
+  Fills population-scanning data nodes with one fused pass over the world.
+
+  Data nodes register a channel for their DataMonitor, plus one visitor per
+  channel that is called for every host, every hosted symbiont, and every
+  free-living symbiont it asks for. Visitors emit values to channels, which
+  add them straight to their DataMonitors, so each DataMonitor receives
+  exactly the same data, in the same order, as a loop over the world of its
+  own.
+
+  Within a world position, a visitor is called for the host first, then for
+  each hosted symbiont in order, then for the free-living symbiont.
+
+  Visitor functions are stored with their own types, and each visitor runs
+  over a block of positions at a time, so the per-organism calls are inlined
+  and only one virtual call is made per visitor per block. Blocks are small
+  enough that their organisms are still cached when the next visitor runs.
+
+  NOTE - The pass runs on the calling thread. Splitting it across threads
+         meant buffering every value and adding it to the DataMonitors
+         afterwards, which cost more than it saved.
+*/
+class StatsEngine {
+protected:
+  struct ChannelBase {
+    virtual ~ChannelBase() { }
+    virtual void Reset() = 0;
+    virtual void AddDatum(double value) = 0;
+  };
+
+public:
+  using pop_t = emp::vector<emp::Ptr<Organism>>;
+
+  // Passed to visitors to emit values to channels
+  class Emitter {
+    friend class StatsEngine;
+    const emp::vector<emp::Ptr<ChannelBase>>& channels;
+    Emitter(const emp::vector<emp::Ptr<ChannelBase>>& _channels) : channels(_channels) { }
+  public:
+    void Emit(size_t channel, double value) {
+      emp_assert(channel < channels.size());
+      channels[channel]->AddDatum(value);
+    }
+  };
+
+  // Stands in for the organisms a visitor doesn't look at
+  struct Skip {};
+
+  // Number of world positions each visitor runs over at a time
+  static constexpr size_t BLOCK_SIZE = 256;
+
+protected:
+  template <typename VAL_T, emp::data... MODS>
+  struct Channel : public ChannelBase {
+    emp::DataNode<VAL_T, MODS...>& node;
+    Channel(emp::DataNode<VAL_T, MODS...>& _node) : node(_node) { }
+    void Reset() override { node.Reset(); }
+    void AddDatum(double value) override { node.AddDatum((VAL_T) value); }
+  };
+
+  struct VisitorBase {
+    virtual ~VisitorBase() { }
+    virtual void VisitBlock(const pop_t& pop, const pop_t& sym_pop, size_t begin, size_t end, Emitter& out) = 0;
+  };
+
+  template <typename HOST_FUN, typename HOSTED_SYM_FUN, typename FREE_SYM_FUN>
+  struct Visitor : public VisitorBase {
+    static constexpr bool VISIT_HOST = !std::is_same_v<HOST_FUN, Skip>;
+    static constexpr bool VISIT_HOSTED_SYM = !std::is_same_v<HOSTED_SYM_FUN, Skip>;
+    static constexpr bool VISIT_FREE_SYM = !std::is_same_v<FREE_SYM_FUN, Skip>;
+
+    HOST_FUN host_fun;
+    HOSTED_SYM_FUN hosted_sym_fun;
+    FREE_SYM_FUN free_sym_fun;
+
+    Visitor(HOST_FUN _host, HOSTED_SYM_FUN _hosted_sym, FREE_SYM_FUN _free_sym)
+      : host_fun(_host), hosted_sym_fun(_hosted_sym), free_sym_fun(_free_sym) { }
+
+    void VisitBlock(const pop_t& pop, const pop_t& sym_pop, size_t begin, size_t end, Emitter& out) override {
+      for (size_t i = begin; i < end; i++) {
+        if constexpr (VISIT_HOST || VISIT_HOSTED_SYM) {
+          if (pop[i]) {
+            Organism& host = *pop[i];
+            if constexpr (VISIT_HOST) host_fun(host, out);
+            if constexpr (VISIT_HOSTED_SYM) {
+              for (emp::Ptr<Organism> sym : host.GetSymbionts()) hosted_sym_fun(host, *sym, out);
+            }
+          }
+        }
+        if constexpr (VISIT_FREE_SYM) {
+          if (sym_pop[i]) free_sym_fun(*sym_pop[i], out);
+        }
+      }
+    }
+  };
+
+  emp::vector<emp::Ptr<ChannelBase>> channels;
+  emp::vector<bool> channel_visited;
+  emp::vector<emp::Ptr<VisitorBase>> visitors;
+
+public:
+  StatsEngine() = default;
+  StatsEngine(const StatsEngine&) = delete;
+  StatsEngine& operator=(const StatsEngine&) = delete;
+
+  ~StatsEngine() {
+    for (emp::Ptr<ChannelBase> channel : channels) channel.Delete();
+    for (emp::Ptr<VisitorBase> visitor : visitors) visitor.Delete();
+  }
+
+  /**
+   * Input: The DataMonitor to fill.
+   *
+   * Output: The id of the new channel.
+   *
+   * Purpose: To add a channel that visitors can emit values to. The DataMonitor
+   * is reset at the start of each pass.
+   */
+  template <typename VAL_T, emp::data... MODS>
+  size_t AddChannel(emp::DataNode<VAL_T, MODS...>& node) {
+    channels.push_back(emp::NewPtr<Channel<VAL_T, MODS...>>(node));
+    channel_visited.push_back(false);
+    return channels.size() - 1;
+  }
+
+  /**
+   * Input: The channel the visitor fills, and the functions to call for each
+   * host, each hosted symbiont, and each free-living symbiont. Pass Skip{} for
+   * organisms the visitor doesn't look at.
+   *
+   * Output: None
+   *
+   * Purpose: To add the visitor that fills a channel.
+   *
+   * NOTE - A channel's values must all come from one visitor, so that they are
+   *        emitted in position order. A visitor may also emit to channels that
+   *        have no visitor of their own.
+   */
+  template <typename HOST_FUN, typename HOSTED_SYM_FUN, typename FREE_SYM_FUN>
+  void AddVisitor(size_t channel, HOST_FUN host_fun, HOSTED_SYM_FUN hosted_sym_fun, FREE_SYM_FUN free_sym_fun) {
+    emp_assert(channel < channels.size());
+    emp_assert(!channel_visited[channel], "Channel already has a visitor", channel);
+    channel_visited[channel] = true;
+    visitors.push_back(emp::NewPtr<Visitor<HOST_FUN, HOSTED_SYM_FUN, FREE_SYM_FUN>>(
+      host_fun, hosted_sym_fun, free_sym_fun
+    ));
+  }
+
+  template <typename HOST_FUN>
+  void AddHostVisitor(size_t channel, HOST_FUN fun) {
+    AddVisitor(channel, fun, Skip{}, Skip{});
+  }
+
+  template <typename HOSTED_SYM_FUN>
+  void AddHostedSymVisitor(size_t channel, HOSTED_SYM_FUN fun) {
+    AddVisitor(channel, Skip{}, fun, Skip{});
+  }
+
+  template <typename FREE_SYM_FUN>
+  void AddFreeSymVisitor(size_t channel, FREE_SYM_FUN fun) {
+    AddVisitor(channel, Skip{}, Skip{}, fun);
+  }
+
+  /**
+   * Input: The function to call for each hosted symbiont and the function to
+   * call for each free-living symbiont.
+   *
+   * Output: None
+   *
+   * Purpose: To add the visitor for a channel filled from every symbiont.
+   */
+  template <typename HOSTED_SYM_FUN, typename FREE_SYM_FUN>
+  void AddSymVisitor(size_t channel, HOSTED_SYM_FUN hosted_sym_fun, FREE_SYM_FUN free_sym_fun) {
+    AddVisitor(channel, Skip{}, hosted_sym_fun, free_sym_fun);
+  }
+
+  size_t GetNumChannels() const { return channels.size(); }
+
+  /**
+   * Input: The world's host population and free-living symbiont population
+   * (which must be the same size).
+   *
+   * Output: None
+   *
+   * Purpose: To reset every DataMonitor, and then fill it with one pass over
+   * the population.
+   */
+  void Run(const pop_t& pop, const pop_t& sym_pop) {
+    emp_assert(pop.size() == sym_pop.size());
+    if (visitors.empty()) return;
+
+    for (emp::Ptr<ChannelBase> channel : channels) channel->Reset();
+    Emitter out(channels);
+    for (size_t block = 0; block < pop.size(); block += BLOCK_SIZE) {
+      const size_t block_end = emp::Min(block + BLOCK_SIZE, pop.size());
+      for (emp::Ptr<VisitorBase> visitor : visitors) {
+        visitor->VisitBlock(pop, sym_pop, block, block_end, out);
+      }
+    }
+  }
+};
+
+#endif
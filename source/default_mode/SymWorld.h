@@ -9,6 +9,11 @@
 #include "../../Empirical/include/emp/matching/MatchBin.hpp"
 
 #include "../Organism.h"
+#include "AsyncOutput.h"
+#include "PhylogenyLog.h"
+#include "PhylogenyPruning.h"
+#include "StatsEngine.h"
+#include "TagDistanceMatrix.h"
 #include <cstdlib>
 #include <set>
 #include <math.h>
@@ -19,6 +24,9 @@ namespace taxon_t {
   using base_taxon_t = emp::Taxon<info_t, datastruct::TaxonDataBase>;
   using host_taxon_t = emp::Taxon<info_t, datastruct::HostTaxonData>;
   using sym_taxon_t = emp::Taxon<info_t, datastruct::SymbiontTaxonData>;
+
+  using host_sys_t = emp::Systematics<Organism, info_t, datastruct::HostTaxonData>;
+  using sym_sys_t = emp::Systematics<Organism, info_t, datastruct::SymbiontTaxonData>;
 }
 
 class SymWorld : public emp::World<Organism>{
@@ -85,12 +93,46 @@ protected:
   */
   emp::Ptr<emp::Systematics<Organism, taxon_t::info_t, datastruct::SymbiontTaxonData>> sym_sys;
 
+  /**
+    *
+    * Purpose: Represents the incremental phylogeny logs, used instead of full
+    * snapshots when PHYLOGENY_LOG is on.
+    *
+  */
+  emp::Ptr<PhylogenyLog<taxon_t::host_taxon_t>> host_phylo_log = nullptr;
+  emp::Ptr<PhylogenyLog<taxon_t::sym_taxon_t>> sym_phylo_log = nullptr;
+
+  /**
+    *
+    * Purpose: Represents the policies bounding phylogeny memory (ancestor
+    * limits, coalescing, and compacting), and their last memory report.
+    *
+  */
+  emp::Ptr<PhylogenyPruner<taxon_t::host_sys_t, taxon_t::host_taxon_t>> host_phylo_pruner = nullptr;
+  emp::Ptr<PhylogenyPruner<taxon_t::sym_sys_t, taxon_t::sym_taxon_t>> sym_phylo_pruner = nullptr;
+  PhylogenyMemoryUse host_phylo_memory;
+  PhylogenyMemoryUse sym_phylo_memory;
+  size_t phylo_memory_bytes = 0;
+
   /**
     *
     * Purpose: Represents the tag distance calculator.
     *
   */
   emp::Ptr<emp::BaseMetric<emp::BitSet<TAG_LENGTH>, emp::BitSet<TAG_LENGTH>>> tag_metric;
+  // Whether tag_metric is the plain Hamming metric, which the tag matrix
+  // computes with TagDistanceMatrix instead of calling it for every pair
+  bool hamming_tag_metric = false;
+
+  /**
+    *
+    * Purpose: Represents the background thread that writes output files when
+    * ASYNC_OUTPUT is on (created with the first data file), and the data files
+    * it writes.
+    *
+  */
+  emp::Ptr<AsyncWriter> output_writer = nullptr;
+  emp::vector<emp::Ptr<AsyncDataFile>> async_files;
 
   emp::Ptr<emp::DataMonitor<double, emp::data::Histogram>> data_node_hostintval; // New() reallocates this pointer
   emp::Ptr<emp::DataMonitor<double, emp::data::Histogram>> data_node_symintval;
@@ -131,6 +173,23 @@ protected:
 
   emp::Signal<void()> on_analyze_population_sig;
 
+  /**
+    *
+    * Purpose: Represents how often, in updates, the population-scanning data nodes
+    * are recalculated. Set to DATA_INT when data files are created, so the nodes
+    * are only filled on updates where a file will write them.
+    *
+  */
+  size_t data_node_interval = 1;
+
+  /**
+    *
+    * Purpose: Represents the fused statistics pass that fills the population-scanning
+    * data nodes. Data node getters register their visitors with it.
+    *
+  */
+  StatsEngine stats_engine;
+
 public:
   /**
    * Input: The world's random seed and a pointer to this world's config object
@@ -184,15 +243,23 @@ public:
       AddSystematics(host_sys);
       sym_sys->SetStorePosition(false);
 
-      sym_sys->AddSnapshotFun([](const taxon_t::sym_taxon_t& t) {return std::to_string(t.GetInfo()); }, "info");
-      host_sys->AddSnapshotFun([](const taxon_t::host_taxon_t& t) {return std::to_string(t.GetInfo()); }, "info");
+      if (my_config->PHYLOGENY_LOG()) {
+        std::string file_ending = my_config->FILE_NAME() + "_SEED" + std::to_string(my_config->SEED()) + ".phylolog";
+        host_phylo_log = emp::NewPtr<PhylogenyLog<taxon_t::host_taxon_t>>(my_config->FILE_PATH() + "HostPhylogenyLog" + file_ending);
+        sym_phylo_log = emp::NewPtr<PhylogenyLog<taxon_t::sym_taxon_t>>(my_config->FILE_PATH() + "SymPhylogenyLog" + file_ending);
+        ConnectPhylogenyLog(host_sys, host_phylo_log);
+        ConnectPhylogenyLog(sym_sys, sym_phylo_log);
+      }
+
+      AddPhylogenyColumn(sym_sys, sym_phylo_log, [](const taxon_t::sym_taxon_t& t) {return t.GetInfo(); }, "info");
+      AddPhylogenyColumn(host_sys, host_phylo_log, [](const taxon_t::host_taxon_t& t) {return t.GetInfo(); }, "info");
 
       if (my_config->PHYLOGENY_TAXON_TYPE() == 2 || my_config->PHYLOGENY_TAXON_TYPE() == 3) {
-        sym_sys->AddSnapshotFun([](const taxon_t::sym_taxon_t& t) {return std::to_string((t.GetData()).GetIntVal()); }, "mean_int_val");
-        host_sys->AddSnapshotFun([](const taxon_t::host_taxon_t& t) {return std::to_string(t.GetData().GetIntVal()); }, "mean_int_val");
+        AddPhylogenyColumn(sym_sys, sym_phylo_log, [](const taxon_t::sym_taxon_t& t) {return t.GetData().GetIntVal(); }, "mean_int_val");
+        AddPhylogenyColumn(host_sys, host_phylo_log, [](const taxon_t::host_taxon_t& t) {return t.GetData().GetIntVal(); }, "mean_int_val");
       }
       if (my_config->PHYLOGENY_TAXON_TYPE() == 3) {
-        sym_sys->AddSnapshotFun([](const taxon_t::sym_taxon_t& t) {return std::to_string(t.GetData().GetHostSwitch()); }, "lineage_host_switch_count");
+        AddPhylogenyColumn(sym_sys, sym_phylo_log, [](const taxon_t::sym_taxon_t& t) {return t.GetData().GetHostSwitch(); }, "lineage_host_switch_count");
       }
 
       on_placement_sig.AddAction([this](emp::WorldPosition pos) {
@@ -214,6 +281,18 @@ public:
         sym_sys->SetStoreOutside(true);
         host_sys->SetStoreOutside(true);
       }
+
+      const bool coalesce_extinct = my_config->STORE_EXTINCT() && my_config->PHYLOGENY_COALESCE_EXTINCT();
+      host_phylo_pruner = emp::NewPtr<PhylogenyPruner<taxon_t::host_sys_t, taxon_t::host_taxon_t>>(host_sys,
+        my_config->PHYLOGENY_MAX_ANCESTOR_AGE(), my_config->PHYLOGENY_MAX_ANCESTOR_DEPTH(),
+        coalesce_extinct, my_config->PHYLOGENY_COMPACT_TAXON_DATA());
+      sym_phylo_pruner = emp::NewPtr<PhylogenyPruner<taxon_t::sym_sys_t, taxon_t::sym_taxon_t>>(sym_sys,
+        my_config->PHYLOGENY_MAX_ANCESTOR_AGE(), my_config->PHYLOGENY_MAX_ANCESTOR_DEPTH(),
+        coalesce_extinct, my_config->PHYLOGENY_COMPACT_TAXON_DATA());
+      if (my_config->PHYLOGENY_LOG()) {
+        host_phylo_pruner->OnRemove([this](size_t id) { host_phylo_log->RecordRemoved(id); });
+        sym_phylo_pruner->OnRemove([this](size_t id) { sym_phylo_log->RecordRemoved(id); });
+      }
     }
 
     if (my_config->TAG_MATCHING()) {
@@ -223,11 +302,20 @@ public:
         else if (my_config->TAG_METRIC() == 2) tag_metric = emp::NewPtr<emp::UnifMod<emp::HashMetric<TAG_LENGTH>>>();
       }
       else {
-        if (my_config->TAG_METRIC() == 0) tag_metric = emp::NewPtr<emp::HammingMetric<TAG_LENGTH>>();
+        if (my_config->TAG_METRIC() == 0) {
+          tag_metric = emp::NewPtr<emp::HammingMetric<TAG_LENGTH>>();
+          hamming_tag_metric = true;
+        }
         else if (my_config->TAG_METRIC() == 1) tag_metric = emp::NewPtr<emp::StreakMetric<TAG_LENGTH>>();
         else if (my_config->TAG_METRIC() == 2) tag_metric = emp::NewPtr<emp::HashMetric<TAG_LENGTH>>();
       }
     }
+
+    // Fills the population-scanning data nodes before any other update handler runs
+    OnUpdate([this](size_t){
+      if (!ShouldCollectDataNodes(update)) return;
+      stats_engine.Run(pop, sym_pop);
+    });
   }
   
 
@@ -239,6 +327,7 @@ public:
    * Purpose: To destruct the objects belonging to SymWorld to conserve memory.
    */
   virtual ~SymWorld() {
+    FinishOutput();
     if (data_node_hostintval) data_node_hostintval.Delete();
     if (data_node_symintval) data_node_symintval.Delete();
     if (data_node_freesymintval) data_node_freesymintval.Delete();
@@ -282,6 +371,11 @@ public:
       Clear(); // delete hosts here so that hosted symbionts get
       // deleted and unlinked from the sym_sys
       sym_sys.Delete();
+      // Deleted after the population, whose removal they record
+      if (host_phylo_log) host_phylo_log.Delete();
+      if (sym_phylo_log) sym_phylo_log.Delete();
+      host_phylo_pruner.Delete();
+      sym_phylo_pruner.Delete();
     }
 
     if (my_config->TAG_MATCHING()) {
@@ -342,6 +436,7 @@ public:
    */
    void SetTagMetric(emp::Ptr<emp::BaseMetric<emp::BitSet<TAG_LENGTH>, emp::BitSet<TAG_LENGTH>>> _in) {
     tag_metric = _in;
+    hamming_tag_metric = false;
   }
 
   /**
@@ -373,6 +468,49 @@ public:
    */
   const emp::Ptr<SymConfigBase> GetConfig() const { return my_config; }
 
+  /**
+   * Input: The number of updates between data node recalculations.
+   *
+   * Output: None
+   *
+   * Purpose: To set how often the population-scanning data nodes are
+   * recalculated. Nodes keep their previous values on the updates in between.
+   */
+  void SetDataNodeInterval(size_t _in) {
+    emp_assert(_in > 0);
+    data_node_interval = _in;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: How often, in updates, the population-scanning data nodes are recalculated.
+   *
+   * Purpose: To get the data node recalculation interval.
+   */
+  size_t GetDataNodeInterval() const { return data_node_interval; }
+
+  /**
+   * Input: The current update.
+   *
+   * Output: Whether the population-scanning data nodes should be recalculated.
+   *
+   * Purpose: To skip full population scans on updates where no data file writes.
+   */
+  bool ShouldCollectDataNodes(size_t cur_update) const {
+    return cur_update % data_node_interval == 0;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: A reference to the statistics engine.
+   *
+   * Purpose: To allow data nodes to register their visitors with the fused
+   * statistics pass.
+   */
+  StatsEngine& GetStatsEngine() { return stats_engine; }
+
 
 
   /**
@@ -412,6 +550,94 @@ public:
   }
 
 
+  /**
+   * Input: None
+   *
+   * Output: The incremental phylogeny logs (null unless PHYLOGENY_LOG is on)
+   *
+   * Purpose: To retrieve the host and symbiont phylogeny logs
+   */
+  emp::Ptr<PhylogenyLog<taxon_t::host_taxon_t>> GetHostPhylogenyLog(){
+    return host_phylo_log;
+  }
+  emp::Ptr<PhylogenyLog<taxon_t::sym_taxon_t>> GetSymPhylogenyLog(){
+    return sym_phylo_log;
+  }
+
+
+  /**
+   * Input: None
+   *
+   * Output: The host and symbiont phylogeny memory use (PHYLOGENY only)
+   *
+   * Purpose: To report how many taxa the phylogenies hold, and roughly how
+   * much memory they use
+   */
+  PhylogenyMemoryUse GetHostPhylogenyMemoryUse(){
+    return host_phylo_pruner->GetMemoryUse();
+  }
+  PhylogenyMemoryUse GetSymPhylogenyMemoryUse(){
+    return sym_phylo_pruner->GetMemoryUse();
+  }
+
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To apply PHYLOGENY_MAX_ANCESTOR_AGE and
+   * PHYLOGENY_MAX_ANCESTOR_DEPTH every PHYLOGENY_PRUNE_INTERVAL updates
+   */
+  void PrunePhylogeny(){
+    const int interval = my_config->PHYLOGENY_PRUNE_INTERVAL();
+    if (!my_config->PHYLOGENY() || interval <= 0 || update % interval != 0) return;
+    host_phylo_pruner->Prune(update);
+    sym_phylo_pruner->Prune(update);
+  }
+
+
+  /**
+   * Input: A systematics object, its phylogeny log (or null), a function
+   * computing a value from a taxon, and the column's key.
+   *
+   * Output: None
+   *
+   * Purpose: To add a column to phylogeny snapshots, logged as a number if
+   * PHYLOGENY_LOG is on, and printed with std::to_string otherwise.
+   */
+  template <typename SYS, typename TAXON, typename FUN>
+  void AddPhylogenyColumn(emp::Ptr<SYS> sys, emp::Ptr<PhylogenyLog<TAXON>> log, FUN fun, const std::string & key) {
+    if (log) log->AddColumn(fun, key);
+    else sys->AddSnapshotFun([fun](const TAXON& t) {return std::to_string(fun(t)); }, key);
+  }
+
+
+  /**
+   * Input: A systematics object and its phylogeny log.
+   *
+   * Output: None
+   *
+   * Purpose: To record the systematics' new, extinct, and pruned taxa in the
+   * log. Pruned taxa are kept (not logged as removed) if STORE_EXTINCT is on,
+   * unless PHYLOGENY_COALESCE_EXTINCT is too.
+   */
+  template <typename SYS, typename TAXON>
+  void ConnectPhylogenyLog(emp::Ptr<SYS> sys, emp::Ptr<PhylogenyLog<TAXON>> log) {
+    std::function<void(emp::Ptr<TAXON>, Organism&)> record_new =
+      [log](emp::Ptr<TAXON> taxon, Organism&) { log->RecordNew(taxon); };
+    std::function<void(emp::Ptr<TAXON>)> record_extinct =
+      [log](emp::Ptr<TAXON> taxon) { log->RecordExtinct(taxon); };
+    sys->OnNew(record_new);
+    sys->OnExtinct(record_extinct);
+    if (!my_config->STORE_EXTINCT() || my_config->PHYLOGENY_COALESCE_EXTINCT()) {
+      std::function<void(emp::Ptr<TAXON>)> record_prune =
+        [log](emp::Ptr<TAXON> taxon) { log->RecordPrune(taxon); };
+      sys->OnPrune(record_prune);
+    }
+  }
+
+
   /**
    * Input: None
    *
@@ -758,6 +984,10 @@ public:
   emp::Ptr<emp::Taxon<taxon_t::info_t>> GetDominantSymTaxon();
   emp::Ptr<emp::Taxon<taxon_t::info_t>> GetDominantHostTaxon();
   emp::vector<emp::Ptr<emp::Taxon<taxon_t::info_t>>> GetDominantFreeHostedSymTaxon();
+  emp::DataFile & SetupFile(const std::string & filename);
+  void WriteOutputFile(const std::string & filename, const std::string & contents);
+  void FinishOutput();
+  emp::Ptr<AsyncWriter> GetOutputWriter() { return output_writer; }
   emp::DataFile & SetupSymIntValFile(const std::string & filename);
   emp::DataFile & SetupHostIntValFile(const std::string & filename);
   emp::DataFile & SetupFreeLivingSymFile(const std::string & filename);
@@ -765,6 +995,7 @@ public:
   emp::DataFile & SetupTransmissionFile(const std::string & filename);
   emp::DataFile & SetupTagDistFile(const std::string& filename);
   emp::DataFile & SetupSymDiversityFile(const std::string & filename);
+  emp::DataFile & SetupPhylogenyMemoryFile(const std::string & filename);
   virtual void SetupTransmissionFileColumns(emp::DataFile& file);
   virtual void SetupHostFileColumns(emp::DataFile & file);
   emp::DataMonitor<int>& GetHostCountDataNode();
@@ -1174,6 +1405,7 @@ public:
 
     if(my_config->PHYLOGENY()) {
       sym_sys->Update(); //sym_sys is not part of the systematics vector, handle it independently
+      PrunePhylogeny();
 
       if (update % my_config->PHYLOGENY_SNAPSHOT_INTERVAL() == 0) {
         // MapPhylogenyInteractions();
@@ -0,0 +1,497 @@
+#ifndef TAG_DISTANCE_MATRIX_H
+#define TAG_DISTANCE_MATRIX_H
+
+#include "../../Empirical/include/emp/base/vector.hpp"
+#include "../../Empirical/include/emp/bits/BitSet.hpp"
+#include "ColumnarDataFile.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+/*
+  Tag distance matrices (WRITE_TAG_MATRIX), written as CSV or, with
+  TAG_MATRIX_FORMAT binary, as .tagm files. Use TagMatrixReader (or
+  symbulation_tag_matrix_to_csv) to read binary matrices back.
+
+  Binary layout (varints and strings as in columnar data files):
+    - MAGIC (8 bytes)
+    - Value kind (1 byte): COUNTS (mismatching bits, with the Hamming metric)
+      or DISTANCES (the bits of each double, with any other metric)
+    - Varint tag length in bits, varint row count, varint column count
+    - Row labels, then column labels (a varint world position each)
+    - Rows: encoding (1 byte), varint byte count, and encoded values, either
+      RAW (a varint per value) or RUNS (a varint value and varint run length
+      per run of equal values), whichever is shorter. Runs are common, since
+      hosted symbionts start with their host's tag.
+*/
+namespace tagmatrix {
+  enum class ValueKind : uint8_t { COUNTS = 0, DISTANCES = 1 };
+  enum class RowEncoding : uint8_t { RAW = 0, RUNS = 1 };
+
+  constexpr char MAGIC[8] = {'S', 'Y', 'M', 'T', 'A', 'G', 'M', '1'};
+
+  // Formats a distance the way an ostream would have printed it
+  inline void AppendDistance(std::string& out, double distance) {
+    char formatted[32];
+    const int length = std::snprintf(formatted, sizeof(formatted), "%g", distance);
+    out.append(formatted, length);
+  }
+
+  inline size_t VarintSize(uint64_t val) {
+    size_t size = 1;
+    for (; val >= 0x80; val >>= 7) ++size;
+    return size;
+  }
+
+  // columnar::PutVarint, into space that's already allocated
+  inline size_t PutVarintAt(std::string& out, size_t pos, uint64_t val) {
+    for (; val >= 0x80; val >>= 7) out[pos++] = (char)(val | 0x80);
+    out[pos++] = (char)val;
+    return pos;
+  }
+
+  /**
+   * Input: The string to append to, the matrix's row and column labels, and a
+   * function appending the value at (row, column) to a string.
+   *
+   * Output: None
+   *
+   * Purpose: Appends a matrix as CSV: a header of column labels, then each row
+   * label and its values (every cell is followed by a comma).
+   */
+  template <typename APPEND_FUN>
+  void AppendCSV(
+    std::string& out,
+    const emp::vector<size_t>& row_labels,
+    const emp::vector<size_t>& column_labels,
+    APPEND_FUN append_value
+  ) {
+    out += ',';
+    for (size_t label : column_labels) {
+      out += std::to_string(label);
+      out += ',';
+    }
+    out += '\n';
+    for (size_t row = 0; row < row_labels.size(); ++row) {
+      out += std::to_string(row_labels[row]);
+      out += ',';
+      for (size_t column = 0; column < column_labels.size(); ++column) {
+        append_value(out, row, column);
+        out += ',';
+      }
+      out += '\n';
+    }
+  }
+
+  /**
+   * Input: The string to append to, the kind of values, the tag length, the
+   * matrix's row and column labels, and a function returning the value at
+   * (row, column) as a uint64_t.
+   *
+   * Output: None
+   *
+   * Purpose: Appends a matrix in the binary layout.
+   */
+  template <typename VALUE_FUN>
+  void AppendBinary(
+    std::string& out,
+    ValueKind kind,
+    size_t tag_bits,
+    const emp::vector<size_t>& row_labels,
+    const emp::vector<size_t>& column_labels,
+    VALUE_FUN value
+  ) {
+    out.append(MAGIC, sizeof(MAGIC));
+    out.push_back((char)kind);
+    columnar::PutVarint(out, tag_bits);
+    columnar::PutVarint(out, row_labels.size());
+    columnar::PutVarint(out, column_labels.size());
+    for (size_t label : row_labels) columnar::PutVarint(out, label);
+    for (size_t label : column_labels) columnar::PutVarint(out, label);
+
+    emp::vector<uint64_t> row_values(column_labels.size());
+    for (size_t row = 0; row < row_labels.size(); ++row) {
+      // Sizes both encodings first, so only the shorter one is written
+      size_t raw_size = 0;
+      size_t runs_size = 0;
+      size_t run_begin = 0;
+      for (size_t column = 0; column < row_values.size(); ++column) {
+        row_values[column] = value(row, column);
+        raw_size += VarintSize(row_values[column]);
+        if (column > 0 && row_values[column] != row_values[column - 1]) {
+          runs_size += VarintSize(row_values[run_begin]) + VarintSize(column - run_begin);
+          run_begin = column;
+        }
+      }
+      if (!row_values.empty()) {
+        runs_size += VarintSize(row_values[run_begin]) + VarintSize(row_values.size() - run_begin);
+      }
+      const bool use_runs = runs_size < raw_size;
+      out.push_back((char)(use_runs ? RowEncoding::RUNS : RowEncoding::RAW));
+      columnar::PutVarint(out, use_runs ? runs_size : raw_size);
+
+      size_t pos = out.size();
+      out.resize(pos + (use_runs ? runs_size : raw_size));
+      if (!use_runs) {
+        for (uint64_t val : row_values) pos = PutVarintAt(out, pos, val);
+        continue;
+      }
+      run_begin = 0;
+      for (size_t column = 1; column <= row_values.size(); ++column) {
+        if (column == row_values.size() || row_values[column] != row_values[run_begin]) {
+          pos = PutVarintAt(out, pos, row_values[run_begin]);
+          pos = PutVarintAt(out, pos, column - run_begin);
+          run_begin = column;
+        }
+      }
+    }
+  }
+
+  /**
+   * Input: The name of a tag matrix file (e.g., ending in .data or .csv).
+   *
+   * Output: The name to use for its binary version.
+   *
+   * Purpose: Swaps a tag matrix file's extension for .tagm.
+   */
+  inline std::string GetBinaryFilename(const std::string& filename) {
+    return std::filesystem::path(filename).replace_extension(".tagm").string();
+  }
+}
+
+/*
+  Computes every pairwise Hamming distance between a set of row tags and a set
+  of column tags (e.g., hosts and symbionts).
+
+  Tags are packed into 32- or 64-bit words, and the column words are transposed so
+  that word w of every column is contiguous. The innermost loop then XORs one
+  row word against a run of column words and popcounts the result, which the
+  compiler vectorizes. The matrix is computed in tiles of ROW_BLOCK rows by
+  COL_BLOCK columns, so a tile's column words stay in cache while each of its
+  rows sweeps across them, and row blocks are split between threads.
+
+  Distances are stored as mismatching bit counts; GetDistance divides by the
+  tag length, matching emp::HammingMetric.
+*/
+template <size_t NUM_BITS>
+class TagDistanceMatrix {
+public:
+  using tag_t = emp::BitSet<NUM_BITS>;
+  using count_t = std::conditional_t<(NUM_BITS < 256), uint8_t, uint16_t>;
+  // Short tags use 32-bit words, so twice as many fit in a vector register
+  using word_t = std::conditional_t<(NUM_BITS <= 32), uint32_t, uint64_t>;
+
+  static constexpr size_t WORD_BITS = sizeof(word_t) * 8;
+  static constexpr size_t WORDS = (NUM_BITS + WORD_BITS - 1) / WORD_BITS;
+  static constexpr size_t ROW_BLOCK = 32;
+  static constexpr size_t COL_BLOCK = 2048;
+
+protected:
+  size_t num_rows = 0;
+  size_t num_columns = 0;
+  emp::vector<word_t> row_words;        // WORDS per row, row by row
+  emp::vector<word_t> column_words;     // WORDS per column, column by column
+  emp::vector<word_t> transposed_words; // column_words, word by word
+  emp::vector<count_t> counts;            // Row-major
+
+  static void Pack(const tag_t& tag, emp::vector<word_t>& words) {
+    for (size_t w = 0; w < WORDS; ++w) {
+      word_t word = 0;
+      const size_t bit_end = std::min(NUM_BITS, (w + 1) * WORD_BITS);
+      for (size_t bit = w * WORD_BITS; bit < bit_end; ++bit) {
+        if (tag.Get(bit)) word |= (word_t)1 << (bit - w * WORD_BITS);
+      }
+      words.push_back(word);
+    }
+  }
+
+  // Bit counting with only shifts, masks, and adds, which vectorizes on any
+  // x86-64 (std::popcount only does with a hardware popcount instruction)
+  static word_t CountBits(word_t word) {
+#ifdef __POPCNT__
+    return std::popcount(word);
+#else
+    constexpr word_t ONES = ~(word_t)0;
+    word = word - ((word >> 1) & (ONES / 3));
+    word = (word & (ONES / 5)) + ((word >> 2) & (ONES / 5));
+    word = (word + (word >> 4)) & (ONES / 17);
+    word = word + (word >> 8);
+    word = word + (word >> 16);
+    if constexpr (WORD_BITS == 64) word = word + (word >> 32);
+    return word & 0x7f;
+#endif
+  }
+
+  // The innermost loop, kept separate so the compiler vectorizes it
+  static void CountTile(count_t* __restrict out, const word_t* __restrict in, word_t row_word, size_t width, bool first_word) {
+    if (first_word) {
+      for (size_t i = 0; i < width; ++i) out[i] = (count_t)CountBits(row_word ^ in[i]);
+    } else {
+      for (size_t i = 0; i < width; ++i) out[i] += (count_t)CountBits(row_word ^ in[i]);
+    }
+  }
+
+  void ComputeRows(size_t row_begin, size_t row_end) {
+    for (size_t block_begin = row_begin; block_begin < row_end; block_begin += ROW_BLOCK) {
+      const size_t block_end = std::min(block_begin + ROW_BLOCK, row_end);
+      for (size_t column_begin = 0; column_begin < num_columns; column_begin += COL_BLOCK) {
+        const size_t tile_width = std::min(COL_BLOCK, num_columns - column_begin);
+        for (size_t row = block_begin; row < block_end; ++row) {
+          for (size_t w = 0; w < WORDS; ++w) {
+            CountTile(counts.data() + row * num_columns + column_begin,
+              transposed_words.data() + w * num_columns + column_begin,
+              row_words[row * WORDS + w], tile_width, w == 0);
+          }
+        }
+      }
+    }
+  }
+
+public:
+  void Clear() {
+    num_rows = 0;
+    num_columns = 0;
+    row_words.clear();
+    column_words.clear();
+    transposed_words.clear();
+    counts.clear();
+  }
+
+  void AddRow(const tag_t& tag) {
+    Pack(tag, row_words);
+    ++num_rows;
+  }
+
+  void AddColumn(const tag_t& tag) {
+    Pack(tag, column_words);
+    ++num_columns;
+  }
+
+  size_t GetNumRows() const { return num_rows; }
+  size_t GetNumColumns() const { return num_columns; }
+
+  /**
+   * Input: How many threads to use.
+   *
+   * Output: None
+   *
+   * Purpose: Computes the distance between every row and column tag added so
+   * far. Threads get contiguous ranges of row blocks, and write disjoint rows.
+   */
+  void Compute(size_t num_threads = 1) {
+    transposed_words.resize(WORDS * num_columns);
+    for (size_t column = 0; column < num_columns; ++column) {
+      for (size_t w = 0; w < WORDS; ++w) {
+        transposed_words[w * num_columns + column] = column_words[column * WORDS + w];
+      }
+    }
+    counts.resize(num_rows * num_columns);
+
+    const size_t num_blocks = (num_rows + ROW_BLOCK - 1) / ROW_BLOCK;
+    const size_t thread_count = std::max(std::min(num_threads, num_blocks), (size_t) 1);
+    auto range_begin = [this, num_blocks, thread_count](size_t t) {
+      return std::min(((num_blocks * t) / thread_count) * ROW_BLOCK, num_rows);
+    };
+    emp::vector<std::thread> threads;
+    for (size_t t = 1; t < thread_count; t++) {
+      threads.emplace_back([this, t, &range_begin]() { ComputeRows(range_begin(t), range_begin(t + 1)); });
+    }
+    ComputeRows(range_begin(0), range_begin(1));
+    for (auto& thread : threads) thread.join();
+  }
+
+  // The number of bits that differ between a row tag and a column tag
+  count_t GetCount(size_t row, size_t column) const {
+    emp_assert(row < num_rows && column < num_columns);
+    return counts[row * num_columns + column];
+  }
+
+  // The proportion of bits that differ, as emp::HammingMetric computes it
+  double GetDistance(size_t row, size_t column) const {
+    return (double) GetCount(row, column) / NUM_BITS;
+  }
+
+  /**
+   * Input: The string to append to, and the world positions labeling the
+   * rows and columns.
+   *
+   * Output: None
+   *
+   * Purpose: Appends the matrix as CSV. There are only NUM_BITS + 1 possible
+   * distances, so each is formatted once.
+   */
+  void AppendCSV(std::string& out, const emp::vector<size_t>& row_labels, const emp::vector<size_t>& column_labels) const {
+    emp_assert(row_labels.size() == num_rows && column_labels.size() == num_columns);
+    emp::vector<std::string> formatted(NUM_BITS + 1);
+    for (size_t count = 0; count <= NUM_BITS; ++count) {
+      tagmatrix::AppendDistance(formatted[count], (double) count / NUM_BITS);
+    }
+    tagmatrix::AppendCSV(out, row_labels, column_labels, [this, &formatted](std::string& csv, size_t row, size_t column) {
+      csv += formatted[GetCount(row, column)];
+    });
+  }
+
+  /**
+   * Input: The string to append to, and the world positions labeling the
+   * rows and columns.
+   *
+   * Output: None
+   *
+   * Purpose: Appends the matrix in the binary layout, as mismatching bit
+   * counts.
+   */
+  void AppendBinary(std::string& out, const emp::vector<size_t>& row_labels, const emp::vector<size_t>& column_labels) const {
+    emp_assert(row_labels.size() == num_rows && column_labels.size() == num_columns);
+    tagmatrix::AppendBinary(out, tagmatrix::ValueKind::COUNTS, NUM_BITS, row_labels, column_labels,
+      [this](size_t row, size_t column) { return (uint64_t) GetCount(row, column); });
+  }
+};
+
+/*
+  Reads binary tag matrix files (TAG_MATRIX_FORMAT binary).
+*/
+class TagMatrixReader {
+public:
+  using ValueKind = tagmatrix::ValueKind;
+  using RowEncoding = tagmatrix::RowEncoding;
+
+protected:
+  ValueKind kind = ValueKind::COUNTS;
+  size_t tag_bits = 0;
+  emp::vector<size_t> row_labels;
+  emp::vector<size_t> column_labels;
+  emp::vector<uint64_t> values; // Row-major
+
+  bool DecodeRow(RowEncoding encoding, const char* pos, const char* end) {
+    const size_t row_end = values.size() + column_labels.size();
+    while (values.size() < row_end) {
+      uint64_t value = 0;
+      if (!columnar::GetVarint(pos, end, value)) return false;
+      uint64_t run = 1;
+      if (encoding == RowEncoding::RUNS &&
+          (!columnar::GetVarint(pos, end, run) || run == 0 || run > row_end - values.size())) {
+        return false;
+      }
+      values.insert(values.end(), run, value);
+    }
+    return pos == end;
+  }
+
+public:
+  /**
+   * Input: The file to read, and a string to hold an error message if it
+   * can't be read.
+   *
+   * Output: Whether the file was read.
+   *
+   * Purpose: Reads a whole binary tag matrix file.
+   */
+  bool Load(const std::string& filename, std::string& error) {
+    row_labels.clear();
+    column_labels.clear();
+    values.clear();
+    std::ifstream in_file(filename, std::ios::binary);
+    if (!in_file) {
+      error = "Unable to open tag matrix file: " + filename;
+      return false;
+    }
+    const std::string contents(
+      (std::istreambuf_iterator<char>(in_file)),
+      std::istreambuf_iterator<char>()
+    );
+    const std::string corrupt_error = "Not a tag matrix file, or truncated: " + filename;
+    const char* pos = contents.data();
+    const char* end = pos + contents.size();
+
+    if (contents.size() < sizeof(tagmatrix::MAGIC) + 1 ||
+        std::memcmp(pos, tagmatrix::MAGIC, sizeof(tagmatrix::MAGIC)) != 0) {
+      error = corrupt_error;
+      return false;
+    }
+    pos += sizeof(tagmatrix::MAGIC);
+    const uint8_t kind_byte = (uint8_t)*pos++;
+    if (kind_byte > (uint8_t)ValueKind::DISTANCES) {
+      error = corrupt_error;
+      return false;
+    }
+    kind = (ValueKind)kind_byte;
+
+    uint64_t bits = 0, num_rows = 0, num_columns = 0;
+    if (!columnar::GetVarint(pos, end, bits) || !columnar::GetVarint(pos, end, num_rows) ||
+        !columnar::GetVarint(pos, end, num_columns) || num_rows + num_columns > (uint64_t)(end - pos)) {
+      error = corrupt_error;
+      return false;
+    }
+    tag_bits = bits;
+    for (uint64_t i = 0; i < num_rows + num_columns; ++i) {
+      uint64_t label = 0;
+      if (!columnar::GetVarint(pos, end, label)) {
+        error = corrupt_error;
+        return false;
+      }
+      (i < num_rows ? row_labels : column_labels).push_back(label);
+    }
+
+    values.reserve(num_rows * num_columns);
+    for (uint64_t row = 0; row < num_rows; ++row) {
+      uint64_t size = 0;
+      if (pos == end || (uint8_t)*pos > (uint8_t)RowEncoding::RUNS) {
+        error = corrupt_error;
+        return false;
+      }
+      const RowEncoding encoding = (RowEncoding)*pos++;
+      if (!columnar::GetVarint(pos, end, size) || size > (uint64_t)(end - pos) ||
+          !DecodeRow(encoding, pos, pos + size)) {
+        error = corrupt_error;
+        return false;
+      }
+      pos += size;
+    }
+    if (pos != end) {
+      error = corrupt_error;
+      return false;
+    }
+    return true;
+  }
+
+  ValueKind GetValueKind() const { return kind; }
+  size_t GetTagBits() const { return tag_bits; }
+  size_t GetNumRows() const { return row_labels.size(); }
+  size_t GetNumColumns() const { return column_labels.size(); }
+  size_t GetRowLabel(size_t row) const { return row_labels[row]; }
+  size_t GetColumnLabel(size_t column) const { return column_labels[column]; }
+
+  double GetDistance(size_t row, size_t column) const {
+    emp_assert(row < GetNumRows() && column < GetNumColumns());
+    const uint64_t value = values[row * column_labels.size() + column];
+    if (kind == ValueKind::DISTANCES) return columnar::BitsDouble(value);
+    return (double) value / tag_bits;
+  }
+
+  /**
+   * Input: The stream to write to.
+   *
+   * Output: None
+   *
+   * Purpose: Writes the matrix as the CSV WriteTagMatrixFile would have.
+   */
+  void WriteCSV(std::ostream& out) const {
+    std::string contents;
+    tagmatrix::AppendCSV(contents, row_labels, column_labels, [this](std::string& csv, size_t row, size_t column) {
+      tagmatrix::AppendDistance(csv, GetDistance(row, column));
+    });
+    out << contents;
+  }
+};
+
+#endif
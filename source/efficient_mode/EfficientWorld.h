@@ -96,20 +96,11 @@ public:
   emp::DataMonitor<double>& GetEfficiencyDataNode() {
     if (!data_node_efficiency) {
       data_node_efficiency.New();
-      OnUpdate([this](size_t){
-        data_node_efficiency->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i)) {
-            emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-            size_t sym_size = syms.size();
-            for(size_t j=0; j< sym_size; j++){
-              data_node_efficiency->AddDatum(syms[j]->GetEfficiency());
-            }//close for
-          }//close if
-          if(sym_pop[i]) {
-            data_node_efficiency->AddDatum(sym_pop[i]->GetEfficiency());
-          }//close if
-      }//close for
+      size_t channel = stats_engine.AddChannel(*data_node_efficiency);
+      stats_engine.AddSymVisitor(channel, [channel](Organism&, Organism& sym, StatsEngine::Emitter& out){
+        out.Emit(channel, sym.GetEfficiency());
+      }, [channel](Organism& sym, StatsEngine::Emitter& out){
+        out.Emit(channel, sym.GetEfficiency());
       });
     }
     return *data_node_efficiency;
@@ -206,20 +206,11 @@ public:
   emp::DataMonitor<double,emp::data::Histogram>& GetLysisChanceDataNode() {
     if (!data_node_lysischance) {
       data_node_lysischance.New();
-      OnUpdate([this](size_t){
-        data_node_lysischance->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i)) {
-            emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-            long unsigned int sym_size = syms.size();
-            for(size_t j=0; j< sym_size; j++){
-              data_node_lysischance->AddDatum(syms[j]->GetLysisChance());
-            }//close for
-          }//close if
-          if (sym_pop[i]){
-            data_node_lysischance->AddDatum(sym_pop[i]->GetLysisChance());
-          }
-        }//close for
+      size_t channel = stats_engine.AddChannel(*data_node_lysischance);
+      stats_engine.AddSymVisitor(channel, [channel](Organism&, Organism& sym, StatsEngine::Emitter& out){
+        out.Emit(channel, sym.GetLysisChance());
+      }, [channel](Organism& sym, StatsEngine::Emitter& out){
+        out.Emit(channel, sym.GetLysisChance());
       });
     }
     data_node_lysischance->SetupBins(0, 1.1, 11);
@@ -271,20 +262,11 @@ public:
   emp::DataMonitor<double,emp::data::Histogram>& GetInductionChanceDataNode() {
     if (!data_node_inductionchance) {
       data_node_inductionchance.New();
-      OnUpdate([this](size_t){
-        data_node_inductionchance->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i)) {
-            emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-            long unsigned int sym_size = syms.size();
-            for(size_t j=0; j< sym_size; j++){
-              data_node_inductionchance->AddDatum(syms[j]->GetInductionChance());
-            }//close for
-          }//close if
-          if (sym_pop[i]){
-            data_node_inductionchance->AddDatum(sym_pop[i]->GetInductionChance());
-          }
-        }//close for
+      size_t channel = stats_engine.AddChannel(*data_node_inductionchance);
+      stats_engine.AddSymVisitor(channel, [channel](Organism&, Organism& sym, StatsEngine::Emitter& out){
+        out.Emit(channel, sym.GetInductionChance());
+      }, [channel](Organism& sym, StatsEngine::Emitter& out){
+        out.Emit(channel, sym.GetInductionChance());
       });
     }
     data_node_inductionchance->SetupBins(0, 1.1, 11);
@@ -303,20 +285,10 @@ public:
   emp::DataMonitor<double,emp::data::Histogram>& GetIncorporationDifferenceDataNode() {
     if (!data_node_incorporation_difference) {
       data_node_incorporation_difference.New();
-      OnUpdate([this](size_t){
-        data_node_incorporation_difference->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i)) {
-            double host_inc_val = pop[i]->GetIncVal();
-
-            emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-            long unsigned int sym_size = syms.size();
-            for(size_t j=0; j< sym_size; j++){
-              double inc_val_difference = abs(host_inc_val - syms[j]->GetIncVal());
-              data_node_incorporation_difference->AddDatum(inc_val_difference);
-            }
-          }//close if
-        }//close for
+      size_t channel = stats_engine.AddChannel(*data_node_incorporation_difference);
+      stats_engine.AddHostedSymVisitor(channel, [channel](Organism& host, Organism& sym, StatsEngine::Emitter& out){
+        double inc_val_difference = abs(host.GetIncVal() - sym.GetIncVal());
+        out.Emit(channel, inc_val_difference);
       });
     }
     data_node_incorporation_difference->SetupBins(0, 1.1, 11);
@@ -336,32 +308,27 @@ public:
     //keep track of host organisms that are uninfected or infected with only lysogenic phage
     if(!data_node_cfu) {
       data_node_cfu.New();
-      OnUpdate([this](size_t){
-        data_node_cfu -> Reset();
-
-        for (size_t i = 0; i < pop.size(); i++) {
-          if(IsOccupied(i)) {
-            //uninfected hosts
-            if((pop[i]->GetSymbionts()).empty()) {
-              data_node_cfu->AddDatum(1);
+      size_t channel = stats_engine.AddChannel(*data_node_cfu);
+      stats_engine.AddHostVisitor(channel, [channel](Organism& host, StatsEngine::Emitter& out){
+        //uninfected hosts
+        if((host.GetSymbionts()).empty()) {
+          out.Emit(channel, 1);
+        }
+
+        //infected hosts, check if all symbionts are lysogenic
+        if(host.HasSym()) {
+          emp::vector<emp::Ptr<Organism>>& syms = host.GetSymbionts();
+          bool all_lysogenic = true;
+          for(long unsigned int j = 0; j < syms.size(); j++){
+            if(syms[j]->IsPhage() && syms[j]->GetLysogeny() == false){
+              all_lysogenic = false;
             }
-
-            //infected hosts, check if all symbionts are lysogenic
-            if(pop[i]->HasSym()) {
-              emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-              bool all_lysogenic = true;
-              for(long unsigned int j = 0; j < syms.size(); j++){
-                if(syms[j]->IsPhage() && syms[j]->GetLysogeny() == false){
-                  all_lysogenic = false;
-                }
-              }
-              if(all_lysogenic){
-                data_node_cfu->AddDatum(1);
-              }
-            }
-          } //endif
-        } //end for
-      }); //end OnUpdate
+          }
+          if(all_lysogenic){
+            out.Emit(channel, 1);
+          }
+        }
+      });
     } //end if
     return *data_node_cfu;
   }
@@ -0,0 +1,37 @@
+// Converts columnar data files (DATA_FILE_FORMAT columnar) to CSV, matching
+// the text data files Symbulation writes by default.
+//
+// Usage: ./symbulation_columnar_to_csv <file.cols> [output.csv]
+//   - Writes to standard output if no output file is given.
+
+#include "../default_mode/ColumnarDataFile.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2 || argc > 3) {
+    std::cout << "Usage: " << argv[0] << " <file.cols> [output.csv]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ColumnarDataReader reader;
+  std::string error;
+  if (!reader.Load(argv[1], error)) {
+    std::cout << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (argc == 3) {
+    std::ofstream out_file(argv[2]);
+    if (!out_file) {
+      std::cout << "Unable to open output file: " << argv[2] << std::endl;
+      return EXIT_FAILURE;
+    }
+    reader.WriteCSV(out_file);
+  } else {
+    reader.WriteCSV(std::cout);
+  }
+  return 0;
+}
@@ -0,0 +1,54 @@
+// Rebuilds phylogeny snapshots from incremental phylogeny logs
+// (PHYLOGENY_LOG), as CSV.
+//
+// Usage: ./symbulation_phylogeny_log_to_csv <file.phylolog> [update [output.csv]]
+//   - Lists the logged snapshot updates if no update is given.
+//   - Otherwise writes the last snapshot at or before that update, to
+//     standard output if no output file is given. Each taxon has the logged
+//     columns, id, ancestor_list, origin_time, destruction_time, num_orgs,
+//     tot_orgs, num_offspring, and total_offspring, as of that snapshot.
+
+#include "../default_mode/PhylogenyLog.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2 || argc > 4) {
+    std::cout << "Usage: " << argv[0] << " <file.phylolog> [update [output.csv]]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  PhylogenyLogReader reader;
+  std::string error;
+  if (!reader.Load(argv[1], error)) {
+    std::cout << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (argc == 2) {
+    for (size_t snapshot = 0; snapshot < reader.GetNumSnapshots(); ++snapshot) {
+      std::cout << reader.GetSnapshotUpdate(snapshot) << std::endl;
+    }
+    return 0;
+  }
+
+  const size_t snapshot = reader.FindSnapshot(std::stoull(argv[2]));
+  if (snapshot == reader.GetNumSnapshots()) {
+    std::cout << "No snapshot at or before update " << argv[2] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (argc == 4) {
+    std::ofstream out_file(argv[3]);
+    if (!out_file) {
+      std::cout << "Unable to open output file: " << argv[3] << std::endl;
+      return EXIT_FAILURE;
+    }
+    reader.WriteSnapshotCSV(snapshot, out_file);
+  } else {
+    reader.WriteSnapshotCSV(snapshot, std::cout);
+  }
+  return 0;
+}
@@ -151,20 +151,11 @@ public:
   emp::DataMonitor<double, emp::data::Histogram>& GetPGGDataNode() {
     if (!data_node_PGG) {
       data_node_PGG.New();
-      OnUpdate([this](size_t){
-        data_node_PGG->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i)) { //track hosted syms
-            emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-            size_t sym_size = syms.size();
-            for(size_t j=0; j< sym_size; j++){
-              data_node_PGG->AddDatum(syms[j]->GetDonation());
-            }//close for
-          }//close if
-          if(sym_pop[i]){ //track free-living syms
-            data_node_PGG->AddDatum(sym_pop[i]->GetDonation());
-          }//close if
-        }//close for
+      size_t channel = stats_engine.AddChannel(*data_node_PGG);
+      stats_engine.AddSymVisitor(channel, [channel](Organism&, Organism& sym, StatsEngine::Emitter& out){
+        out.Emit(channel, sym.GetDonation());
+      }, [channel](Organism& sym, StatsEngine::Emitter& out){
+        out.Emit(channel, sym.GetDonation());
       });
     }
     data_node_PGG->SetupBins(0, 1.1, 11);
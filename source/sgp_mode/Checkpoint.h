@@ -0,0 +1,166 @@
+#pragma once
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/math/Random.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace sgpmode {
+
+// NOTE - emp::Random keeps all of its state in plain data members, so its
+//        state is saved and restored as raw bytes.
+using random_state_t = std::array<unsigned char, sizeof(emp::Random)>;
+
+inline random_state_t GetRandomState(const emp::Random& rnd) {
+  random_state_t state;
+  std::memcpy(state.data(), &rnd, sizeof(emp::Random));
+  return state;
+}
+
+inline void SetRandomState(emp::Random& rnd, const random_state_t& state) {
+  std::memcpy(reinterpret_cast<void*>(&rnd), state.data(), sizeof(emp::Random));
+}
+
+/*
+  Writes values to a binary checkpoint stream (see SGPWorld::SaveCheckpoint).
+  Values are written in native byte order; vectors and bit sets are prefixed by
+  their size.
+*/
+class CheckpointWriter {
+protected:
+  std::ostream& out;
+
+public:
+  CheckpointWriter(std::ostream& out_stream) : out(out_stream) { }
+
+  bool Ok() const { return (bool)out; }
+
+  template<typename T>
+  void Write(const T& val) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.write(reinterpret_cast<const char*>(&val), (std::streamsize)sizeof(T));
+  }
+
+  template<typename T>
+  void WriteVector(const emp::vector<T>& vec) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    Write<uint64_t>(vec.size());
+    out.write(reinterpret_cast<const char*>(vec.data()), (std::streamsize)(vec.size() * sizeof(T)));
+  }
+
+  // Works for emp::BitVector and emp::BitSet
+  template<typename BITS_T>
+  void WriteBits(const BITS_T& bits) {
+    const size_t num_bits = bits.GetSize();
+    Write<uint64_t>(num_bits);
+    for (size_t word_start = 0; word_start < num_bits; word_start += 64) {
+      uint64_t word = 0;
+      for (size_t i = word_start; i < num_bits && i < word_start + 64; ++i) {
+        if (bits.Get(i)) word |= uint64_t{1} << (i - word_start);
+      }
+      Write(word);
+    }
+  }
+
+  void WriteString(const std::string& str) {
+    Write<uint64_t>(str.size());
+    out.write(str.data(), (std::streamsize)str.size());
+  }
+};
+
+/*
+  Reads values written by a CheckpointWriter. Once a read fails (the stream
+  ends, or a size is larger than what is left to read), Ok() returns false and
+  every later read returns a default value.
+*/
+class CheckpointReader {
+protected:
+  std::istream& in;
+  size_t bytes_left;
+  bool failed = false;
+
+  bool Consume(size_t num_bytes) {
+    if (failed || num_bytes > bytes_left) {
+      failed = true;
+      return false;
+    }
+    bytes_left -= num_bytes;
+    return true;
+  }
+
+public:
+  // num_bytes is how much can be read from in (e.g., the file size).
+  CheckpointReader(std::istream& in_stream, size_t num_bytes) :
+    in(in_stream),
+    bytes_left(num_bytes)
+  { }
+
+  bool Ok() const { return !failed && (bool)in; }
+
+  // Mark the checkpoint as invalid (e.g., a value read is out of range).
+  void Fail() { failed = true; }
+
+  template<typename T>
+  T Read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T val{};
+    if (!Consume(sizeof(T))) return val;
+    in.read(reinterpret_cast<char*>(&val), (std::streamsize)sizeof(T));
+    if (!in) failed = true;
+    return val;
+  }
+
+  template<typename T>
+  void ReadVector(emp::vector<T>& vec) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const uint64_t size = Read<uint64_t>();
+    if (failed || size > bytes_left / sizeof(T) || !Consume(size * sizeof(T))) {
+      failed = true;
+      vec.clear();
+      return;
+    }
+    vec.resize(size);
+    in.read(reinterpret_cast<char*>(vec.data()), (std::streamsize)(size * sizeof(T)));
+    if (!in) failed = true;
+  }
+
+  // Works for emp::BitVector (resized to fit) and emp::BitSet (size must match)
+  template<typename BITS_T>
+  void ReadBits(BITS_T& bits) {
+    const uint64_t num_bits = Read<uint64_t>();
+    if (failed || (num_bits + 63) / 64 > bytes_left / sizeof(uint64_t)) {
+      failed = true;
+      return;
+    }
+    if constexpr (requires { bits.Resize(num_bits); }) {
+      bits.Resize(num_bits);
+    } else if (num_bits != bits.GetSize()) {
+      failed = true;
+      return;
+    }
+    for (size_t word_start = 0; word_start < num_bits; word_start += 64) {
+      const uint64_t word = Read<uint64_t>();
+      for (size_t i = word_start; i < num_bits && i < word_start + 64; ++i) {
+        bits.Set(i, (word >> (i - word_start)) & 1);
+      }
+    }
+  }
+
+  std::string ReadString() {
+    const uint64_t size = Read<uint64_t>();
+    if (!Consume(size)) return "";
+    std::string str(size, '\0');
+    in.read(str.data(), (std::streamsize)size);
+    if (!in) failed = true;
+    return str;
+  }
+};
+
+}
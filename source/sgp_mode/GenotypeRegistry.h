@@ -0,0 +1,231 @@
+#pragma once
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+namespace sgpmode {
+
+/*
+  Interns the programs of organisms in the world by content and tracks how
+  many living organisms carry each one.
+
+  Programs are interned by a 64-bit content hash when an organism is placed;
+  full programs are only compared when two programs share a hash. Each world
+  position remembers its genotype, so deaths never rehash or compare programs.
+  Genotypes are kept ordered by abundance, so the K most abundant genotypes
+  are available in O(K + log G) for G live genotypes.
+
+  The living members of each genotype form a linked list through their world
+  positions, so every live genotype can name a representative organism.
+
+  NOTE - An organism's genotype is the program it had when it was placed.
+         Programs edited in place afterwards are not re-interned.
+*/
+template<typename PROGRAM_T>
+class GenotypeRegistry {
+public:
+  using program_t = PROGRAM_T;
+  static constexpr size_t npos = (size_t)-1;
+
+  struct Genotype {
+    uint64_t hash = 0;
+    program_t program;
+    size_t count = 0;
+    size_t first_pos = npos; // Head of the list of positions with this genotype
+  };
+
+protected:
+  // Orders genotypes by count (largest first), then by id (oldest first)
+  struct RankLess {
+    bool operator()(
+      const std::pair<size_t, size_t>& a,
+      const std::pair<size_t, size_t>& b
+    ) const {
+      if (a.first != b.first) return a.first > b.first;
+      return a.second < b.second;
+    }
+  };
+
+  emp::vector<Genotype> genotypes;
+  emp::vector<size_t> free_ids;
+  std::unordered_multimap<uint64_t, size_t> ids_by_hash;
+  std::set<std::pair<size_t, size_t>, RankLess> ranking; // (count, genotype id)
+
+  // Per world position
+  emp::vector<size_t> pos_genotype;
+  emp::vector<size_t> pos_next;
+  emp::vector<size_t> pos_prev;
+
+  size_t num_orgs = 0;
+
+  size_t FindOrCreate(const program_t& program) {
+    const uint64_t hash = HashProgram(program);
+    auto [begin, end] = ids_by_hash.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+      if (genotypes[it->second].program == program) return it->second;
+    }
+    size_t id;
+    if (free_ids.size()) {
+      id = free_ids.back();
+      free_ids.pop_back();
+    } else {
+      id = genotypes.size();
+      genotypes.emplace_back();
+    }
+    Genotype& genotype = genotypes[id];
+    genotype.hash = hash;
+    genotype.program = program;
+    genotype.count = 0;
+    genotype.first_pos = npos;
+    ids_by_hash.emplace(hash, id);
+    return id;
+  }
+
+  void Release(size_t id) {
+    Genotype& genotype = genotypes[id];
+    auto [begin, end] = ids_by_hash.equal_range(genotype.hash);
+    for (auto it = begin; it != end; ++it) {
+      if (it->second == id) {
+        ids_by_hash.erase(it);
+        break;
+      }
+    }
+    genotype.program = program_t();
+    free_ids.push_back(id);
+  }
+
+  void SetCount(size_t id, size_t count) {
+    Genotype& genotype = genotypes[id];
+    if (genotype.count) ranking.erase({genotype.count, id});
+    genotype.count = count;
+    if (count) ranking.emplace(count, id);
+  }
+
+public:
+  /**
+   * Input: A program.
+   *
+   * Output: A 64-bit hash of the program's instructions.
+   *
+   * Purpose: To intern programs by content. Covers every field of every
+   * instruction (operation, arguments, and tag).
+   */
+  static uint64_t HashProgram(const program_t& program) {
+    uint64_t hash = 0xcbf29ce484222325ull ^ program.size();
+    auto mix = [&hash](uint64_t value) {
+      hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    };
+    for (const auto& inst : program) {
+      uint64_t op_and_args = inst.op_code;
+      for (const auto arg : inst.args) {
+        op_and_args = (op_and_args << 8) | (uint8_t)arg;
+      }
+      mix(op_and_args);
+      mix(std::hash<std::decay_t<decltype(inst.tag)>>{}(inst.tag));
+    }
+    // Final avalanche (splitmix64)
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ull;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebull;
+    hash ^= hash >> 31;
+    return hash;
+  }
+
+  /**
+   * Input: A world position and the program of the organism placed there.
+   *
+   * Output: The id of the organism's genotype.
+   *
+   * Purpose: To count a newly placed organism. Any organism already counted at
+   * that position is removed first.
+   */
+  size_t Add(size_t pos, const program_t& program) {
+    if (pos >= pos_genotype.size()) {
+      pos_genotype.resize(pos + 1, npos);
+      pos_next.resize(pos + 1, npos);
+      pos_prev.resize(pos + 1, npos);
+    }
+    Remove(pos);
+    const size_t id = FindOrCreate(program);
+    Genotype& genotype = genotypes[id];
+    pos_genotype[pos] = id;
+    pos_prev[pos] = npos;
+    pos_next[pos] = genotype.first_pos;
+    if (genotype.first_pos != npos) pos_prev[genotype.first_pos] = pos;
+    genotype.first_pos = pos;
+    SetCount(id, genotype.count + 1);
+    ++num_orgs;
+    return id;
+  }
+
+  /**
+   * Input: A world position.
+   *
+   * Output: None
+   *
+   * Purpose: To stop counting the organism at a position (e.g., when it dies).
+   * Does nothing if no organism is counted there.
+   */
+  void Remove(size_t pos) {
+    if (pos >= pos_genotype.size() || pos_genotype[pos] == npos) return;
+    const size_t id = pos_genotype[pos];
+    Genotype& genotype = genotypes[id];
+    if (pos_prev[pos] != npos) pos_next[pos_prev[pos]] = pos_next[pos];
+    else genotype.first_pos = pos_next[pos];
+    if (pos_next[pos] != npos) pos_prev[pos_next[pos]] = pos_prev[pos];
+    pos_genotype[pos] = npos;
+    pos_next[pos] = npos;
+    pos_prev[pos] = npos;
+    SetCount(id, genotype.count - 1);
+    if (genotype.count == 0) Release(id);
+    --num_orgs;
+  }
+
+  void Clear() {
+    genotypes.clear();
+    free_ids.clear();
+    ids_by_hash.clear();
+    ranking.clear();
+    pos_genotype.clear();
+    pos_next.clear();
+    pos_prev.clear();
+    num_orgs = 0;
+  }
+
+  /**
+   * Input: The maximum number of genotypes to return.
+   *
+   * Output: Ids of the (up to) k most abundant genotypes, most abundant first.
+   * Ties go to the genotype that was interned first.
+   *
+   * Purpose: To find dominant genotypes without scanning the population.
+   */
+  emp::vector<size_t> GetTopGenotypes(size_t k) const {
+    emp::vector<size_t> result;
+    for (auto it = ranking.begin(); it != ranking.end() && result.size() < k; ++it) {
+      result.push_back(it->second);
+    }
+    return result;
+  }
+
+  const Genotype& GetGenotype(size_t id) const {
+    emp_assert(id < genotypes.size());
+    return genotypes[id];
+  }
+
+  size_t GetGenotypeAt(size_t pos) const {
+    return (pos < pos_genotype.size()) ? pos_genotype[pos] : npos;
+  }
+
+  size_t GetNumGenotypes() const { return ranking.size(); }
+  size_t GetNumOrgs() const { return num_orgs; }
+};
+
+}
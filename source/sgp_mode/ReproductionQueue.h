@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Organism.h"
+#include "Scheduler.h"
 
 #include <deque>
 #include <functional>
@@ -25,40 +26,79 @@ struct ReproEvent {
 
 /*
   Tracks organisms queued for reproduction.
+
+  The queue is split into one shard per scheduler thread. During organism
+  processing, each thread only appends to its own shard, so no locking is
+  needed. Each thread processes a contiguous slice of the update's schedule,
+  so visiting shards in order (and events in enqueue order within a shard)
+  gives the same order as processing the whole schedule on one thread.
+
+  Queue positions (as stored by CPUState::MarkReproInProgress) encode both
+  the shard and the index within the shard: pos = (index * num_shards) + shard.
 */
 class ReproductionQueue {
 public:
   using fun_repro_org_t = std::function<void(ReproEvent&)>;
 protected:
-  // TODO - queue vector
-  emp::vector<ReproEvent> queue;
+  emp::vector<emp::vector<ReproEvent>> shards;
   fun_repro_org_t fun_reproduce_org;
   // TODO - set tracking what is in the queue
   // std::unordered_set in
   // TODO - next_id
   // size_t next_id = 0; // id to assign to next reproduction event (will be unique with respect to all other currently queued events)
 
+  size_t GetShardID(size_t queue_pos) const { return queue_pos % shards.size(); }
+  size_t GetShardIndex(size_t queue_pos) const { return queue_pos / shards.size(); }
+
 public:
+  ReproductionQueue() : shards(1) { }
 
   void Clear() {
-    queue.clear();
+    for (auto& shard : shards) {
+      shard.clear();
+    }
+  }
+
+  // Must match the number of threads that may enqueue concurrently.
+  // Queue must be empty when changing the number of shards.
+  void SetNumShards(size_t num_shards) {
+    emp_assert(num_shards > 0);
+    emp_assert(GetSize() == 0);
+    shards.resize(num_shards);
   }
 
+  size_t GetNumShards() const { return shards.size(); }
+
   size_t GetSize() const {
-    return queue.size();
+    size_t size = 0;
+    for (const auto& shard : shards) {
+      size += shard.size();
+    }
+    return size;
+  }
+
+  const emp::vector<ReproEvent>& GetQueue(size_t shard_id=0) const {
+    emp_assert(shard_id < shards.size());
+    return shards[shard_id];
   }
 
-  const emp::vector<ReproEvent>& GetQueue() const {
-    return queue;
+  const ReproEvent& GetEvent(size_t queue_pos) const {
+    emp_assert(GetShardIndex(queue_pos) < shards[GetShardID(queue_pos)].size());
+    return shards[GetShardID(queue_pos)][GetShardIndex(queue_pos)];
   }
 
   void SetReproduceOrgFun(fun_repro_org_t fun) {
     fun_reproduce_org = fun;
   }
 
+  // NOTE - Invalidating an event in another thread's shard while that thread
+  //        may be enqueuing is not safe. SGPWorld defers organism deletion until
+  //        all scheduler threads are done, so this only happens on one thread.
   void Invalidate(size_t queue_pos) {
-    emp_assert(queue_pos < queue.size());
-    queue[queue_pos].valid = false;
+    const size_t shard_id = GetShardID(queue_pos);
+    emp_assert(!Scheduler::InWorker() || shard_id == Scheduler::GetWorkerID());
+    emp_assert(GetShardIndex(queue_pos) < shards[shard_id].size());
+    shards[shard_id][GetShardIndex(queue_pos)].valid = false;
   }
 
   // Add organism to queue, return organism's queue id (valid until queue is processed)
@@ -66,8 +106,11 @@ public:
     emp::Ptr<Organism> org_ptr,
     const emp::WorldPosition& org_pos
   ) {
-    const size_t queue_id = queue.size();
-    queue.emplace_back(org_ptr, org_pos, true);
+    const size_t shard_id = Scheduler::GetWorkerID();
+    emp_assert(shard_id < shards.size());
+    auto& shard = shards[shard_id];
+    const size_t queue_id = (shard.size() * shards.size()) + shard_id;
+    shard.emplace_back(org_ptr, org_pos);
     return queue_id;
   }
 
@@ -79,22 +122,27 @@ public:
   // void Process(WORLD_T& world) {
 
   void Process() {
-    for (ReproEvent& repro_info : queue) {
-      emp::Ptr<Organism> org_ptr = repro_info.org;
-      // If queued organism is dead or repro event has been invalidated,
-      // don't reproduce.
-      if (!repro_info.valid || org_ptr->GetDead()) {
-        continue;
+    // Events are visited in place, so queue ids stay valid for any
+    // invalidation that happens while processing.
+    for (auto& shard : shards) {
+      for (size_t queue_id = 0; queue_id < shard.size(); ++queue_id) {
+        ReproEvent& repro_info = shard[queue_id];
+        emp::Ptr<Organism> org_ptr = repro_info.org;
+        // If queued organism is dead or repro event has been invalidated,
+        // don't reproduce.
+        if (!repro_info.valid || org_ptr->GetDead()) {
+          continue;
+        }
+        fun_reproduce_org(repro_info);
+        // emp::Ptr<Organism> child = org->Reproduce();
+        // (child->IsHost()) ?
+        //   world.HostDoBirth(child, org_ptr, repro_info.pos) :
+        //   world.SymDoBirth(child, repro_info.pos);
       }
-      fun_reproduce_org(repro_info);
-      // emp::Ptr<Organism> child = org->Reproduce();
-      // (child->IsHost()) ?
-      //   world.HostDoBirth(child, org_ptr, repro_info.pos) :
-      //   world.SymDoBirth(child, repro_info.pos);
     }
     Clear();
   }
 
 };
 
-}
\ No newline at end of file
+}
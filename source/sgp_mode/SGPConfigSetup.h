@@ -15,6 +15,8 @@ namespace sgpmode {
 EMP_EXTEND_CONFIG(SymConfigSGP, SymConfigBase,
   GROUP(SGP, "Complex Genomes Settings"),
   VALUE(CYCLES_PER_UPDATE, size_t, 4, "Number of CPU cycles that organisms run every update"),
+  VALUE(BATCH_CPU_EXEC, bool, 0, "1 if organisms should run their CPU cycles in batches when no instruction can interrupt execution (faster, but may interleave virtual cores differently), 0 to always run one cycle at a time"),
+  VALUE(THREAD_COUNT, size_t, 1, "Number of threads used to process organisms in parallel (results don't depend on the thread count)"),
   VALUE(FIND_NEIGHBOR_HOST_ATTEMPTS, size_t, 4, "How many times to attempt finding a neighboring host for symbiont to horizontally transmit into"),
   VALUE(DONATION_STEAL_INST, bool, true, "1 if you want donate and steal instructions in the instruction set, 0 if not"),
   VALUE(SYM_DONATE_PROP, double, 0.2, "Proportion of points for sym to donate to host on donate"),
@@ -65,6 +67,8 @@ EMP_EXTEND_CONFIG(SymConfigSGP, SymConfigBase,
   VALUE(TASK_ENV_CFG_PATH, std::string, "environment.json", "Json file that provides environment configuration"),
   VALUE(TASK_IO_BANK_SIZE, size_t, 100000, "How many possible task input/output combinations to pre-generate?"),
   VALUE(TASK_IO_UNIQUE_OUTPUT, bool, true, "Should each output in the pregenerated io combinations be unique?"),
+  VALUE(TASK_IO_BANK_LOAD_PATH, std::string, "", "Binary task io bank file to load instead of generating a bank (ignores TASK_IO_BANK_SIZE and TASK_IO_UNIQUE_OUTPUT). Leave empty to generate a bank."),
+  VALUE(TASK_IO_BANK_SAVE_PATH, std::string, "", "If set, save the generated task io bank to this binary file (for use with TASK_IO_BANK_LOAD_PATH)."),
   VALUE(HOST_ONLY_FIRST_TASK_CREDIT, bool, false, "Only give host credit for one task (whatever they do first)?"),
   VALUE(SYM_ONLY_FIRST_TASK_CREDIT, bool, false, "Only give sym credit for one task (whatever they do first)?"),
 
@@ -74,7 +78,12 @@ EMP_EXTEND_CONFIG(SymConfigSGP, SymConfigBase,
   VALUE(TEMP_CHANGING_ENVIRONMENT_ORG_TYPE, std::string, "static", "Can organisms sense task reward values? (plastic-both: both symbionts and hosts can sense whether tasks are rewarded; static: neither hosts nor symbiont can sense whether tasks are rewarded)"),
 
   GROUP(DATA, "Data settings"),
-  VALUE(PRINT_INTERVAL, size_t, 1, "How often to print run status")
+  VALUE(PRINT_INTERVAL, size_t, 1, "How often to print run status"),
+
+  GROUP(CHECKPOINT, "Checkpoint settings"),
+  VALUE(CHECKPOINT_INTERVAL, size_t, 0, "How many updates between writing checkpoint files (0 to never write checkpoints). Phylogenies aren't checkpointed, so this can't be used with PHYLOGENY on."),
+  VALUE(CHECKPOINT_PATH, std::string, "checkpoint.bin", "Binary checkpoint file to write every CHECKPOINT_INTERVAL updates (overwritten each time)"),
+  VALUE(RESTORE_CHECKPOINT_PATH, std::string, "", "Checkpoint file to restore the run from. Must be run with the same configuration (including SEED) as the run that wrote it; only output, UPDATES, THREAD_COUNT, and checkpoint settings may change. Can't be used with PHYLOGENY on. Leave empty to start a new run.")
 )
 
 }
@@ -2,6 +2,7 @@
 #define SGPHOST_H
 
 #include "../default_mode/Host.h"
+#include "Checkpoint.h"
 #include "hardware/SGPHardware.h"
 // #include "SGPWorld.h"
 
@@ -10,6 +11,7 @@
 
 #include "sgpl/utility/ThreadLocalRandom.hpp"
 
+#include <bit>
 #include <functional>
 
 
@@ -24,6 +26,8 @@ public:
   using hw_spec_t = HW_SPEC_T;
   using hw_t = SGPHardware<hw_spec_t>;
   using program_t = typename hw_t::program_t;
+  using shared_program_t = typename hw_t::shared_program_t;
+  using shared_genome_t = typename hw_t::SharedGenome;
 
 protected:
   // CPU cpu;
@@ -103,9 +107,28 @@ public:
     // sgp_config(_config)
   { }
 
+  /**
+   * Constructs an SGPHost that shares the provided (immutable) genome and
+   * its resolved jump table.
+   */
+  SGPHost(
+    emp::Ptr<emp::Random> _random,
+    emp::Ptr<world_t> _world,
+    emp::Ptr<SymConfigSGP> _config,
+    const shared_genome_t& genome,
+    double _intval = 0.0,                         /* Interaction value */
+    const emp::vector<emp::Ptr<Organism>>& _syms = {},
+    const emp::vector<emp::Ptr<Organism>>& _repro_syms = {},
+    double _points = 0.0
+  ) :
+    Host(_random, _world, _config, _intval, _syms, _repro_syms, _points),
+    hardware(_world, this, genome),
+    my_world(_world)
+  { }
+
   SGPHost(const SGPHost& host) :
     Host(host),
-    hardware(host.my_world, this, host.hardware.GetProgram()),
+    hardware(host.my_world, this, host.hardware.GetSharedGenome()),
     my_world(host.my_world)
   { }
 
@@ -215,7 +238,71 @@ public:
   const hw_t& GetHardware() const { return hardware; }
 
   const program_t& GetProgram() const { return hardware.GetProgram(); }
-  program_t& GetProgram() { return hardware.GetProgram(); }
+
+  /**
+   * Input: The checkpoint stream to write to.
+   *
+   * Output: None
+   *
+   * Purpose: Writes this host's state (phenotype and CPU) for a checkpoint.
+   * The program and endosymbionts are written by the world (see
+   * SGPWorld::SaveCheckpoint).
+   */
+  void WriteCheckpoint(CheckpointWriter& out) const {
+    emp_assert(repro_syms.empty());
+    out.Write(interaction_val);
+    out.Write<uint8_t>(dead);
+    out.Write<int64_t>(age);
+    out.Write<uint64_t>(Host::reproductions);
+    out.Write<uint64_t>(towards_partner_count);
+    out.Write<uint64_t>(from_partner_count);
+    out.Write(tag_permissiveness);
+    out.Write(points);
+    out.Write(res_in_process);
+    out.WriteBits(tag);
+    out.Write<uint64_t>(reproductions);
+    out.Write<uint64_t>(matching_syms_to_interact_with);
+    hardware.WriteCheckpoint(out);
+  }
+
+  /**
+   * Input: The checkpoint stream to read from.
+   *
+   * Output: Whether the host's state was read.
+   *
+   * Purpose: Restores state written by WriteCheckpoint on a host built with
+   * the same program.
+   */
+  bool ReadCheckpoint(CheckpointReader& in) {
+    interaction_val = in.Read<double>();
+    dead = in.Read<uint8_t>();
+    age = (int)in.Read<int64_t>();
+    Host::reproductions = in.Read<uint64_t>();
+    towards_partner_count = in.Read<uint64_t>();
+    from_partner_count = in.Read<uint64_t>();
+    tag_permissiveness = in.Read<double>();
+    points = in.Read<double>();
+    res_in_process = in.Read<double>();
+    in.ReadBits(tag);
+    reproductions = in.Read<uint64_t>();
+    matching_syms_to_interact_with = in.Read<uint64_t>();
+    if (!in.Ok()) return false;
+    return hardware.ReadCheckpoint(in);
+  }
+
+  /**
+   * Input: A symbiont restored from a checkpoint.
+   *
+   * Output: None
+   *
+   * Purpose: Puts the symbiont back into this host's next symbiont slot.
+   * Unlike AddSymbiont, this doesn't check whether the symbiont is allowed in
+   * or assign it new environment IO.
+   */
+  void RestoreSymbiont(emp::Ptr<Organism> sym) {
+    syms.push_back(sym);
+    sym->SetHost(this);
+  }
 
   /**
    * Input: None
@@ -303,22 +390,24 @@ public:
     // Execute organism hardware according to cycles_to_exec
     // NOTE - Discuss possibility of host dying because of instruction executions.
     //        As-is, still run hardware forward full amount regardless
-    for (size_t i = 0; i < cycles_to_exec; ++i) {
+    // Only need to step one cycle at a time if something responds to every step.
+    const bool per_step_sig = my_world->after_host_cpu_step_sig.GetNumActions() > 0;
+    size_t cycles_left = cycles_to_exec;
+    while (cycles_left > 0) {
       if (GetDead()) {
         return;
       }
       // TODO - do we need to update org location every update? (this was being done in RunCPUStep every cpu step)
-      // Execute 1 CPU cycle
-      GetHardware().RunCPUStep(1);
+      // Execute CPU cycles (stops early on reproduction attempt)
+      cycles_left -= GetHardware().RunCPUCycles(per_step_sig ? 1 : cycles_left);
       // Did host attempt to reproduce?
       // NOTE - could move into a signal response
-      // NOTE - want to handle this after every clock cycle?
       if (GetHardware().GetCPUState().ReproAttempt()) {
         // upside to handling this here: we have direct access to organism
         AttemptReproduction(pos);
       }
 
-      my_world->after_host_cpu_step_sig.Trigger(*this);
+      if (per_step_sig) my_world->after_host_cpu_step_sig.Trigger(*this);
       // NOTE - Check death here?
     }
     my_world->after_host_cpu_exec_sig.Trigger(*this);
@@ -358,7 +447,9 @@ public:
       emp_assert(sym_count > 0);
       // TODO - Check that it is okay to re-order symbionts to avoid erase calls
       // Symbiont is dead, need to delete it.
-      cur_symbiont.Delete();
+      // NOTE - Deletion goes through the world so that (when threaded) any
+      //        deferred writes referring to this symbiont are applied first.
+      my_world->DeferWrite([cur_symbiont]() mutable { cur_symbiont.Delete(); });
       // Swap this symbiont with last in list, decrementing sym_count
       std::swap(syms[sym_i], syms[--sym_count]);
       // We will need to process what we just swapped into place, so
@@ -385,7 +476,6 @@ public:
       // Host pays cost
       DecPoints(repro_cost);
       // Add host to repro queue
-      // TODO - protect with mutex?
       const size_t queue_id = my_world->GetReproQueue().Enqueue(
         GetHardware().GetCPUState().GetOrgPtr(),
         pos
@@ -416,13 +506,14 @@ public:
     auto& output_buffer = cpu_state.GetOutputBuffer();
     for (uint32_t val : output_buffer) {
       // Is this the correct output for any tasks?
-      if (task_io.IsValidOutput(val)) {
+      // (task mask has a bit set for each task this output is correct for)
+      auto task_mask = task_io.GetTaskMask(val);
+      if (task_mask) {
         // Yes, this output is correct.
-        // Get all task ids associated with this output value
-        const emp::vector<size_t>& task_ids = task_io.GetTaskIDs(val);
 
         // Give credit for completed tasks
-        for (size_t task_id : task_ids) {
+        for (; task_mask; task_mask &= (task_mask - 1)) {
+          const size_t task_id = (size_t)std::countr_zero(task_mask);
           // Is this a host task?
           if (!task_env.IsHostTask(task_id)) continue;
           // Not first task
@@ -432,7 +523,8 @@ public:
           }
           
         // Has this organism already gotten credit with this output on this task?
-        if (cpu_state.OutputCredited(task_id, val)) continue;
+        const size_t output_slot = task_io.GetOutputSlot(task_id, val);
+        if (cpu_state.OutputCredited(task_id, output_slot)) continue;
         // Check task requirements
         auto& task_req_info = task_env.GetHostTaskReq(task_id);
         if (!my_world->CanPerformTask(cpu_state, task_req_info)) {
@@ -443,10 +535,10 @@ public:
         //   (1) Mark task as being performed
         cpu_state.MarkTaskPerformed(task_id);
         //   (2) Credit output
-        cpu_state.CreditOutputValue(task_id, val);
+        cpu_state.CreditOutput(task_id, output_slot);
         //   (3) Clear output credits if outputs credited >= number of pre-computed outputs
         //       for this task in the task io bank.
-        if (cpu_state.GetOutputsCredited(task_id).size() >= task_io.GetNumTaskOutputs(task_id)) {
+        if (cpu_state.GetNumOutputsCredited(task_id) >= task_io.GetNumTaskOutputs(task_id)) {
           cpu_state.ResetCreditedOutputs(task_id);
         }
         // Calc value, add to organism points
@@ -461,7 +553,9 @@ public:
 
         //World handles giving host points and adjusting that amount based on if any points are removed or by symbionts
         my_world->ApplyHostPoints(*this, task_points,task_id);
-        my_world->GetHostTaskSuccesses()[task_id] += 1;
+        my_world->DeferWrite([world = my_world, task_id]() {
+          world->GetHostTaskSuccesses()[task_id] += 1;
+        });
 
       }
     }
@@ -566,7 +660,7 @@ public:
       random,
       my_world,
       my_world->GetConfigPtr(),
-      GetProgram(),
+      hardware.GetSharedGenome(),
       GetIntVal()
     );
   }
@@ -584,14 +678,20 @@ public:
     // NOTE - could also move this into the SGPMutator, which would allow us
     //        to deviate from what happens in the base class mutate functions
     Host::Mutate();
+    // Keep the pre-mutation program so the hardware can tell whether the
+    // mutated instructions changed control flow. Mutation replaces (rather
+    // than edits) the shared program, so this does not copy it.
+    const shared_program_t old_program = hardware.GetSharedProgram();
     // Apply SGP-specific mutations (managed by world)
-    my_world->HostDoMutation(*this);
+    const emp::vector<size_t>& mutated_insts = my_world->HostDoMutation(*this);
     // TODO - Switch from HostDoMutation() to:
     //   -> my_world->GetHostMutator().DoMutation(*this);
     // TODO - move Hardware Reset to makenew, keep initializeState (need to reset jumptable)
     // Reset host's hardware
-    hardware.Reset(); // NOTE - this function was previously just Initializing state,
-                      // which didn't reset the cpu. I think we want to reset the CPU here also?
+    // New offspring were initialized from the parent's program on construction,
+    // so this only rebuilds what the mutation invalidated. Organisms mutated
+    // during their lifetime get a full reset.
+    hardware.ResetAfterMutation(*old_program, mutated_insts);
   }
 
 
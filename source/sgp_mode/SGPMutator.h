@@ -2,22 +2,124 @@
 
 #include "sgpl/program/Program.hpp"
 #include "sgpl/library/OpLibrary.hpp"
+#include "sgpl/utility/ThreadLocalRandom.hpp"
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <tuple>
 
 namespace sgpmode {
 
 // NOTE - We can set this up to be configurable (e.g., support different modes,
 //        ability to "layer on" different mutaiton types).
-//        For now, it just replicates functionality of previous mutator
-template<typename PROGRAM_T, typename INST_LIBRARY_T>
+/*
+  Applies per-bit point mutations to programs.
+
+  Each bit of each instruction (operation, arguments, and tag) flips
+  independently with probability per_bit_mut_rate. Instead of drawing for
+  every bit, the gaps between flipped bits are drawn from a geometric
+  distribution, so the cost is proportional to the number of mutations rather
+  than to the number of bits in the program. Only instructions that were
+  touched are rectified (disabled operations remapped, arguments wrapped to
+  valid registers).
+
+  After a mutation, GetMutatedInsts() lists the indices (in increasing order)
+  of the instructions that changed, so callers can update anything derived
+  from the program (e.g., jump tables) incrementally.
+*/
+template<typename PROGRAM_T, typename INST_LIBRARY_T, size_t NUM_REGISTERS>
 class SGPMutator {
 public:
   using program_t = PROGRAM_T;
+  using inst_t = typename program_t::value_type;
   using lib_t = INST_LIBRARY_T;
   using rectifier_t = sgpl::OpCodeRectifier<lib_t>;
 
 protected:
+  // Mutable bits in an instruction: operation, then each argument, then tag.
+  static constexpr size_t OP_BITS = 8;
+  static constexpr size_t ARG_BITS = 8 * sizeof(inst_t{}.args[0]);
+  static constexpr size_t NUM_ARGS = std::tuple_size_v<decltype(inst_t{}.args)>;
+  static constexpr size_t TAG_BITS = decltype(inst_t{}.tag)::GetSize();
+  static constexpr size_t INST_BITS = OP_BITS + (NUM_ARGS * ARG_BITS) + TAG_BITS;
+
   double per_bit_mut_rate = 0.0;
+  double log_no_mut = 0.0; // log(1 - per_bit_mut_rate)
   rectifier_t& prog_rectifier;
+
+  // Per thread, as organisms may reproduce on scheduler threads.
+  static emp::vector<size_t>& MutatedInsts() {
+    thread_local emp::vector<size_t> mutated_insts;
+    return mutated_insts;
+  }
+
+  static emp::vector<size_t>& FlippedBits() {
+    thread_local emp::vector<size_t> flipped_bits;
+    return flipped_bits;
+  }
+
+  // Fills FlippedBits() with the (increasing) positions of the bits to flip in
+  // a program with num_bits bits.
+  void DrawFlippedBits(size_t num_bits) {
+    auto& flipped_bits = FlippedBits();
+    flipped_bits.clear();
+    if (per_bit_mut_rate <= 0.0 || num_bits == 0) return;
+    if (per_bit_mut_rate >= 1.0) {
+      for (size_t bit = 0; bit < num_bits; ++bit) flipped_bits.push_back(bit);
+      return;
+    }
+    emp::Random& rand = sgpl::tlrand.Get();
+    double bit = -1.0;
+    while (true) {
+      // Number of unflipped bits before the next flipped bit ~ Geometric(p)
+      const double uniform = 1.0 - rand.GetDouble(); // (0, 1]
+      bit += 1.0 + std::floor(std::log(uniform) / log_no_mut);
+      if (bit >= (double)num_bits) break;
+      flipped_bits.push_back((size_t)bit);
+    }
+  }
+
+  static void FlipBit(inst_t& inst, size_t bit) {
+    if (bit < OP_BITS) {
+      inst.op_code ^= (1u << bit);
+      return;
+    }
+    bit -= OP_BITS;
+    if (bit < NUM_ARGS * ARG_BITS) {
+      inst.args[bit / ARG_BITS] ^= (1u << (bit % ARG_BITS));
+      return;
+    }
+    inst.tag.Toggle(bit - (NUM_ARGS * ARG_BITS));
+  }
+
+  void RectifyInst(inst_t& inst) const {
+    inst.op_code = prog_rectifier.mapper[inst.op_code];
+    for (auto& arg : inst.args) arg %= NUM_REGISTERS;
+  }
+
+  static bool SameInst(const inst_t& a, const inst_t& b) {
+    return a.op_code == b.op_code && a.args == b.args && a.tag == b.tag;
+  }
+
+  // Applies FlippedBits() to program and fills MutatedInsts() with the
+  // instructions that ended up different.
+  void ApplyFlippedBits(program_t& program) {
+    auto& mutated_insts = MutatedInsts();
+    const auto& flipped_bits = FlippedBits();
+    size_t i = 0;
+    while (i < flipped_bits.size()) {
+      const size_t inst_id = flipped_bits[i] / INST_BITS;
+      inst_t& inst = program[inst_id];
+      const inst_t original = inst;
+      for (; i < flipped_bits.size() && flipped_bits[i] / INST_BITS == inst_id; ++i) {
+        FlipBit(inst, flipped_bits[i] % INST_BITS);
+      }
+      RectifyInst(inst);
+      if (!SameInst(inst, original)) mutated_insts.push_back(inst_id);
+    }
+  }
+
 public:
   SGPMutator(
     rectifier_t& opcode_rectifier
@@ -25,22 +127,56 @@ public:
 
   void SetPerBitMutationRate(double rate) {
     per_bit_mut_rate = rate;
+    log_no_mut = (rate > 0.0 && rate < 1.0) ? std::log1p(-rate) : 0.0;
   }
 
-  void MutateProgram(program_t& program) {
-    /*
-      ApplyMutations for sgplite:
-        - Calculate number of mutations:
-          - Poisson(program size in bytes * 8, bit_mut_rate)
-        - Flips random bits in underlying program data, fix any broken opcodes that happen as a result
-    */
-    program.ApplyPointMutations(
-      per_bit_mut_rate,
-      prog_rectifier
-    );
+  double GetPerBitMutationRate() const { return per_bit_mut_rate; }
+
+  /**
+   * Input: None
+   *
+   * Output: The indices (in increasing order) of the instructions changed by
+   * the last MutateProgram call on this thread.
+   *
+   * Purpose: To let callers update program-derived state incrementally.
+   */
+  const emp::vector<size_t>& GetMutatedInsts() const { return MutatedInsts(); }
+
+  /**
+   * Input: A program to mutate in place.
+   *
+   * Output: The indices of the instructions that changed (see GetMutatedInsts).
+   *
+   * Purpose: Applies point mutations to the program.
+   */
+  const emp::vector<size_t>& MutateProgram(program_t& program) {
+    MutatedInsts().clear();
+    DrawFlippedBits(program.size() * INST_BITS);
+    if (FlippedBits().empty()) return MutatedInsts();
+    ApplyFlippedBits(program);
+    return MutatedInsts();
   }
 
+  /**
+   * Input: A shared (immutable) program.
+   *
+   * Output: The indices of the instructions that changed (see GetMutatedInsts).
+   *
+   * Purpose: Copy-on-write version of MutateProgram. Mutation sites are drawn
+   * before anything is copied, and the shared program is only replaced (with
+   * a mutated copy) if an instruction actually changed, so unmutated offspring
+   * keep sharing their parent's program.
+   */
+  const emp::vector<size_t>& MutateProgram(std::shared_ptr<const program_t>& program) {
+    MutatedInsts().clear();
+    DrawFlippedBits(program->size() * INST_BITS);
+    if (FlippedBits().empty()) return MutatedInsts();
+    auto mutated = std::make_shared<program_t>(*program);
+    ApplyFlippedBits(*mutated);
+    if (MutatedInsts().size()) program = std::move(mutated);
+    return MutatedInsts();
+  }
 
 };
 
-}
\ No newline at end of file
+}
@@ -18,6 +18,8 @@ public:
   using hw_spec_t = HW_SPEC_T;
   using hw_t = SGPHardware<hw_spec_t>;
   using program_t = typename hw_t::program_t;
+  using shared_program_t = typename hw_t::shared_program_t;
+  using shared_genome_t = typename hw_t::SharedGenome;
   using host_t = SGPHost<HW_SPEC_T>;
 
 protected:
@@ -83,9 +85,26 @@ public:
     // sgp_config = _config;
   }
 
+  /**
+   * Constructs an SGPSymbiont that shares the provided (immutable) genome and
+   * its resolved jump table.
+   */
+  SGPSymbiont(
+    emp::Ptr<emp::Random> _random,
+    emp::Ptr<world_t> _world,
+    emp::Ptr<SymConfigSGP> _config,
+    const shared_genome_t& genome,
+    double _intval = 0.0, /* Interaction value */
+    double _points = 0.0
+  ) :
+    Symbiont(_random, _world, _config, _intval, _points),
+    hardware(_world, this, genome),
+    my_world(_world)
+  { }
+
   SGPSymbiont(const SGPSymbiont& symbiont) :
     Symbiont(symbiont),
-    hardware(symbiont.my_world, this, symbiont.hardware.GetProgram()),
+    hardware(symbiont.my_world, this, symbiont.hardware.GetSharedGenome()),
     my_world(symbiont.my_world)
   { }
 
@@ -173,7 +192,57 @@ public:
   const hw_t& GetHardware() const { return hardware; }
 
   const program_t& GetProgram() const { return hardware.GetProgram(); }
-  program_t& GetProgram() { return hardware.GetProgram(); }
+
+  /**
+   * Input: The checkpoint stream to write to.
+   *
+   * Output: None
+   *
+   * Purpose: Writes this symbiont's state (phenotype, location, and CPU) for a
+   * checkpoint. The program is written by the world (see
+   * SGPWorld::SaveCheckpoint).
+   */
+  void WriteCheckpoint(CheckpointWriter& out) const {
+    out.Write(interaction_val);
+    out.Write<uint8_t>(dead);
+    out.Write(points);
+    out.Write(infection_chance);
+    out.Write<int64_t>(age);
+    out.Write<uint64_t>(Symbiont::reproductions);
+    out.Write<uint64_t>(towards_partner_count);
+    out.Write<uint64_t>(from_partner_count);
+    out.WriteBits(tag);
+    out.Write<uint64_t>(location.GetIndex());
+    out.Write<uint64_t>(location.GetPopID());
+    out.Write<uint64_t>(reproductions);
+    hardware.WriteCheckpoint(out);
+  }
+
+  /**
+   * Input: The checkpoint stream to read from.
+   *
+   * Output: Whether the symbiont's state was read.
+   *
+   * Purpose: Restores state written by WriteCheckpoint on a symbiont built
+   * with the same program.
+   */
+  bool ReadCheckpoint(CheckpointReader& in) {
+    interaction_val = in.Read<double>();
+    dead = in.Read<uint8_t>();
+    points = in.Read<double>();
+    infection_chance = in.Read<double>();
+    age = (int)in.Read<int64_t>();
+    Symbiont::reproductions = in.Read<uint64_t>();
+    towards_partner_count = in.Read<uint64_t>();
+    from_partner_count = in.Read<uint64_t>();
+    in.ReadBits(tag);
+    const size_t loc_index = in.Read<uint64_t>();
+    const size_t loc_pop_id = in.Read<uint64_t>();
+    location = emp::WorldPosition(loc_index, loc_pop_id);
+    reproductions = in.Read<uint64_t>();
+    if (!in.Ok()) return false;
+    return hardware.ReadCheckpoint(in);
+  }
 
 
   /**
@@ -218,12 +287,15 @@ public:
     // Cash in cycles for this update
     // NOTE - Do we want to drain cpu cycles here (i.e., get cashed in for execution?)
     const size_t cycles_to_exec = GetHardware().GetCPUState().ExtractCPUCycles();
-    for (size_t i = 0; i < cycles_to_exec; ++i) {
-      GetHardware().RunCPUStep(1);
-      if(my_host) my_world->TriggerAfterEndosymCPUStepSig(pos, *this, my_host);
+    // Only need to step one cycle at a time if something responds to every step.
+    const bool per_step_sig = my_host && my_world->after_endosym_cpu_step_sig.GetNumActions() > 0;
+    size_t cycles_left = cycles_to_exec;
+    while (cycles_left > 0) {
+      // Execute CPU cycles (stops early on reproduction attempt)
+      cycles_left -= GetHardware().RunCPUCycles(per_step_sig ? 1 : cycles_left);
+      if (per_step_sig) my_world->TriggerAfterEndosymCPUStepSig(pos, *this, my_host);
 
       // Did endosymbiont attempt to reproduce?
-      // NOTE - want to handle this after every clock cycle?
       if (GetHardware().GetCPUState().ReproAttempt()) {
         AttemptIndependentReproduction(pos);
       }
@@ -310,11 +382,18 @@ public:
    emp_assert(my_host.DynamicCast<host_t>(), "SGPSymbiont must have an SGPHost host");
    //AEV notes to self:
    // the issue with aligning with default mode is that the method HorizontalTransmission is broken up into separate stages in sgp mode, so there is simply no way to call the super Horizontal Transmission because instructions make it necessary to break up that functionality into separate stages. We could reduce code duplication
-    if (Symbiont::AttemptIndependentReproduction(sym_pos)) {
+    // NOTE - Mirrors Symbiont::AttemptIndependentReproduction, except that the
+    //        attempt data tracking is handed to the world (which may defer it if
+    //        this symbiont is being processed on a scheduler thread).
+    if (my_config->HORIZ_TRANS() && MeetsIndependentReproRequirements()) {
+      const double int_val = GetIntVal();
+      my_world->DeferWrite([world = my_world, int_val]() {
+        world->GetHorizontalTransmissionAttemptCount().AddDatum(int_val);
+      });
+      if(!my_config->TAG_MATCHING() && !my_config->FREE_HT_FAILURE()) SetPoints(0);
       // Sym pays cost
       //DecPoints(repro_cost); //Need to check if changing this in default breaks everything, currently set to 0 in super class method
       // Add sym to repro queue
-      // TODO - protect with mutex for threading
         const size_t queue_id = my_world->GetReproQueue().Enqueue(
           GetHardware().GetCPUState().GetOrgPtr(),
           sym_pos
@@ -414,7 +493,7 @@ public:
       random,
       my_world,
       my_world->GetConfigPtr(),
-      GetProgram(),
+      hardware.GetSharedGenome(),
       GetIntVal()
     );
   }
@@ -432,11 +511,17 @@ public:
     // NOTE - could also move this into the SGPMutator, which would allow us
     //        to deviate from what happens in the base class mutate functions
     Symbiont::Mutate();
+    // Keep the pre-mutation program so the hardware can tell whether the
+    // mutated instructions changed control flow. Mutation replaces (rather
+    // than edits) the shared program, so this does not copy it.
+    const shared_program_t old_program = hardware.GetSharedProgram();
     // Apply SGP-specific mutations (managed by world)
-    my_world->SymDoMutation(*this);
+    const emp::vector<size_t>& mutated_insts = my_world->SymDoMutation(*this);
     // Reset host's hardware
-    hardware.Reset(); // NOTE - this function was previously just Initializing state,
-                      // which didn't reset the cpu. I think we want to reset the CPU here also?
+    // New offspring were initialized from the parent's program on construction,
+    // so this only rebuilds what the mutation invalidated. Organisms mutated
+    // during their lifetime get a full reset.
+    hardware.ResetAfterMutation(*old_program, mutated_insts);
   }
 
 };
@@ -80,7 +80,7 @@ void SGPWorld::SetupHealthInteractions() {
         // If symbiont is dead or doesn't have a host, skip.
         if (sym.GetDead()) { return; }
         // Will sym donate?
-        bool interact = random_ptr->P(sgp_config.HEALTH_INTERACTION_CHANCE());
+        bool interact = GetProcessRandom().P(sgp_config.HEALTH_INTERACTION_CHANCE());
 
         const auto& host_task_profile = fun_get_host_task_profile(host);
         const auto& sym_task_profile = fun_get_sym_task_profile(sym);
@@ -124,7 +124,7 @@ void SGPWorld::SetupHealthInteractions() {
         if (sym.GetDead()) { return; }
         auto& host_state = host.GetHardware().GetCPUState();
         // Will sym steal?
-        bool interact = random_ptr->P(sgp_config.HEALTH_INTERACTION_CHANCE());
+        bool interact = GetProcessRandom().P(sgp_config.HEALTH_INTERACTION_CHANCE());
         const auto& host_task_profile = fun_get_host_task_profile(host);
         const auto& sym_task_profile = fun_get_sym_task_profile(sym);
         interact = interact && fun_task_profile_compatibility_check(host_task_profile, sym_task_profile);
@@ -164,7 +164,7 @@ void SGPWorld::SetupHealthInteractions() {
         if (sym.GetDead()) { return; }
         auto& host_state = host.GetHardware().GetCPUState();
         // Will host and symbiont interact?
-        bool interact = random_ptr->P(sgp_config.HEALTH_INTERACTION_CHANCE());
+        bool interact = GetProcessRandom().P(sgp_config.HEALTH_INTERACTION_CHANCE());
         const auto& host_task_profile = fun_get_host_task_profile(host);
         const auto& sym_task_profile = fun_get_sym_task_profile(sym);
         interact = interact && fun_task_profile_compatibility_check(host_task_profile, sym_task_profile);
@@ -262,7 +262,7 @@ void SGPWorld::SetupStressInteractions() {
           sgp_config.MUTUALIST_DEATH_CHANCE() :
           sgp_config.BASE_DEATH_CHANCE();
         // Kill host with chosen probability
-        if (random_ptr->P(death_chance)) {
+        if (GetProcessRandom().P(death_chance)) {
           host.SetDead();
         }
       }
@@ -289,21 +289,18 @@ void SGPWorld::SetupStressInteractions() {
               // Endosymbiont gets opportunity to horizontally transmit
               // By using this queue, offspring of parasites avoid getting into hosts that will die to the
               // current stress event.
-              for (size_t i = 0; i < sgp_config.PARASITE_NUM_OFFSPRING_ON_STRESS_INTERACTION(); ++i) {
-                emp::Ptr<Organism> sym_offspring = endosym_ptr->Reproduce();
-                symbiont_stress_escapees.emplace_back(
-                  static_cast<sgp_sym_t*>(sym_offspring.Raw()),
-                  endosym_task_profile,
-                  endosym_ptr->GetHardware().GetCPUState().GetLocation().GetPopID()
-                );
-              }
+              DeferWrite(
+                [this, endosym_ptr, endosym_task_profile = emp::BitVector(endosym_task_profile)]() {
+                  AddStressEscapees(endosym_ptr, endosym_task_profile);
+                }
+              );
               // Once we leave this signal, the host (and this symbiont) will
               // potentially be deleted.
               // So, we need to handle the reproduction here (versus putting it into the queue).
             }
           }
           // Kill host with chosen probability
-          if (random_ptr->P(death_chance)) {
+          if (GetProcessRandom().P(death_chance)) {
             host.SetDead();
           }
         }
@@ -330,7 +327,7 @@ void SGPWorld::SetupStressInteractions() {
             }
           }
           // Kill host with chosen probability + allow escapees.
-          if (random_ptr->P(death_chance)) {
+          if (GetProcessRandom().P(death_chance)) {
             // ------
             // Give any escapees a chance to escape!
             // Once we leave this signal, the host (and this symbiont) will
@@ -339,14 +336,11 @@ void SGPWorld::SetupStressInteractions() {
             for (size_t escapee_id : escapee_ids) {
               emp::Ptr<sgp_sym_t> endosym_ptr = static_cast<sgp_sym_t*>(endosymbionts[escapee_id].Raw());
               const emp::BitVector& endosym_task_profile = fun_get_sym_task_profile(*endosym_ptr);
-              for (size_t i = 0; i < sgp_config.PARASITE_NUM_OFFSPRING_ON_STRESS_INTERACTION(); ++i) {
-                emp::Ptr<Organism> sym_offspring = endosym_ptr->Reproduce();
-                symbiont_stress_escapees.emplace_back(
-                  static_cast<sgp_sym_t*>(sym_offspring.Raw()),
-                  endosym_task_profile,
-                  endosym_ptr->GetHardware().GetCPUState().GetLocation().GetPopID()
-                );
-              }
+              DeferWrite(
+                [this, endosym_ptr, endosym_task_profile = emp::BitVector(endosym_task_profile)]() {
+                  AddStressEscapees(endosym_ptr, endosym_task_profile);
+                }
+              );
             }
             // ------
             // Mark host as dead
@@ -414,7 +408,7 @@ void SGPWorld::SetupStressInteractions() {
         } // Otherwise, interaction value == 0.0, no interaction (neutral).
 
         // Kill host with chosen probability + allow any parasite escapees out
-        if (random_ptr->P(death_chance)) {
+        if (GetProcessRandom().P(death_chance)) {
           // ------
           // Give any escapees a chance to escape!
           // Once we leave this signal, the host (and this symbiont) will
@@ -423,14 +417,11 @@ void SGPWorld::SetupStressInteractions() {
           for (size_t escapee_id : escapee_ids) {
             emp::Ptr<sgp_sym_t> endosym_ptr = static_cast<sgp_sym_t*>(endosymbionts[escapee_id].Raw());
             const emp::BitVector& endosym_task_profile = fun_get_sym_task_profile(*endosym_ptr);
-            for (size_t i = 0; i < sgp_config.PARASITE_NUM_OFFSPRING_ON_STRESS_INTERACTION(); ++i) {
-              emp::Ptr<Organism> sym_offspring = endosym_ptr->Reproduce();
-              symbiont_stress_escapees.emplace_back(
-                static_cast<sgp_sym_t*>(sym_offspring.Raw()),
-                endosym_task_profile,
-                endosym_ptr->GetHardware().GetCPUState().GetLocation().GetPopID()
-              );
-            }
+            DeferWrite(
+              [this, endosym_ptr, endosym_task_profile = emp::BitVector(endosym_task_profile)]() {
+                AddStressEscapees(endosym_ptr, endosym_task_profile);
+              }
+            );
           }
           host.SetDead();
         }
@@ -445,7 +436,7 @@ void SGPWorld::SetupStressInteractions() {
         // Otherwise, base death chance.
         const double death_chance = sgp_config.BASE_DEATH_CHANCE();
         // Kill host with chosen probability
-        if (random_ptr->P(death_chance)) {
+        if (GetProcessRandom().P(death_chance)) {
           host.SetDead();
         }
       }
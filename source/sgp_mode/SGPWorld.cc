@@ -6,6 +6,12 @@
 #include "SGPSymbiont.h"
 #include "utils.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace sgpmode {
 
 // TODO - Make clear that this will process host and free-living symbiont
@@ -52,7 +58,7 @@ void SGPWorld::ProcessHostAt(const emp::WorldPosition& pos, sgp_host_t& host) {
 
   //check if host is dead at return
   if (host.GetDead()){
-    DoDeath(pos);
+    DeferWrite([this, pos]() { DoDeath(pos); });
   }
 
 }
@@ -66,9 +72,18 @@ void SGPWorld::ProcessFreeLivingSymAt(const emp::WorldPosition& pos, sgp_sym_t&
   // if (my_host == nullptr && my_world->GetUpdate() % sgp_config->LIMITED_TASK_RESET_INTERVAL() == 0)
   //   cpu.state.used_resources->reset();
   emp_assert(!sym.IsHost()); // NOTE - IsSym function?
+  const size_t pop_id = pos.GetPopID();
+  // Removing a free-living sym modifies shared world state (e.g., org counts),
+  // so it goes through DeferWrite. Check that the sym is still there and dead
+  // when the removal is actually applied.
+  auto do_sym_death = [this, pop_id]() {
+    if (IsSymPopOccupied(pop_id) && GetSymAt(pop_id)->GetDead()) {
+      DoSymDeath(pop_id);
+    }
+  };
   // have to check for death first, because it might have moved
   if (sym.GetDead()) {
-    DoSymDeath(pos.GetPopID());
+    DeferWrite(do_sym_death);
   } else {
     // Sym gains cpu cycles
     sym.GetHardware().GetCPUState().GainCPUCycles(sgp_config.CYCLES_PER_UPDATE());
@@ -76,15 +91,19 @@ void SGPWorld::ProcessFreeLivingSymAt(const emp::WorldPosition& pos, sgp_sym_t&
     before_freeliving_sym_process_sig.Trigger(sym);
     // NOTE - Do we want to drain cpu cycles here (i.e., get cashed in for execution?)
     const size_t cycles_to_exec = sym.GetHardware().GetCPUState().ExtractCPUCycles();
-    for (size_t i = 0; i < cycles_to_exec; ++i) {
-      sym.GetHardware().RunCPUStep(1);
+    // Only need to step one cycle at a time if something responds to every step.
+    const bool per_step_sig = after_freeliving_sym_cpu_step_sig.GetNumActions() > 0;
+    size_t cycles_left = cycles_to_exec;
+    while (cycles_left > 0) {
+      // Execute CPU cycles (stops early on reproduction attempt or infection)
+      cycles_left -= sym.GetHardware().RunCPUCycles(per_step_sig ? 1 : cycles_left);
 
       // Did this sym attempt to reproduce?
       if (sym.GetHardware().GetCPUState().ReproAttempt()) {
         FreeLivingSymAttemptRepro(pos, sym);
       }
 
-      after_freeliving_sym_cpu_step_sig.Trigger(sym);
+      if (per_step_sig) after_freeliving_sym_cpu_step_sig.Trigger(sym);
     }
     after_freeliving_sym_cpu_exec_sig.Trigger(sym);
     // Call symbiont's process function
@@ -92,8 +111,8 @@ void SGPWorld::ProcessFreeLivingSymAt(const emp::WorldPosition& pos, sgp_sym_t&
     after_freeliving_sym_process_sig.Trigger(sym);
   }
   // TODO - double check that this belongs just here and not also in endosymbiont code
-  if (IsSymPopOccupied(pos.GetPopID()) && sym.GetDead()) {
-    DoSymDeath(pos.GetPopID());
+  if (IsSymPopOccupied(pop_id) && sym.GetDead()) {
+    DeferWrite(do_sym_death);
   }
 }
  
@@ -111,7 +130,6 @@ void SGPWorld::FreeLivingSymAttemptRepro(
     // Sym pays cost
     sym.DecPoints(repro_cost);
     // Add sym to repro queue
-    // TODO - protect with mutex for threading
     const size_t queue_id = repro_queue.Enqueue(
       sym.GetHardware().GetCPUState().GetOrgPtr(),
       pos
@@ -272,6 +290,31 @@ void SGPWorld::ProcessStressEscapees() {
   // TODO - add data collection for successful escapes
 }
 
+void SGPWorld::AddStressEscapees(
+  emp::Ptr<sgp_sym_t> endosym_ptr,
+  const emp::BitVector& endosym_task_profile
+) {
+  for (size_t i = 0; i < sgp_config.PARASITE_NUM_OFFSPRING_ON_STRESS_INTERACTION(); ++i) {
+    emp::Ptr<Organism> sym_offspring = endosym_ptr->Reproduce();
+    symbiont_stress_escapees.emplace_back(
+      static_cast<sgp_sym_t*>(sym_offspring.Raw()),
+      endosym_task_profile,
+      endosym_ptr->GetHardware().GetCPUState().GetLocation().GetPopID()
+    );
+  }
+}
+
+void SGPWorld::ApplyDeferredWrites() {
+  // Each thread processed a contiguous slice of the schedule, so applying
+  // thread buffers in order reproduces the order of a single-threaded update.
+  for (auto& thread_writes : deferred_writes) {
+    for (auto& write : thread_writes) {
+      write();
+    }
+    thread_writes.clear();
+  }
+}
+
 void SGPWorld::ProcessGraveyard() {
   // clean up the graveyard
   for (size_t i = 0; i < graveyard.size(); ++i) {
@@ -314,19 +357,21 @@ void SGPWorld::ProcessSymOutputBuffer(sgp_sym_t& sym) {
   auto& output_buffer = cpu_state.GetOutputBuffer();
   for (uint32_t val : output_buffer) {
     // Is this the correct output for any tasks?
-    if (task_io.IsValidOutput(val)) {
+    // (task mask has a bit set for each task this output is correct for)
+    auto task_mask = task_io.GetTaskMask(val);
+    if (task_mask) {
       // Yes, this output is correct.
-      // Get all task ids associated with this output value
-      const emp::vector<size_t>& task_ids = task_io.GetTaskIDs(val);
       // Give credit for completed tasks
-      for (size_t task_id : task_ids) {
+      for (; task_mask; task_mask &= (task_mask - 1)) {
+        const size_t task_id = (size_t)std::countr_zero(task_mask);
         // Is this a valid sym task?
         if (!task_env.IsSymTask(task_id)) continue;
         // Not first task
         const bool not_first_task = sgp_config.SYM_ONLY_FIRST_TASK_CREDIT() && cpu_state.GetFirstTaskPerformed().Any() && !cpu_state.GetFirstTaskPerformed().Get(task_id);
         if (not_first_task) continue;
         // Has this organism already gotten credit with this output on this task?
-        if (cpu_state.OutputCredited(task_id, val)) continue;
+        const size_t output_slot = task_io.GetOutputSlot(task_id, val);
+        if (cpu_state.OutputCredited(task_id, output_slot)) continue;
         // Check task requirements
         auto& task_req_info = task_env.GetSymTaskReq(task_id);
         if (!CanPerformTask(cpu_state, task_req_info)) {
@@ -336,14 +381,14 @@ void SGPWorld::ProcessSymOutputBuffer(sgp_sym_t& sym) {
         //   (1) Mark task as being performed
         cpu_state.MarkTaskPerformed(task_id);
         //   (2) Credit output
-        cpu_state.CreditOutputValue(task_id, val);
+        cpu_state.CreditOutput(task_id, output_slot);
         //   (3) Clear output credits if outputs credited >= number of pre-computed outputs
         //       for this task in the task io bank.
-        if (cpu_state.GetOutputsCredited(task_id).size() >= task_io.GetNumTaskOutputs(task_id)) {
+        if (cpu_state.GetNumOutputsCredited(task_id) >= task_io.GetNumTaskOutputs(task_id)) {
           cpu_state.ResetCreditedOutputs(task_id);
         }
         // Track success
-        ++sym_task_successes[task_id];
+        DeferWrite([this, task_id]() { ++sym_task_successes[task_id]; });
 
         // Calc base task value based on task environment, task requirements, and
         // symbiont's current point value.
@@ -376,12 +421,12 @@ void SGPWorld::ProcessSymOutputBuffer(sgp_sym_t& sym) {
   output_buffer.clear();
 }
 
-void SGPWorld::HostDoMutation(sgp_host_t& host) {
-  mutator.MutateProgram(host.GetProgram());
+const emp::vector<size_t>& SGPWorld::HostDoMutation(sgp_host_t& host) {
+  return mutator.MutateProgram(host.GetHardware().GetSharedProgram());
 }
 
-void SGPWorld::SymDoMutation(sgp_sym_t& sym) {
-  mutator.MutateProgram(sym.GetProgram());
+const emp::vector<size_t>& SGPWorld::SymDoMutation(sgp_sym_t& sym) {
+  return mutator.MutateProgram(sym.GetHardware().GetSharedProgram());
 }
 
 void SGPWorld::SymDonateToHost(Organism& from_sym, Organism& to_host) {
@@ -401,7 +446,9 @@ void SGPWorld::SymDonateToHost(Organism& from_sym, Organism& to_host) {
     sym_points,
     (sym_points + host.GetPoints()) * sgp_config.SYM_DONATE_PROP()
   );
-  // TODO - Protect for threaded implementation
+  // NOTE - Donation only touches this symbiont and its own host, which are always
+  //        processed on the same scheduler thread, so no deferral is needed.
+  //        Any data tracking added here should go through DeferWrite.
   // TODO - setup data tracking
   // state.world->GetSymDonatedDataNode().WithMonitor(
   //   [=](auto &m) { m.AddDatum(to_donate); });
@@ -437,6 +484,29 @@ void SGPWorld::FreeLivingSymDoInfect(Organism& sym) {
   emp_assert(sgp_config.SYM_LIMIT() >= 0);
   // NOTE - Could add some runtime customizability here if we want. E.g., functors, etc.
   sgp_sym_t& sgp_sym = static_cast<sgp_sym_t&>(sym);
+  if (!Scheduler::InWorker()) {
+    DoFreeLivingSymInfect(sgp_sym);
+    return;
+  }
+  // Infection moves the symbiont between the free-living population and a host
+  // (shared state), so while organisms are being processed it is deferred
+  // until all threads finish. By then, the symbiont may have died.
+  emp::Ptr<Organism> sym_ptr = sgp_sym.GetHardware().GetCPUState().GetOrgPtr();
+  const size_t pop_index = sgp_sym.GetHardware().GetCPUState().GetLocation().GetPopID();
+  DeferWrite([this, sym_ptr, pop_index]() {
+    if (!IsSymPopOccupied(pop_index) || GetSymAt(pop_index) != sym_ptr) return;
+    sgp_sym_t& deferred_sym = static_cast<sgp_sym_t&>(*sym_ptr);
+    if (deferred_sym.GetDead()) return;
+    DoFreeLivingSymInfect(deferred_sym);
+    // Failed infections kill the symbiont, which would otherwise be cleaned up
+    // at the end of ProcessFreeLivingSymAt.
+    if (IsSymPopOccupied(pop_index) && deferred_sym.GetDead()) {
+      DoSymDeath(pop_index);
+    }
+  });
+}
+
+void SGPWorld::DoFreeLivingSymInfect(sgp_sym_t& sgp_sym) {
   // Get sym's location in emp::World pop
   const size_t pop_index = sgp_sym.GetHardware().GetCPUState().GetLocation().GetPopID();
   // Check that there's an available host
@@ -466,6 +536,304 @@ void SGPWorld::FreeLivingSymDoInfect(Organism& sym) {
   }
 }
 
+uint64_t SGPWorld::GetIOBankHash() const {
+  const task_io_bank_t& io_bank = task_env.GetIOBank();
+  // FNV-1a over every environment's inputs
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t env_id = 0; env_id < io_bank.GetSize(); ++env_id) {
+    for (const auto input : io_bank.GetIO(env_id).input_buffer) {
+      hash = (hash ^ (uint64_t)input) * 1099511628211ULL;
+    }
+  }
+  return hash;
+}
+
+emp::vector<std::pair<std::string, std::string>> SGPWorld::GetCheckpointSettings() const {
+  // Results don't depend on THREAD_COUNT, and the task IO bank is checked by
+  // the header instead
+  static const std::unordered_set<std::string> unchecked_settings = {
+    "THREAD_COUNT", "UPDATES", "DATA_INT", "PRINT_INTERVAL", "FILE_PATH",
+    "FILE_NAME", "DATA_FILE_FORMAT", "ASYNC_OUTPUT", "OUTPUT_QUEUE_SIZE",
+    "STATS_THREADS", "WRITE_ORG_DUMP_FILE", "DOMINANT_COUNT", "TAG_MATRIX_FORMAT",
+    "TASK_IO_BANK_LOAD_PATH", "TASK_IO_BANK_SAVE_PATH",
+    "CHECKPOINT_INTERVAL", "CHECKPOINT_PATH", "RESTORE_CHECKPOINT_PATH"
+  };
+  emp::vector<std::pair<std::string, std::string>> settings;
+  for (const auto& entry : sgp_config) {
+    if (unchecked_settings.count(entry.first)) continue;
+    settings.emplace_back(entry.first, emp::to_string(entry.second->GetValue()));
+  }
+  return settings;
+}
+
+bool SGPWorld::SaveCheckpoint(const std::string& filepath) {
+  if (sgp_config.PHYLOGENY()) return false;
+  emp_assert(repro_queue.GetSize() == 0, "Checkpoints must be taken between updates");
+  const size_t num_tasks = task_env.GetTaskCount();
+
+  CheckpointHeader header{};
+  std::copy(std::begin(CHECKPOINT_MAGIC), std::end(CHECKPOINT_MAGIC), header.magic);
+  header.version = CHECKPOINT_VERSION;
+  header.random_state_size = sizeof(emp::Random);
+  header.update = GetUpdate();
+  header.world_size = GetSize();
+  header.num_tasks = num_tasks;
+  header.io_bank_size = task_env.GetIOBank().GetSize();
+  header.io_bank_hash = GetIOBankHash();
+
+  // Task values can change during a run (e.g., in changing environments).
+  emp::vector<double> host_task_values;
+  emp::vector<double> sym_task_values;
+  for (size_t task_id = 0; task_id < num_tasks; ++task_id) {
+    if (task_env.IsHostTask(task_id)) {
+      host_task_values.emplace_back(task_env.GetHostTaskReq(task_id).task_value);
+    }
+    if (task_env.IsSymTask(task_id)) {
+      sym_task_values.emplace_back(task_env.GetSymTaskReq(task_id).task_value);
+    }
+  }
+
+  const std::string tmp_filepath = filepath + ".tmp";
+  {
+    std::ofstream out_file(tmp_filepath, std::ios::binary | std::ios::trunc);
+    if (!out_file) return false;
+    CheckpointWriter out(out_file);
+
+    out.Write(header);
+    const auto settings = GetCheckpointSettings();
+    out.Write<uint64_t>(settings.size());
+    for (const auto& [name, value] : settings) {
+      out.WriteString(name);
+      out.WriteString(value);
+    }
+    out.Write(GetRandomState(GetRandom()));
+    out.Write(GetRandomState(sgpl::tlrand.Get()));
+    out.WriteVector(scheduler.GetCurSchedule());
+    out.WriteVector(host_task_values);
+    out.WriteVector(sym_task_values);
+    out.Write<int64_t>(total_res);
+
+    // Ids of programs already written
+    std::unordered_map<const sgp_prog_t*, uint64_t> program_ids;
+    auto write_program = [&out, &program_ids](const sgp_hw_t& hw) {
+      const sgp_prog_t* program = hw.GetSharedProgram().get();
+      const auto [it, is_new] = program_ids.try_emplace(program, program_ids.size());
+      out.Write<uint64_t>(it->second);
+      if (!is_new) return;
+      out.Write<uint64_t>(program->size());
+      for (const auto& inst : *program) {
+        out.Write<uint8_t>(inst.op_code);
+        out.Write(inst.args);
+        out.WriteBits(inst.tag);
+      }
+    };
+    auto write_sym = [&out, &write_program](emp::Ptr<Organism> org) {
+      const sgp_sym_t& sym = static_cast<const sgp_sym_t&>(*org);
+      write_program(sym.GetHardware());
+      sym.WriteCheckpoint(out);
+    };
+
+    for (size_t pos = 0; pos < GetSize(); ++pos) {
+      out.Write<uint8_t>(IsOccupied(pos));
+      if (IsOccupied(pos)) {
+        sgp_host_t& host = static_cast<sgp_host_t&>(*pop[pos]);
+        write_program(host.GetHardware());
+        host.WriteCheckpoint(out);
+        const emp::vector<emp::Ptr<Organism>>& syms = host.GetSymbionts();
+        out.Write<uint64_t>(syms.size());
+        for (emp::Ptr<Organism> sym : syms) {
+          write_sym(sym);
+        }
+      }
+      out.Write<uint8_t>(IsSymPopOccupied(pos));
+      if (IsSymPopOccupied(pos)) {
+        write_sym(sym_pop[pos]);
+      }
+    }
+    out.Write(CHECKPOINT_MAGIC);
+    out_file.flush();
+    if (!out.Ok()) return false;
+  }
+
+  std::error_code rename_error;
+  std::filesystem::rename(tmp_filepath, filepath, rename_error);
+  return !rename_error;
+}
+
+bool SGPWorld::LoadCheckpoint(const std::string& filepath, std::string& error) {
+  using genome_t = typename sgp_hw_t::SharedGenome;
+  using inst_t = typename sgp_hw_t::inst_t;
+
+  if (sgp_config.PHYLOGENY()) {
+    error = "Checkpoints can't be restored in runs with PHYLOGENY on.";
+    return false;
+  }
+  std::ifstream in_file(filepath, std::ios::binary | std::ios::ate);
+  if (!in_file) {
+    error = "Unable to open checkpoint file: " + filepath;
+    return false;
+  }
+  const size_t file_size = (size_t)in_file.tellg();
+  in_file.seekg(0);
+  CheckpointReader in(in_file, file_size);
+  const std::string corrupt_error = "Checkpoint file is truncated or corrupt: " + filepath;
+
+  const CheckpointHeader header = in.Read<CheckpointHeader>();
+  if (
+    !in.Ok() ||
+    !std::equal(std::begin(CHECKPOINT_MAGIC), std::end(CHECKPOINT_MAGIC), header.magic) ||
+    header.version != CHECKPOINT_VERSION
+  ) {
+    error = "Not a checkpoint file (or written by an unsupported version): " + filepath;
+    return false;
+  }
+  const size_t num_settings = in.Read<uint64_t>();
+  std::unordered_map<std::string, std::string> saved_settings;
+  for (size_t setting_i = 0; setting_i < num_settings && in.Ok(); ++setting_i) {
+    const std::string name = in.ReadString();
+    saved_settings[name] = in.ReadString();
+  }
+  if (!in.Ok()) {
+    error = corrupt_error;
+    return false;
+  }
+  for (const auto& [name, value] : GetCheckpointSettings()) {
+    const auto saved = saved_settings.find(name);
+    if (saved == saved_settings.end() || saved->second != value) {
+      const std::string saved_value = (saved == saved_settings.end()) ? "unset" : saved->second;
+      error = "Checkpoint file was written by a run with a different configuration (" + name +
+        " is " + saved_value + " in the checkpoint, but " + value + " in this run): " + filepath;
+      return false;
+    }
+  }
+  if (
+    header.random_state_size != sizeof(emp::Random) ||
+    header.world_size != GetSize() ||
+    header.num_tasks != task_env.GetTaskCount() ||
+    header.io_bank_size != task_env.GetIOBank().GetSize() ||
+    header.io_bank_hash != GetIOBankHash()
+  ) {
+    error = "Checkpoint file was written by a run with a different configuration: " + filepath;
+    return false;
+  }
+
+  // World state is read up front but applied last, since rebuilding the
+  // population draws random numbers.
+  const random_state_t world_random_state = in.Read<random_state_t>();
+  const random_state_t main_random_state = in.Read<random_state_t>();
+  emp::vector<size_t> schedule;
+  in.ReadVector(schedule);
+  emp::vector<double> host_task_values;
+  in.ReadVector(host_task_values);
+  emp::vector<double> sym_task_values;
+  in.ReadVector(sym_task_values);
+  const int64_t saved_total_res = in.Read<int64_t>();
+  size_t num_host_tasks = 0;
+  size_t num_sym_tasks = 0;
+  for (size_t task_id = 0; task_id < task_env.GetTaskCount(); ++task_id) {
+    num_host_tasks += task_env.IsHostTask(task_id);
+    num_sym_tasks += task_env.IsSymTask(task_id);
+  }
+  if (
+    !in.Ok() ||
+    host_task_values.size() != num_host_tasks ||
+    sym_task_values.size() != num_sym_tasks ||
+    !scheduler.SetSchedule(schedule)
+  ) {
+    error = corrupt_error;
+    return false;
+  }
+
+  // Replace the current population
+  for (size_t pos = 0; pos < GetSize(); ++pos) {
+    if (IsOccupied(pos)) DoDeath(pos);
+    if (IsSymPopOccupied(pos)) DoSymDeath(pos);
+  }
+  ProcessGraveyard();
+
+  // Genomes read so far, indexed by program id. Once an organism is built
+  // from a genome, the entry is replaced with the organism's genome so that
+  // later organisms also share its jump table.
+  emp::vector<genome_t> genomes;
+  // Returns the program id for the next organism record (reading the program
+  // if this is its first use).
+  auto read_program = [&in, &genomes]() -> size_t {
+    const size_t program_id = in.Read<uint64_t>();
+    if (!in.Ok() || program_id > genomes.size()) {
+      in.Fail();
+      return 0;
+    }
+    if (program_id < genomes.size()) return program_id;
+    const size_t program_size = in.Read<uint64_t>();
+    sgp_prog_t program;
+    for (size_t inst_i = 0; inst_i < program_size && in.Ok(); ++inst_i) {
+      inst_t inst;
+      inst.op_code = in.Read<uint8_t>();
+      inst.args = in.Read<decltype(inst.args)>();
+      in.ReadBits(inst.tag);
+      if (inst.op_code >= Library::GetSize()) in.Fail();
+      for (const auto arg : inst.args) {
+        if ((size_t)arg >= hw_spec_t::num_registers) in.Fail();
+      }
+      program.emplace_back(inst);
+    }
+    genomes.push_back({std::make_shared<const sgp_prog_t>(std::move(program)), nullptr});
+    return program_id;
+  };
+  auto new_sym = [this, &in, &genomes, &read_program]() -> emp::Ptr<sgp_sym_t> {
+    const size_t program_id = read_program();
+    if (!in.Ok()) return nullptr;
+    emp::Ptr<sgp_sym_t> sym = emp::NewPtr<sgp_sym_t>(random_ptr, this, &sgp_config, genomes[program_id]);
+    genomes[program_id] = sym->GetHardware().GetSharedGenome();
+    return sym;
+  };
+
+  for (size_t pos = 0; pos < GetSize() && in.Ok(); ++pos) {
+    if (in.Read<uint8_t>()) {
+      const size_t program_id = read_program();
+      if (!in.Ok()) break;
+      emp::Ptr<sgp_host_t> host = emp::NewPtr<sgp_host_t>(random_ptr, this, &sgp_config, genomes[program_id]);
+      genomes[program_id] = host->GetHardware().GetSharedGenome();
+      AddOrgAt(host, {pos});
+      host->ReadCheckpoint(in);
+      const size_t num_syms = in.Read<uint64_t>();
+      for (size_t sym_i = 0; sym_i < num_syms && in.Ok(); ++sym_i) {
+        emp::Ptr<sgp_sym_t> sym = new_sym();
+        if (!sym) break;
+        host->RestoreSymbiont(sym);
+        sym->ReadCheckpoint(in);
+      }
+    }
+    if (in.Read<uint8_t>()) {
+      emp::Ptr<sgp_sym_t> sym = new_sym();
+      if (!sym) break;
+      AddOrgAt(sym, emp::WorldPosition(0, pos));
+      sym->ReadCheckpoint(in);
+    }
+  }
+  const auto end_magic = in.Read<std::array<char, sizeof(CHECKPOINT_MAGIC)>>();
+  if (!in.Ok() || !std::equal(end_magic.begin(), end_magic.end(), std::begin(CHECKPOINT_MAGIC))) {
+    error = corrupt_error;
+    return false;
+  }
+
+  SetRandomState(GetRandom(), world_random_state);
+  SetRandomState(sgpl::tlrand.Get(), main_random_state);
+  size_t host_task_i = 0;
+  size_t sym_task_i = 0;
+  for (size_t task_id = 0; task_id < task_env.GetTaskCount(); ++task_id) {
+    if (task_env.IsHostTask(task_id)) {
+      task_env.GetHostTaskReq(task_id).task_value = host_task_values[host_task_i++];
+    }
+    if (task_env.IsSymTask(task_id)) {
+      task_env.GetSymTaskReq(task_id).task_value = sym_task_values[sym_task_i++];
+    }
+  }
+  total_res = (int)saved_total_res;
+  update = header.update;
+  return true;
+}
+
 }
 
-#endif
\ No newline at end of file
+#endif
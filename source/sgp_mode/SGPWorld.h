@@ -2,6 +2,7 @@
 #define SGPWORLD_H
 
 #include "../default_mode/SymWorld.h"
+#include "Checkpoint.h"
 #include "Scheduler.h"
 #include "SGPConfigSetup.h"
 #include "SGPHost.h"
@@ -10,6 +11,7 @@
 #include "ReproductionQueue.h"
 #include "ProgramBuilder.h"
 #include "SGPMutator.h"
+#include "GenotypeRegistry.h"
 #include "tasks/LogicTaskEnvironment.h"
 #include "hardware/SGPHardwareSpec.h"
 #include "hardware/GenomeLibrary.h"
@@ -19,6 +21,8 @@
 #include "emp/data/DataNode.hpp"
 #include "emp/math/Random.hpp"
 
+#include "sgpl/utility/ThreadLocalRandom.hpp"
+
 #include <functional>
 #include <filesystem>
 
@@ -47,7 +51,7 @@ public:
   using task_reqs_t = typename task_env_t::TaskReqInfo;
   using task_io_bank_t = typename task_env_t::io_bank_t;
   using task_io_t = typename task_io_bank_t::TaskIO;
-  using mutator_t = SGPMutator<sgp_prog_t, Library>;
+  using mutator_t = SGPMutator<sgp_prog_t, Library, hw_spec_t::num_registers>;
   using sgp_prog_rectifier_t = sgpl::OpCodeRectifier<Library>;
 
   using fun_sym_do_birth_t = std::function<emp::WorldPosition(
@@ -273,6 +277,7 @@ public:
   // after_host_cpu_step_sig - Triggers in ProcessHostAt()
   //  Triggers after each CPU cycle (potentially multiple times per update) and after
   //  handling a repro attempt by the host for that CPU cycle.
+  //  Hosts only run their CPU one cycle at a time if actions are attached.
   emp::Signal<void(
     sgp_host_t&
   )> after_host_cpu_step_sig;
@@ -301,6 +306,7 @@ public:
 
   // after_freeliving_sym_cpu_step_sig - Triggers in ProcessFreeLivingSymAt()
   //  Triggers after each CPU cycle after handling an instruction-triggered repro attempt.
+  //  Free-living symbionts only run their CPU one cycle at a time if actions are attached.
   emp::Signal<void(
     sgp_sym_t&  /* sym */
   )> after_freeliving_sym_cpu_step_sig;
@@ -335,6 +341,7 @@ public:
   )> after_endosym_process_sig;
 
   // after_endosym_cpu_step_sig - Triggers during ProcessEndoSymbiont()
+  //  Endosymbionts only run their CPU one cycle at a time if actions are attached.
   emp::Signal<void(
     const emp::WorldPosition&, /* sym_pos */
     sgp_sym_t&,                /* sym */
@@ -386,13 +393,55 @@ protected:
   sgp_prog_rectifier_t opcode_rectifier; // Used to "disable" instructions at runtime based on run configuration
   ProgramBuilder<hw_spec_t> prog_builder = ProgramBuilder<hw_spec_t>(opcode_rectifier); // Utility for building signalgp programs
   mutator_t mutator = mutator_t(opcode_rectifier);  // Handles mutating sgp programs
+  GenotypeRegistry<sgp_prog_t> host_genotypes; // Counts living hosts by program
+  emp::vector<size_t> dominant_genotype_ids; // Filled before writing the dominant genotypes file
 
   emp::vector<StressEscapee> symbiont_stress_escapees;
   emp::vector<size_t> escapee_ids; // Used to randomize order of processing escapees (to avoid biasing)
 
+  // Writes to shared world state requested while organisms are being processed
+  // (one list per scheduler thread). Applied in thread order after all threads
+  // finish, which matches the order of the update's schedule.
+  emp::vector<emp::vector<std::function<void()>>> deferred_writes;
+
   // Flag for whether setup has been run.
   bool setup = false;
 
+  // Binary checkpoint file layout (see SaveCheckpoint). All values are stored
+  // in native byte order.
+  //   - CheckpointHeader
+  //   - The config settings of the run (see GetCheckpointSettings), as a
+  //     count followed by name and value strings
+  //   - World state: random number generator states (world and main thread),
+  //     schedule order, task values, and total resources
+  //   - One record per world location: the host there (if any) followed by
+  //     its endosymbionts, then the free-living symbiont there (if any)
+  //   - CHECKPOINT_MAGIC again, to mark a complete checkpoint
+  // Each organism record starts with its program id. The first record to use
+  // a program writes it in full; later records (e.g., clones) only refer back
+  // to it, so restored clones share their program again.
+  struct CheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t random_state_size; // sizeof(emp::Random)
+    uint64_t update;
+    uint64_t world_size;
+    uint64_t num_tasks;
+    uint64_t io_bank_size;
+    uint64_t io_bank_hash;      // See GetIOBankHash
+  };
+  static constexpr char CHECKPOINT_MAGIC[8] = {'S', 'Y', 'M', 'S', 'G', 'P', 'C', 'K'};
+  static constexpr uint32_t CHECKPOINT_VERSION = 3;
+
+  // Hash of the task IO bank's inputs, to check that a checkpoint is restored
+  // into a world with the same IO bank (organisms refer to it by index).
+  uint64_t GetIOBankHash() const;
+
+  // Names and values of the config settings a checkpoint must be restored
+  // with. Settings that only affect output, run length, or checkpointing are
+  // left out, so they can change when a run is continued.
+  emp::vector<std::pair<std::string, std::string>> GetCheckpointSettings() const;
+
   emp::Ptr<emp::DataMonitor<double>> data_node_sym_donated;
   emp::Ptr<emp::DataMonitor<double>> data_node_sym_stolen;
   emp::Ptr<emp::DataMonitor<double>> data_node_sym_earned;
@@ -439,6 +488,14 @@ protected:
     Library::GetOpCode("JumpIfEq"),
     Library::GetOpCode("JumpIfLess")
   };
+  uint8_t sgp_anchor_opcode = Library::GetOpCode("Global Anchor");
+  // Instructions that can interrupt multi-cycle execution (see CPUState::InterruptExec)
+  std::unordered_set<uint8_t> sgp_interrupt_opcodes = {
+    Library::GetOpCode("Reproduce"),
+    Library::GetOpCode("Infect")
+  };
+  // Config values used by instructions (see UpdateInstSettings).
+  InstSettings inst_settings;
 
   // Directory to dump output files into.
   std::filesystem::path output_dir;
@@ -530,10 +587,23 @@ protected:
 
   void ProcessStressEscapees();
 
+  // Internal helper function to produce stress escapee offspring from an endosymbiont.
+  void AddStressEscapees(
+    emp::Ptr<sgp_sym_t> endosym_ptr,
+    const emp::BitVector& endosym_task_profile
+  );
+
+  // Apply any writes deferred by scheduler threads during this update.
+  void ApplyDeferredWrites();
+
+  // Free-living symbiont infection logic (see FreeLivingSymDoInfect).
+  void DoFreeLivingSymInfect(sgp_sym_t& sym);
+
   // --- Internal setup helper functions ---.
   // Called internally on world setup.
   void SetupOrgTypeVariables();
   void DisableConfigurableInstructions();
+  void UpdateInstSettings();
   void SetupPopStructure();
   void SetupScheduler();
   void SetupChangingEnvironment();
@@ -613,9 +683,21 @@ public:
       ) {
         return 0.0;
       };
+
+      // Track host genotypes as hosts are placed and removed.
+      OnPlacement([this](size_t pos) {
+        emp::Ptr<sgp_host_t> host = pop[pos].DynamicCast<sgp_host_t>();
+        if (host) host_genotypes.Add(pos, host->GetProgram());
+      });
+      OnOrgDeath([this](size_t pos) {
+        host_genotypes.Remove(pos);
+      });
   }
 
   ~SGPWorld() {
+    // Remove hosts while this world's members (e.g., host_genotypes and
+    // repro_queue, used when hosts are removed) are still alive.
+    Clear();
     if(data_node_sym_donated) data_node_sym_donated.Delete();
     if(data_node_sym_stolen) data_node_sym_stolen.Delete();
     if(data_node_sym_earned) data_node_sym_earned.Delete();
@@ -811,6 +893,9 @@ public:
   }
 
   const std::unordered_set<uint8_t>& GetJumpInstOpcodes() const { return sgp_jump_opcodes; }
+  uint8_t GetAnchorInstOpcode() const { return sgp_anchor_opcode; }
+  const std::unordered_set<uint8_t>& GetInterruptInstOpcodes() const { return sgp_interrupt_opcodes; }
+  const InstSettings& GetInstSettings() const { return inst_settings; }
 
   /**
    * Input: None
@@ -823,6 +908,8 @@ public:
   void Update() override {
     emp_assert(setup);
     begin_update_sig.Trigger();
+    // Pick up any config changes made between updates
+    UpdateInstSettings();
     // Handle resource inflow
     // TODO - implement inflow configuration
     // fun_do_resource_inflow();
@@ -830,6 +917,8 @@ public:
     scheduler.UpdateSchedule();
     // Run scheduler to process organisms
     scheduler.Run(*this);
+    // Apply any shared-state changes made while processing on scheduler threads
+    ApplyDeferredWrites();
     // Process reproduction queue
     repro_queue.Process();
     ProcessStressEscapees();
@@ -845,22 +934,66 @@ public:
     emp::World<Organism>::Update();
     if (sgp_config.PHYLOGENY()) {
       sym_sys->Update();
+      PrunePhylogeny();
     }
   }
   
   // TODO: AEV: Why is this separate from RunExperiment in SymWorld? Needs to be combined to support all the other functionality from RunExperiment
+  // Runs from the current update (0, unless a checkpoint was restored) through
+  // config.UPDATES, writing a checkpoint every config.CHECKPOINT_INTERVAL updates.
   void Run(bool verbose = false) {
     emp_assert(setup);
     emp_assert(sgp_config.UPDATES() >= 0);
     const size_t updates = sgp_config.UPDATES();
-    for (size_t u = 0; u <= updates; ++u) {
+    const size_t checkpoint_interval = sgp_config.CHECKPOINT_INTERVAL();
+    for (size_t u = GetUpdate(); u <= updates; ++u) {
       Update();
       if (verbose && (u % sgp_config.PRINT_INTERVAL()) == 0) {
         std::cout << "Update: " << u << std::endl;
       }
+      if (checkpoint_interval && (GetUpdate() % checkpoint_interval) == 0) {
+        if (!SaveCheckpoint(sgp_config.CHECKPOINT_PATH())) {
+          std::cout << "Failed to write checkpoint file: " << sgp_config.CHECKPOINT_PATH() << std::endl;
+        }
+      }
     }
   }
 
+  /**
+   * Input: Path of the checkpoint file to write.
+   *
+   * Output: Whether the checkpoint was written.
+   *
+   * Purpose: Saves the full state of the simulation between updates (organisms,
+   * random number generators, schedule, and task environment) so that
+   * LoadCheckpoint can continue the run exactly where it left off. Organism
+   * records are streamed to the file one at a time.
+   *
+   * NOTE - The checkpoint is written to a temporary file first and then
+   *        renamed, so a run killed while writing keeps its last checkpoint.
+   * NOTE - Systematics aren't checkpointed, so runs with PHYLOGENY on can't
+   *        be checkpointed (Setup rejects CHECKPOINT_INTERVAL and
+   *        RESTORE_CHECKPOINT_PATH with PHYLOGENY on).
+   */
+  bool SaveCheckpoint(const std::string& filepath);
+
+  /**
+   * Input: Path of a checkpoint file written by SaveCheckpoint, and a string to
+   * hold an error message if the checkpoint can't be restored.
+   *
+   * Output: Whether the checkpoint was restored.
+   *
+   * Purpose: Replaces this world's population and state with a checkpoint's.
+   * The world must have been set up with the same configuration as the run
+   * that wrote the checkpoint (checked against the settings the checkpoint
+   * stores); updates run afterward then match those of the original run. If restoring fails partway, the population may be partially
+   * restored.
+   *
+   * NOTE - Data files are not part of a checkpoint. Data nodes start over at
+   *        the restored update.
+   */
+  bool LoadCheckpoint(const std::string& filepath, std::string& error);
+
   // Process hosts at given position in world pop vector and free-living symbionts in world syms vector.
   void ProcessOrgsAt(size_t pop_id);
 
@@ -879,7 +1012,9 @@ public:
     const size_t env_id = GetRandom().GetUInt(task_env.GetIOBank().GetSize());
     const auto& task_io = task_env.GetIOBank().GetIO(env_id);
     cpu_state.SetTaskEnvID(env_id);
-    cpu_state.SetInputs(task_io.input_buffer);
+    // The IO bank doesn't change during a run, so organisms can read its inputs
+    // in place.
+    cpu_state.ViewInputs(task_io.input_buffer);
     cpu_state.ResetCreditedOutputs();
   }
 
@@ -906,8 +1041,9 @@ public:
     emp::WorldPosition parent_pos
   ) override;
 
-  void HostDoMutation(sgp_host_t& host);
-  void SymDoMutation(sgp_sym_t& sym);
+  // Return the indices of the instructions that were changed.
+  const emp::vector<size_t>& HostDoMutation(sgp_host_t& host);
+  const emp::vector<size_t>& SymDoMutation(sgp_sym_t& sym);
 
   void SymDonateToHost(Organism& from_sym, Organism& to_host);
   void SymStealFromHost(Organism& to_sym, Organism& from_host);
@@ -935,6 +1071,62 @@ public:
   nutrient_sym_mode_t GetNutrientSymType() const { return nutrient_sym_type; }
 
   ReproductionQueue& GetReproQueue() { return repro_queue; }
+  Scheduler& GetScheduler() { return scheduler; }
+
+  const GenotypeRegistry<sgp_prog_t>& GetHostGenotypes() const { return host_genotypes; }
+
+  /**
+   * Input: None
+   *
+   * Output: A representative host for each of the top `config.DOMINANT_COUNT`
+   * host genotypes, paired with the genotype's abundance, most abundant first.
+   *
+   * Purpose: To find dominant hosts from the genotype registry instead of
+   * comparing every pair of genomes (as SymWorld::GetDominantInfo does).
+   */
+  emp::vector<std::pair<emp::Ptr<Organism>, size_t>> GetDominantInfo() const {
+    emp_assert(
+      GetNumOrgs(),
+      "called GetDominantInfo on an empty population"
+    );
+    emp::vector<std::pair<emp::Ptr<Organism>, size_t>> result;
+    for (size_t id : host_genotypes.GetTopGenotypes(sgp_config.DOMINANT_COUNT())) {
+      const auto& genotype = host_genotypes.GetGenotype(id);
+      result.emplace_back(pop[genotype.first_pos], genotype.count);
+    }
+    return result;
+  }
+
+  /**
+   * Input: A function that modifies world state shared across world locations
+   *
+   * Output: None
+   *
+   * Purpose: While organisms are being processed, fun is queued and applied (in
+   * schedule order) once all threads are done processing organisms for this
+   * update, however many threads there are. Otherwise, fun runs immediately.
+   */
+  template<typename FUN_T>
+  void DeferWrite(FUN_T&& fun) {
+    if (Scheduler::InWorker()) {
+      deferred_writes[Scheduler::GetWorkerID()].emplace_back(std::forward<FUN_T>(fun));
+    } else {
+      fun();
+    }
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: The random number generator to use while processing organisms.
+   *
+   * Purpose: The world's random number generator is shared, so organisms are
+   * processed with a thread-local generator, seeded for each world location
+   * every update (see Scheduler::SeedProcessRandom).
+   */
+  emp::Random& GetProcessRandom() {
+    return Scheduler::InWorker() ? sgpl::tlrand.Get() : GetRandom();
+  }
 
   // Data node methods
   emp::DataMonitor<double>& GetSymDonatedDataNode() {
@@ -954,6 +1146,9 @@ public:
   ProgramBuilder<hw_spec_t>& GetProgramBuilder() { return prog_builder; }
   const ProgramBuilder<hw_spec_t>& GetProgramBuilder() const { return prog_builder; }
 
+  mutator_t& GetMutator() { return mutator; }
+  const sgp_prog_rectifier_t& GetOpcodeRectifier() const { return opcode_rectifier; }
+
   emp::DataFile& SetupOrgCountFile(const std::string& filepath);
   emp::DataFile& SetupSymDonatedFile(const std::string& filepath);
   emp::DataFile& SetupTasksFile(const std::string& filepath);
@@ -962,6 +1157,7 @@ public:
   emp::DataFile& SetupCurrentUpdateInfoFile(const std::string& filepath);
   void CollectCurrentUpdateData();
   emp::DataFile& SetupSymbiontInteractionValuesFile(const std::string& filepath);
+  emp::DataFile& SetupDominantGenotypesFile(const std::string& filepath);
   void OutputDominantDataFile();
 
   void CreateDataFiles() override;
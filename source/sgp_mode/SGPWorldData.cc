@@ -12,6 +12,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <sstream>
 #include <filesystem>
 
 namespace sgpmode {
@@ -43,6 +44,14 @@ void SGPWorld::CreateDataFiles() {
   // Setup file for symbiont interaction values
   std::filesystem::path sym_int_vals_fpath = output_dir / ("SymbiontInteractionValues"+sgp_config.FILE_NAME()+".csv");
   SetupSymbiontInteractionValuesFile(sym_int_vals_fpath).SetTimingRepeat(sgp_config.DATA_INT());
+  // Setup file for dominant host genotypes
+  std::filesystem::path dominant_genotypes_fpath = output_dir / ("DominantGenotypes"+sgp_config.FILE_NAME()+".csv");
+  SetupDominantGenotypesFile(dominant_genotypes_fpath).SetTimingRepeat(sgp_config.DATA_INT());
+  if (sgp_config.PHYLOGENY()) {
+    // Setup phylogeny memory use file
+    std::filesystem::path phylogeny_memory_fpath = output_dir / ("PhylogenyMemory"+sgp_config.FILE_NAME()+".csv");
+    SetupPhylogenyMemoryFile(phylogeny_memory_fpath.string()).SetTimingRepeat(sgp_config.DATA_INT());
+  }
 }
 
 emp::DataFile& SGPWorld::SetupOrgCountFile(const std::string& filepath) {
@@ -314,6 +323,48 @@ emp::DataFile& SGPWorld::SetupSymbiontInteractionValuesFile(const std::string& f
   return file;
 }
 
+emp::DataFile& SGPWorld::SetupDominantGenotypesFile(const std::string& filepath) {
+  auto& file = SetupFile(filepath);
+
+  // Dominant genotypes come from the genotype registry, so this does not scan
+  // the population.
+  file.AddPreFun(
+    [this]() {
+      dominant_genotype_ids = host_genotypes.GetTopGenotypes(sgp_config.DOMINANT_COUNT());
+    }
+  );
+
+  file.AddVar(update, "update", "Update");
+  file.AddFun<size_t>(
+    [this]() { return host_genotypes.GetNumGenotypes(); },
+    "num_genotypes",
+    "Number of distinct host genotypes"
+  );
+  // Ranks without a genotype (fewer genotypes than DOMINANT_COUNT) are 0.
+  for (size_t rank = 0; rank < sgp_config.DOMINANT_COUNT(); ++rank) {
+    file.AddFun<uint64_t>(
+      [this, rank]() -> uint64_t {
+        if (rank >= dominant_genotype_ids.size()) return 0;
+        return host_genotypes.GetGenotype(dominant_genotype_ids[rank]).hash;
+      },
+      "genotype_" + emp::to_string(rank),
+      "Content hash of the host genotype at this rank"
+    );
+    file.AddFun<size_t>(
+      [this, rank]() -> size_t {
+        if (rank >= dominant_genotype_ids.size()) return 0;
+        return host_genotypes.GetGenotype(dominant_genotype_ids[rank]).count;
+      },
+      "count_" + emp::to_string(rank),
+      "Number of living hosts with the genotype at this rank"
+    );
+  }
+
+  file.PrintHeaderKeys();
+
+  return file;
+}
+
 emp::DataFile& SGPWorld::SetupCurrentUpdateInfoFile(const std::string& filepath) {
   auto& file = SetupFile(filepath);
 
@@ -699,21 +750,21 @@ void SGPWorld::OutputDominantDataFile() {
     for (auto pair : dominant_organisms) {
       auto sample = pair.first.DynamicCast<sgp_host_t>();
 
-      std::ofstream genome_file;
+      std::ostringstream genome_file;
       std::filesystem::path genome_path = output_dir / dominant_dir / ("Genome_Host"+ 
         std::to_string(idx) + sgp_config.FILE_NAME()+".data"); // Any ending that actually does make sense for these files?
 
-      genome_file.open(genome_path);
       sample->GetHardware().PrintCode(genome_file);
+      WriteOutputFile(genome_path.string(), genome_file.str());
 
       size_t sym_idx = 0;
       for (auto &sym : sample->GetSymbionts()) {
-        std::ofstream genome_file;
+        std::ostringstream genome_file;
         std::filesystem::path genome_path = output_dir / dominant_dir / ("Genome_Sym"+ 
           std::to_string(sym_idx) + "_From_Host"+ 
           std::to_string(idx) + sgp_config.FILE_NAME()+".data");
-        genome_file.open(genome_path);
         sym.DynamicCast<sgp_sym_t>()->GetHardware().PrintCode(genome_file);
+        WriteOutputFile(genome_path.string(), genome_file.str());
         sym_idx++;
       }
 
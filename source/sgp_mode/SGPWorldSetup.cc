@@ -41,6 +41,7 @@ void SGPWorld::Setup() {
 
   // Remove and rectify instruction set as needed
   DisableConfigurableInstructions();
+  UpdateInstSettings();
 
   // Configure task environment
   SetupTaskEnvironment();
@@ -96,6 +97,22 @@ void SGPWorld::Setup() {
   long unsigned int total_syms = POP_SIZE * start_moi;
   SetupSymbionts(&total_syms);
 
+  // Systematics aren't checkpointed (see SaveCheckpoint)
+  if (sgp_config.PHYLOGENY() && (sgp_config.CHECKPOINT_INTERVAL() || sgp_config.RESTORE_CHECKPOINT_PATH() != "")) {
+    std::cout << "CHECKPOINT_INTERVAL and RESTORE_CHECKPOINT_PATH can't be used with PHYLOGENY on, since phylogenies aren't checkpointed." << std::endl;
+    std::cout << "Exiting." << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  // Continue a checkpointed run (replaces the initial population above)
+  if (sgp_config.RESTORE_CHECKPOINT_PATH() != "") {
+    std::string error;
+    if (!LoadCheckpoint(sgp_config.RESTORE_CHECKPOINT_PATH(), error)) {
+      std::cout << error << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+
   CreateDataFiles();
   SnapshotConfig();
   setup = true;
@@ -233,6 +250,21 @@ void SGPWorld::DisableConfigurableInstructions() {
   }
 }
 
+/**
+ * Input: None
+ *
+ * Output: None
+ *
+ * Purpose: Caches the config values that instructions read every time they
+ * execute (see InstSettings). Called during setup and at the start of every
+ * update, so config changes made between updates still take effect.
+ */
+void SGPWorld::UpdateInstSettings() {
+  inst_settings.host_min_cycles_before_repro = sgp_config.HOST_MIN_CYCLES_BEFORE_REPRO();
+  inst_settings.sym_min_cycles_before_repro = sgp_config.SYM_MIN_CYCLES_BEFORE_REPRO();
+  inst_settings.host_only_first_task_credit = sgp_config.HOST_ONLY_FIRST_TASK_CREDIT();
+}
+
 void SGPWorld::SetupPopStructure() {
   // set world structure (either mixed or a grid with some dimensions)
   // and set synchronous generations to false
@@ -247,8 +279,14 @@ void SGPWorld::SetupPopStructure() {
 
 void SGPWorld::SetupScheduler() {
   // Configure scheduler w/max world size (updated in SGPWorld::Setup, and cfg thread count)
-  scheduler.SetupScheduler(max_world_size);
+  scheduler.SetupScheduler(max_world_size, sgp_config.THREAD_COUNT());
   // Scheduler calls world's ProcessOrgAt function
+  // Each scheduler thread gets its own buffer of deferred shared-state writes
+  deferred_writes.clear();
+  deferred_writes.resize(scheduler.GetThreadCount());
+  // Each scheduler thread queues reproduction events in its own shard
+  repro_queue.Clear();
+  repro_queue.SetNumShards(scheduler.GetThreadCount());
 }
 
 void SGPWorld::SetupReproduction() {
@@ -479,8 +517,19 @@ void SGPWorld::SetupTaskEnvironment() {
   task_env.Setup(
     sgp_config.TASK_ENV_CFG_PATH(),
     sgp_config.TASK_IO_BANK_SIZE(),
-    sgp_config.TASK_IO_UNIQUE_OUTPUT()
+    sgp_config.TASK_IO_UNIQUE_OUTPUT(),
+    sgp_config.TASK_IO_BANK_LOAD_PATH(),
+    sgp_config.TASK_IO_BANK_SAVE_PATH()
   );
+  // Organisms can only track credit for as many outputs per task as fit in
+  // their credit masks (one output slot per input, see CPUState::CreditOutput)
+  const size_t num_inputs = task_env.GetIOBank().GetNumInputs();
+  if (num_inputs > sgp_cpu_peripheral_t::MAX_CREDITED_OUTPUT_SLOTS) {
+    std::cout << "Task IO bank environments have " << num_inputs << " inputs, but organisms can only track "
+              << sgp_cpu_peripheral_t::MAX_CREDITED_OUTPUT_SLOTS << " credited outputs per task." << std::endl;
+    std::cout << "Exiting." << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
 
   // Configure organism input buffers / environment id
   // NOTE - now that assigning new env io is in a function, could
@@ -3,22 +3,26 @@
 
 #include "../Organism.h"
 #include "../default_mode/SymWorld.h"
+#include "Checkpoint.h"
 
 #include "sgpl/utility/ThreadLocalRandom.hpp"
 #include "emp/base/vector.hpp"
+#include "emp/math/math.hpp"
 #include "emp/math/Random.hpp"
 #include "emp/math/random_utils.hpp"
 
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <mutex>
+#include <numeric>
 #include <thread>
 #include <algorithm>
 #include <limits>
 
 namespace sgpmode {
 
-// TODO - tests!
 class Scheduler {
 public:
   using fun_process_org_t = std::function<void(emp::WorldPosition, Organism&)>;
@@ -27,84 +31,140 @@ protected:
   emp::Random& random;
   emp::vector<size_t> schedule_order; // Order of pop ids to evaluate.
 
-  // // Threading-related member variables
-  // emp::vector<emp::vector<size_t>> thread_batches; // Contains schedule indexes handled for each thread.
-  // size_t thread_count; // How many threads?
-  // bool threaded_mode = false;
-  // emp::vector<std::thread> running_threads;
-  // bool thread_pool_started = false;
-  // emp::vector<size_t> thread_seeds; // To ensure replicates are independent, need to generate seeds using root rng
-
-  // std::mutex ready_lock;
-  // std::condition_variable ready_cv;
-  // std::atomic<size_t> cur_update = 0;
-
-  // std::mutex threads_done_lock;
-  // std::condition_variable threads_done_cv;
-  // size_t num_threads_done = 0;
-  // std::atomic_bool finished = false;
-
-  // // Helper function to get id to schedule w/thread batch info
-  // size_t GetID(size_t batch_id, size_t idx) {
-  //   emp_assert(batch_id < thread_batches.size());
-  //   emp_assert(idx < thread_batches[batch_id].size());
-  //   return schedule_order[thread_batches[batch_id][idx]];
-  // }
-
-  // TODO - re-evaluate use of threads; so much possibility for hard-to-detect bad behavior
-  // Can't pass in world as a temporary reference
-  // // TODO - benchmark this approach to scheduling on threads vs. dynamic batching
-  // template<typename WORLD_T>
-  // void RunThread(emp::Ptr<WORLD_T> world_ptr, size_t thread_id) {
-  //   // Make sure each thread gets a different, deterministic, seed
-  //   const size_t thread_seed = thread_seeds[thread_id];
-  //   const auto& schedule_ids = thread_batches[thread_id];
-  //   sgpl::tlrand.Get().ResetSeed(thread_seed);
-  //   size_t last_update = std::numeric_limits<size_t>::max();
-  //   while (true) {
-  //     if (!finished && last_update == cur_update) {
-  //       std::unique_lock<std::mutex> lock(ready_lock);
-  //       ready_cv.wait(
-  //         lock,
-  //         [&]() { return finished || last_update != cur_update; }
-  //       );
-  //     }
-  //     if (finished) return;
-  //     last_update = cur_update;
-  //     // Process assigned organisms
-  //     for (size_t schedule_i : schedule_ids) {
-  //       const size_t pop_id = GetID(thread_id, schedule_i);
-  //       world_ptr->ProcessOrgsAt(pop_id);
-  //     }
-
-  //     {
-  //       std::unique_lock<std::mutex> lock(threads_done_lock);
-  //       num_threads_done++;
-  //     }
-  //     threads_done_cv.notify_all();
-  //   }
-
-  // }
+  // Threading-related member variables
+  // Each thread handles a contiguous slice of the (shuffled) schedule. Thread i
+  // handles schedule indices [batch_starts[i], batch_starts[i+1]).
+  emp::vector<size_t> batch_starts;
+  size_t thread_count = 1; // How many threads?
+  bool threaded_mode = false;
+  emp::vector<std::thread> running_threads;
+  bool thread_pool_started = false;
+  // Drawn from the root rng every update; each location's random number
+  // stream for the update is seeded from it (see SeedProcessRandom)
+  uint64_t update_seed = 0;
+
+  std::mutex ready_lock;
+  std::condition_variable ready_cv;
+  size_t cur_update = 0; // Guarded by ready_lock
+  bool finished = false; // Guarded by ready_lock
+
+  std::mutex threads_done_lock;
+  std::condition_variable threads_done_cv;
+  size_t num_threads_done = 0; // Guarded by threads_done_lock
+
+  // Which thread is running the caller? The main thread is always worker 0,
+  // and is only "in a worker" while it processes organisms itself (when not
+  // running in threaded mode).
+  inline static thread_local size_t worker_id = 0;
+  inline static thread_local bool in_worker = false;
+
+  // Helper function to get id to schedule w/thread batch info
+  size_t GetID(size_t schedule_i) const {
+    emp_assert(schedule_i < schedule_order.size());
+    return schedule_order[schedule_i];
+  }
+
+  // Seeds the calling thread's random number generator for processing the
+  // organisms at a world location this update. Organisms' random draws then
+  // only depend on the update and their location, not on which thread
+  // processes them, so results don't depend on the thread count.
+  // NOTE - emp::Random only takes positive int seeds, so there are just under
+  //        2^31 of them. That is enough: seeds only have to differ between the
+  //        locations processed in the same update, and offset -> offset * 48271
+  //        (mod 2^31 - 1, a prime) is a bijection, so locations in one update
+  //        never share a seed for worlds smaller than 2^31 - 1. A seed reused in
+  //        a later update just starts that location's stream somewhere else, the
+  //        same as reusing SEED across runs.
+  void SeedProcessRandom(size_t world_id) const {
+    constexpr uint64_t SEED_MODULUS = std::numeric_limits<int32_t>::max();
+    emp_assert(schedule_order.size() < SEED_MODULUS);
+    const uint64_t offset = (update_seed + world_id) % (SEED_MODULUS - 1) + 1;
+    const uint64_t seed = (offset * 48271) % SEED_MODULUS; // In [1, 2^31 - 2]
+    sgpl::tlrand.Get().ResetSeed((int)seed);
+  }
+
+  // NOTE - Worker threads persist across updates. Each update, the main thread
+  //        bumps cur_update and waits until every worker has processed its batch.
+  // TODO - benchmark this approach to scheduling on threads vs. dynamic batching
+  template<typename WORLD_T>
+  void RunThread(emp::Ptr<WORLD_T> world_ptr, size_t thread_id, size_t start_update) {
+    worker_id = thread_id;
+    in_worker = true;
+    size_t last_update = start_update;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(ready_lock);
+        ready_cv.wait(
+          lock,
+          [&]() { return finished || last_update != cur_update; }
+        );
+        if (finished) return;
+        last_update = cur_update;
+      }
+      // Process assigned organisms
+      for (size_t schedule_i = batch_starts[thread_id]; schedule_i < batch_starts[thread_id + 1]; ++schedule_i) {
+        SeedProcessRandom(GetID(schedule_i));
+        world_ptr->ProcessOrgsAt(GetID(schedule_i));
+      }
+
+      {
+        std::unique_lock<std::mutex> lock(threads_done_lock);
+        num_threads_done++;
+      }
+      threads_done_cv.notify_all();
+    }
+  }
+
+  template<typename WORLD_T>
+  void StartThreads(WORLD_T& world) {
+    emp_assert(threaded_mode);
+    emp_assert(!thread_pool_started);
+    finished = false;
+    for (size_t thread_id = 0; thread_id < thread_count; ++thread_id) {
+      running_threads.emplace_back(
+        &Scheduler::RunThread<WORLD_T>,
+        this,
+        emp::Ptr<WORLD_T>(&world),
+        thread_id,
+        cur_update
+      );
+    }
+    thread_pool_started = true;
+  }
+
+  void StopThreads() {
+    if (!thread_pool_started) return;
+    {
+      std::unique_lock<std::mutex> lock(ready_lock);
+      finished = true;
+    }
+    ready_cv.notify_all();
+    for (auto& thread : running_threads) {
+      thread.join();
+    }
+    running_threads.clear();
+    thread_pool_started = false;
+  }
 
 public:
   Scheduler(
     emp::Random& rand,
-    size_t world_size=1
-    // size_t num_threads=1
+    size_t world_size=1,
+    size_t num_threads=1
   ) :
     random(rand)
-    // thread_count(num_threads),
-    // threaded_mode(num_threads > 1)
   {
-    // SetupScheduler(world_size, num_threads);
-    SetupScheduler(world_size);
+    SetupScheduler(world_size, num_threads);
   }
 
-  ~Scheduler() { }
+  ~Scheduler() { StopThreads(); }
 
   // Allow re-configuration of scheduler post-construction.
-  void SetupScheduler(size_t world_size) {
+  void SetupScheduler(size_t world_size, size_t num_threads=1) {
     emp_assert(world_size > 0, "World size must be > 0");
+    emp_assert(num_threads > 0, "Thread count must be > 0");
+    // Any running threads are working from the old configuration.
+    StopThreads();
 
     // Resize schedule order to world size
     schedule_order.resize(world_size, 0);
@@ -115,23 +175,89 @@ public:
       0
     );
 
+    // No point in having more threads than world locations
+    thread_count = emp::Min(num_threads, world_size);
+    threaded_mode = thread_count > 1;
+
+    // Split schedule into (near) equal-sized contiguous batches
+    batch_starts.resize(thread_count + 1, 0);
+    for (size_t thread_id = 0; thread_id <= thread_count; ++thread_id) {
+      batch_starts[thread_id] = (thread_id * world_size) / thread_count;
+    }
   }
 
   size_t GetScheduleSize() const { return schedule_order.size(); }
   const emp::vector<size_t>& GetCurSchedule() const { return schedule_order; }
 
-  // Update schedule order (uniform random)
+  size_t GetThreadCount() const { return thread_count; }
+  bool IsThreaded() const { return threaded_mode; }
+
+  // Returns id of thread calling this function (0 if not called from a worker)
+  static size_t GetWorkerID() { return worker_id; }
+  // Is the calling thread a worker that is currently processing organisms?
+  static bool InWorker() { return in_worker; }
+
+  // Replace the schedule order (e.g., when restoring a checkpoint). Must be a
+  // permutation of the world's locations.
+  bool SetSchedule(const emp::vector<size_t>& order) {
+    if (order.size() != schedule_order.size()) return false;
+    emp::vector<bool> seen(order.size(), false);
+    for (size_t world_id : order) {
+      if (world_id >= order.size() || seen[world_id]) return false;
+      seen[world_id] = true;
+    }
+    schedule_order = order;
+    return true;
+  }
+
+  // Update schedule order (uniform random), and draw the seed for this
+  // update's random number streams
   void UpdateSchedule() {
     emp::Shuffle(random, schedule_order);
+    update_seed = random.GetUInt(1, std::numeric_limits<int32_t>::max());
   }
 
-  // Process all orgs in world population in current schedule order (single-threaded).
+  // Process all orgs in world population in current schedule order.
+  // In threaded mode, this returns once every thread has processed its batch.
+  // Otherwise, the main thread processes every organism as worker 0, so shared
+  // writes are deferred just as on worker threads, and its own random number
+  // generator is left as it was.
+  // NOTE - The serial path deliberately matches the threaded one (per-location
+  //        random streams, deferred writes), so a run with THREAD_COUNT=1 gives
+  //        the same results as any other thread count. This means serial runs
+  //        don't reproduce runs made before per-location streams were added.
   template<typename WORLD_T>
   void Run(WORLD_T& world) {
-    for (size_t world_id : schedule_order) {
-      emp_assert(world_id < world.GetSize());
-      world.ProcessOrgsAt(world_id);
+    if (!threaded_mode) {
+      const random_state_t main_random_state = GetRandomState(sgpl::tlrand.Get());
+      in_worker = true;
+      for (size_t world_id : schedule_order) {
+        emp_assert(world_id < world.GetSize());
+        SeedProcessRandom(world_id);
+        world.ProcessOrgsAt(world_id);
+      }
+      in_worker = false;
+      SetRandomState(sgpl::tlrand.Get(), main_random_state);
+      return;
+    }
+
+    if (!thread_pool_started) {
+      StartThreads(world);
+    }
+    {
+      std::unique_lock<std::mutex> lock(threads_done_lock);
+      num_threads_done = 0;
     }
+    {
+      std::unique_lock<std::mutex> lock(ready_lock);
+      ++cur_update;
+    }
+    ready_cv.notify_all();
+    std::unique_lock<std::mutex> lock(threads_done_lock);
+    threads_done_cv.wait(
+      lock,
+      [&]() { return num_threads_done == thread_count; }
+    );
   }
 
 };
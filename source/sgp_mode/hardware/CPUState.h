@@ -3,6 +3,7 @@
 
 #include "RingBuffer.h"
 #include "Stacks.h"
+#include "../Checkpoint.h"
 #include "../org_type_info.h"
 #include "../utils.h"
 #include "../../Organism.h"
@@ -15,6 +16,7 @@
 #include "emp/base/array.hpp"
 #include "emp/math/math.hpp"
 
+#include <bit>
 #include <cstdint>
 
 namespace sgpmode {
@@ -35,8 +37,13 @@ public:
   // using spec_t = HW_SPEC_T;
   using world_t = WORLD_T;
   using reg_val_t = typename world_t::hw_spec_t::register_value_t;
+  using stacks_t = typename world_t::hw_spec_t::stacks_t;
   using input_buf_t = RingBuffer<uint32_t>;
   using output_buf_t = emp::vector<uint32_t>;
+  // One bit per output slot (index into a task's correct outputs in the
+  // organism's TaskIO).
+  using output_credit_mask_t = uint64_t;
+  static constexpr size_t MAX_CREDITED_OUTPUT_SLOTS = 64;
 
   struct ReproInfo {
     ReproState state = ReproState::NONE;
@@ -44,7 +51,7 @@ public:
   };
 
 protected:
-  Stacks<uint32_t> stacks;
+  stacks_t stacks;
   input_buf_t input_buf;
   output_buf_t output_buffer;
   size_t task_env_id = 0; // Tracks current task ID environment used by this organism
@@ -58,8 +65,8 @@ protected:
 
   // Track which outputs for each task have been credited.
   // - Only give credit for repeats after all pairs have been used
-  // task outputs credited
-  emp::vector< std::set<uint32_t> > task_outputs_credited;
+  // task outputs credited (indexed by task id, bit per output slot)
+  emp::vector<output_credit_mask_t> task_outputs_credited;
 
   emp::BitVector parent_tasks_performed;
   emp::BitVector parent_first_task_performed;
@@ -81,6 +88,10 @@ protected:
   ReproInfo repro_info;
   size_t cpu_cycles_since_repro = 0;
 
+  // Set by instructions whose effects the world must handle before the CPU
+  // continues executing (e.g., reproduction attempts, infection).
+  bool exec_interrupt = false;
+
   emp::vector<size_t> jump_table;
 
   emp::Ptr<Organism> organism; // Unowned pointer to organism using this CPU.
@@ -95,7 +106,7 @@ public:
     size_t task_count = 0,
     size_t stack_limit = org_info::DEFAULT_STACK_SIZE_LIMIT
   ) :
-    stacks(2),
+    stacks(world_t::hw_spec_t::num_stacks),
     num_tasks(task_count),
     organism(organism),
     world_ptr(world)
@@ -120,8 +131,7 @@ public:
     output_buffer.clear();
 
     // Reset tasks credited
-    task_outputs_credited.clear();
-    task_outputs_credited.resize(task_count, {});
+    utils::ResizeFill(task_outputs_credited, num_tasks, 0);
 
     // Resize + 0-out
     // utils::ResizeClear(used_resources, num_tasks);
@@ -145,6 +155,7 @@ public:
 
     ResetReproState();
     cpu_cycles_since_repro = 0;
+    exec_interrupt = false;
 
     jump_table.clear();
 
@@ -209,6 +220,13 @@ public:
     emp_assert(input_buf.size() == inputs.size());
   }
 
+  // Read inputs directly from (without copying) inputs, which must outlive
+  // their use by this CPU state (e.g., an entry in the world's task IO bank).
+  void ViewInputs(const emp::vector<uint32_t>& inputs) {
+    input_buf.SetView(inputs);
+    emp_assert(input_buf.size() == inputs.size());
+  }
+
   void SetOutputs(const emp::vector<uint32_t>& outputs) {
     for (size_t i = 0; i < outputs.size(); i++) {
       if (i < output_buffer.size()) {
@@ -246,10 +264,13 @@ public:
   world_t& GetWorld() { return *world_ptr; }
   const world_t& GetWorld() const { return *world_ptr; }
 
-  Stacks<uint32_t>& GetStacks() { return stacks; }
-  const Stacks<uint32_t>& GetStacks() const { return stacks; }
+  stacks_t& GetStacks() { return stacks; }
+  const stacks_t& GetStacks() const { return stacks; }
 
-  void MarkReproAttempt() { repro_info.state = ReproState::ATTEMPTING; }
+  void MarkReproAttempt() {
+    repro_info.state = ReproState::ATTEMPTING;
+    InterruptExec();
+  }
   void MarkReproInProgress(size_t queue_pos) {
     repro_info.state = ReproState::IN_PROGRESS;
     repro_info.queue_pos = queue_pos;
@@ -273,6 +294,18 @@ public:
     repro_info.queue_pos = 0;
   }
 
+  // Stop multi-cycle execution (SGPHardware::RunCPUCycles) after the current cycle.
+  void InterruptExec() { exec_interrupt = true; }
+  bool ExecInterrupted() const { return exec_interrupt; }
+  void ClearExecInterrupt() { exec_interrupt = false; }
+
+  // Can any instruction interrupt execution in this state? Reproduce is a
+  // no-op while reproduction is in progress, and only free-living symbionts
+  // can infect.
+  bool CanInterruptExec() const {
+    return !ReproInProgress() || !(IsHost() || HasHost());
+  }
+
   size_t GetCPUCyclesSinceRepro() const { return cpu_cycles_since_repro; }
   void IncCPUCyclesSinceRepro(size_t inc_amount = 1) {
     cpu_cycles_since_repro += inc_amount;
@@ -322,7 +355,7 @@ public:
     emp_assert(task_id < tasks_performance_count.size());
     tasks_performance_count[task_id] = 0;
     tasks_performed.Set(task_id, false);
-    task_outputs_credited[task_id].clear();
+    task_outputs_credited[task_id] = 0;
     first_task_performed.Set(task_id, false);
   }
 
@@ -341,27 +374,36 @@ public:
 
   }
 
-  // Has this output value been credited for given task id?
-  bool OutputCredited(size_t task_id, uint32_t output_val) const {
+  // Has this output (identified by its slot in the TaskIO, see TaskIO::GetOutputSlot)
+  // been credited for given task id?
+  // NOTE - SGPWorld::SetupTaskEnvironment rejects task IO banks with more
+  //        output slots than fit in the mask.
+  bool OutputCredited(size_t task_id, size_t output_slot) const {
     emp_assert(task_id < task_outputs_credited.size());
-    return emp::Has(task_outputs_credited[task_id], output_val);
+    emp_assert(output_slot < MAX_CREDITED_OUTPUT_SLOTS);
+    return (task_outputs_credited[task_id] >> output_slot) & 1;
   }
-  const std::set<uint32_t>& GetOutputsCredited(size_t task_id) const {
+  // How many distinct outputs have been credited for given task id?
+  size_t GetNumOutputsCredited(size_t task_id) const {
+    emp_assert(task_id < task_outputs_credited.size());
+    return (size_t)std::popcount(task_outputs_credited[task_id]);
+  }
+  output_credit_mask_t GetOutputsCredited(size_t task_id) const {
     emp_assert(task_id < task_outputs_credited.size());
     return task_outputs_credited[task_id];
   }
-  // Credit the output value
-  void CreditOutputValue(size_t task_id, uint32_t output_val) {
+  // Credit the output
+  void CreditOutput(size_t task_id, size_t output_slot) {
     emp_assert(task_id < task_outputs_credited.size());
-    task_outputs_credited[task_id].emplace(output_val);
+    emp_assert(output_slot < MAX_CREDITED_OUTPUT_SLOTS);
+    task_outputs_credited[task_id] |= (output_credit_mask_t{1} << output_slot);
   }
   void ResetCreditedOutputs(size_t task_id) {
-    task_outputs_credited[task_id].clear();
+    emp_assert(task_id < task_outputs_credited.size());
+    task_outputs_credited[task_id] = 0;
   }
   void ResetCreditedOutputs() {
-    for (auto& outputs : task_outputs_credited) {
-      outputs.clear();
-    }
+    std::fill(task_outputs_credited.begin(), task_outputs_credited.end(), 0);
   }
 
   size_t GetLineageTaskLossCount(size_t task_id) const {
@@ -402,6 +444,146 @@ public:
     lineage_task_diverge_partner[task_id] = count;
   }
 
+  /**
+   * Input: The checkpoint stream to write to.
+   *
+   * Output: None
+   *
+   * Purpose: Writes everything instructions (and the world) can change in this
+   * state: stacks, IO buffers, task tracking, repro state, and location.
+   * The jump table isn't written, as it only depends on the program.
+   *
+   * NOTE - An input buffer that views (see ViewInputs) the IO bank only records
+   *        its positions; ReadCheckpoint views the bank's inputs for
+   *        task_env_id again.
+   */
+  void WriteCheckpoint(CheckpointWriter& out) const {
+    out.Write<uint64_t>(stacks.GetNumStacks());
+    for (size_t stack_id = 0; stack_id < stacks.GetNumStacks(); ++stack_id) {
+      const auto& stack = stacks.GetStack(stack_id);
+      out.Write<uint64_t>(stack.size());
+      for (uint32_t val : stack) out.Write(val);
+    }
+    out.Write<uint64_t>(stacks.GetActiveID());
+
+    out.Write<uint64_t>(task_env_id);
+    out.Write<uint8_t>(input_buf.IsView());
+    if (!input_buf.IsView()) {
+      out.Write<uint64_t>(input_buf.size());
+      for (size_t i = 0; i < input_buf.size(); ++i) out.Write<uint32_t>(input_buf[i]);
+    }
+    out.Write<uint64_t>(input_buf.GetReadPos());
+    out.Write<uint64_t>(input_buf.GetWritePos());
+    out.WriteVector(output_buffer);
+
+    out.Write<uint64_t>(num_tasks);
+    out.WriteBits(tasks_performed);
+    out.WriteVector(tasks_performance_count);
+    out.WriteBits(first_task_performed);
+    out.WriteVector(task_outputs_credited);
+    out.WriteBits(parent_tasks_performed);
+    out.WriteBits(parent_first_task_performed);
+    out.WriteVector(lineage_task_change_loss);
+    out.WriteVector(lineage_task_change_gain);
+    out.WriteVector(lineage_task_converge_partner);
+    out.WriteVector(lineage_task_diverge_partner);
+
+    out.Write(survival_resource);
+    out.Write<uint64_t>(cpu_cycles_to_exec);
+    out.Write<uint8_t>((uint8_t)repro_info.state);
+    out.Write<uint64_t>(repro_info.queue_pos);
+    out.Write<uint64_t>(cpu_cycles_since_repro);
+    out.Write<uint8_t>(exec_interrupt);
+    out.Write<uint64_t>(location.GetIndex());
+    out.Write<uint64_t>(location.GetPopID());
+  }
+
+  /**
+   * Input: The checkpoint stream to read from.
+   *
+   * Output: Whether the state was read (false if the checkpoint is corrupt or
+   * doesn't match this state's configuration).
+   *
+   * Purpose: Restores state written by WriteCheckpoint. Does not change the
+   * jump table, organism, or world.
+   */
+  bool ReadCheckpoint(CheckpointReader& in) {
+    const size_t num_stacks = in.Read<uint64_t>();
+    if (num_stacks != stacks.GetNumStacks()) in.Fail();
+    stacks.ClearAll();
+    for (size_t stack_id = 0; stack_id < num_stacks && in.Ok(); ++stack_id) {
+      stacks.SetActive(stack_id);
+      const size_t stack_size = in.Read<uint64_t>();
+      for (size_t i = 0; i < stack_size && in.Ok(); ++i) {
+        if (!stacks.Push(in.Read<uint32_t>())) in.Fail();
+      }
+    }
+    const size_t active_stack = in.Read<uint64_t>();
+    if (active_stack >= stacks.GetNumStacks()) in.Fail();
+    if (!in.Ok()) return false;
+    stacks.SetActive(active_stack);
+
+    task_env_id = in.Read<uint64_t>();
+    const auto& io_bank = world_ptr->GetTaskEnv().GetIOBank();
+    if (task_env_id >= io_bank.GetSize()) in.Fail();
+    const bool input_view = in.Read<uint8_t>();
+    if (!in.Ok()) return false;
+    if (input_view) {
+      ViewInputs(io_bank.GetIO(task_env_id).input_buffer);
+    } else {
+      const size_t num_inputs = in.Read<uint64_t>();
+      if (num_inputs > MAX_CREDITED_OUTPUT_SLOTS) in.Fail();
+      if (!in.Ok()) return false;
+      emp::vector<uint32_t> inputs(num_inputs);
+      for (uint32_t& input : inputs) input = in.Read<uint32_t>();
+      SetInputs(inputs);
+    }
+    const size_t read_pos = in.Read<uint64_t>();
+    const size_t write_pos = in.Read<uint64_t>();
+    if (read_pos > 0 && read_pos >= input_buf.size()) in.Fail();
+    if (write_pos > 0 && write_pos >= input_buf.size()) in.Fail();
+    if (!in.Ok()) return false;
+    input_buf.SetPositions(read_pos, write_pos);
+    in.ReadVector(output_buffer);
+
+    if (in.Read<uint64_t>() != num_tasks) in.Fail();
+    in.ReadBits(tasks_performed);
+    in.ReadVector(tasks_performance_count);
+    in.ReadBits(first_task_performed);
+    in.ReadVector(task_outputs_credited);
+    in.ReadBits(parent_tasks_performed);
+    in.ReadBits(parent_first_task_performed);
+    in.ReadVector(lineage_task_change_loss);
+    in.ReadVector(lineage_task_change_gain);
+    in.ReadVector(lineage_task_converge_partner);
+    in.ReadVector(lineage_task_diverge_partner);
+    const bool task_sizes_match =
+      tasks_performed.GetSize() == num_tasks
+      && tasks_performance_count.size() == num_tasks
+      && first_task_performed.GetSize() == num_tasks
+      && task_outputs_credited.size() == num_tasks
+      && parent_tasks_performed.GetSize() == num_tasks
+      && parent_first_task_performed.GetSize() == num_tasks
+      && lineage_task_change_loss.size() == num_tasks
+      && lineage_task_change_gain.size() == num_tasks
+      && lineage_task_converge_partner.size() == num_tasks
+      && lineage_task_diverge_partner.size() == num_tasks;
+    if (!task_sizes_match) in.Fail();
+
+    survival_resource = in.Read<double>();
+    cpu_cycles_to_exec = in.Read<uint64_t>();
+    const uint8_t repro_state = in.Read<uint8_t>();
+    if (repro_state > (uint8_t)ReproState::IN_PROGRESS) in.Fail();
+    repro_info.state = (ReproState)repro_state;
+    repro_info.queue_pos = in.Read<uint64_t>();
+    cpu_cycles_since_repro = in.Read<uint64_t>();
+    exec_interrupt = in.Read<uint8_t>();
+    const size_t loc_index = in.Read<uint64_t>();
+    const size_t loc_pop_id = in.Read<uint64_t>();
+    location = emp::WorldPosition(loc_index, loc_pop_id);
+    return in.Ok();
+  }
+
 };
 
 }
@@ -44,6 +44,17 @@ using Library = sgpl::OpLibrary<
   sgpl::global::Anchor
 >;
 
+/**
+ * Config-dependent values read by instructions, resolved once by the world
+ * (see SGPWorld::UpdateInstSettings) instead of going through the config on
+ * every instruction execution.
+ */
+struct InstSettings {
+  size_t host_min_cycles_before_repro = 0;
+  size_t sym_min_cycles_before_repro = 0;
+  bool host_only_first_task_credit = false;
+};
+
 namespace lib_info {
   const emp::map<std::string, size_t> arities {
     {"Nop-0", 0},     {"ShiftLeft", 1}, {"ShiftRight", 1}, {"Increment", 1},
@@ -39,7 +39,7 @@ namespace sgpmode::inst {
       uint32_t& b = *reinterpret_cast<uint32_t*>(&core.registers[inst.args[1]]);  \
       uint32_t& c = *reinterpret_cast<uint32_t*>(&core.registers[inst.args[2]]);  \
       /* avoid "unused variable" warnings */                                   \
-      a = a, b = b, c = c;                                                     \
+      (void)a, (void)b, (void)c;                                               \
       InstCode                                                                 \
     }                                                                          \
     static size_t prevalence() { return 1; }                                   \
@@ -101,12 +101,10 @@ INST(Swap, { std::swap(a, b); });
 INST(Reproduce, {
   const emp::WorldPosition& org_loc = state.GetLocation();
   // Check whether this attempt at reproduction is allowed.
-  auto& world_config = state.GetWorld().GetConfig();
-
-
+  const auto& settings = state.GetWorld().GetInstSettings();
   const bool too_soon = (state.IsHost()) ?
-    state.GetCPUCyclesSinceRepro() < world_config.HOST_MIN_CYCLES_BEFORE_REPRO() :
-    state.GetCPUCyclesSinceRepro() < world_config.SYM_MIN_CYCLES_BEFORE_REPRO();
+    state.GetCPUCyclesSinceRepro() < settings.host_min_cycles_before_repro :
+    state.GetCPUCyclesSinceRepro() < settings.sym_min_cycles_before_repro;
   const bool invalid_attempt = state.ReproInProgress() || !org_loc.IsValid()
                                || state.ReproAttempt() || too_soon;
   if (invalid_attempt) {
@@ -182,12 +180,14 @@ INST(Infect, {
     return;
   }
   state.GetWorld().FreeLivingSymDoInfect(state.GetOrg());
+  state.InterruptExec();
 });
 
 // only active if ENABLE_TEMP_CHANGING_ENVIRONMENT turned on and static turned off
 INST(SenseTask, {
   const size_t env_task_id = state.GetTaskEnvID();
   auto& task_env = state.GetWorld().GetTaskEnv();
+  const bool only_first_task_credit = state.GetWorld().GetInstSettings().host_only_first_task_credit;
   const auto& task_io = task_env.GetIOBank().GetIO(env_task_id);
 
   // Check loaded value
@@ -201,12 +201,12 @@ INST(SenseTask, {
       // Is this a host task?
       if (!task_env.IsHostTask(task_id)) continue;
       // Not first task
-      const bool not_first_task = state.GetWorld().GetConfig().HOST_ONLY_FIRST_TASK_CREDIT() && state.GetFirstTaskPerformed().Any() && !state.GetFirstTaskPerformed().Get(task_id);
+      const bool not_first_task = only_first_task_credit && state.GetFirstTaskPerformed().Any() && !state.GetFirstTaskPerformed().Get(task_id);
       if (not_first_task) {
         continue;
       }
       // Has this organism already gotten credit with this output on this task?
-      if (state.OutputCredited(task_id, a)) continue;
+      if (state.OutputCredited(task_id, task_io.GetOutputSlot(task_id, a))) continue;
       // Check task requirements
       auto& task_req_info = task_env.GetHostTaskReq(task_id);
       if (!state.GetWorld().CanPerformTask(state, task_req_info)) {
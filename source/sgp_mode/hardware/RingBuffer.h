@@ -1,6 +1,7 @@
 #pragma once
 
 #include "emp/base/array.hpp"
+#include "emp/base/vector.hpp"
 
 #include <algorithm>
 
@@ -9,6 +10,11 @@ namespace sgpmode {
 // TODO - write tests for IORingBuffer
 /// A helper class for a ring buffer that keeps the latest `len` inputs and
 /// discards the rest.
+///
+/// A RingBuffer can also be a read-only view (see SetView) over contents owned
+/// by someone else (e.g., an environment's inputs in the LogicTaskIOBank), so
+/// pointing an organism at new inputs doesn't copy them. Writing to a view
+/// (push) first copies the viewed contents into the buffer's own storage.
 template <typename T>
 class RingBuffer {
 public:
@@ -16,10 +22,28 @@ public:
 
 protected:
   buffer_t buffer;
+  // Contents read by this ring buffer: either buffer's storage, or viewed
+  // contents owned elsewhere.
+  const T* data = nullptr;
+  size_t data_size = 0;
+  bool viewing = false;
   // size_t next = 0;
   size_t write_ptr = 0;
   size_t read_ptr = 0;
 
+  // Point data at this buffer's own storage (after it may have moved).
+  void UseOwnBuffer() {
+    viewing = false;
+    data = buffer.data();
+    data_size = buffer.size();
+  }
+
+  void SetViewData(const T* view_data, size_t view_size) {
+    viewing = true;
+    data = view_data;
+    data_size = view_size;
+  }
+
 public:
   // Construct buffer filled with 0s
   RingBuffer() {
@@ -32,21 +56,41 @@ public:
   }
 
   // Construct buffer with given contents
-  RingBuffer(const buffer_t& contents) : buffer(contents) { ; }
+  RingBuffer(const buffer_t& contents) : buffer(contents) { UseOwnBuffer(); }
+
+  RingBuffer(const RingBuffer& other) { *this = other; }
+
+  RingBuffer& operator=(const RingBuffer& other) {
+    if (this == &other) return *this;
+    write_ptr = other.write_ptr;
+    read_ptr = other.read_ptr;
+    if (other.viewing) {
+      buffer.clear();
+      SetViewData(other.data, other.data_size);
+    } else {
+      buffer = other.buffer;
+      UseOwnBuffer();
+    }
+    return *this;
+  }
 
   // Push new value into buffer at "next" position, overwriting what was previously
   // there. Advances "next".
   void push(T x) {
+    if (viewing) {
+      buffer.assign(data, data + data_size);
+      UseOwnBuffer();
+    }
     emp_assert(write_ptr < buffer.size());
     buffer[write_ptr] = x;
     write_ptr = ((write_ptr + 1) < buffer.size()) ? write_ptr + 1 : 0;
   }
 
   T read() {
-    emp_assert(read_ptr < buffer.size());
+    emp_assert(read_ptr < data_size);
     const size_t idx = read_ptr;
-    read_ptr = ((read_ptr + 1) < buffer.size()) ? read_ptr + 1 : 0;
-    return buffer[idx];
+    read_ptr = ((read_ptr + 1) < data_size) ? read_ptr + 1 : 0;
+    return data[idx];
   }
 
   // Index into ring buffer, default behavior is to wrap
@@ -54,11 +98,23 @@ public:
   // Can add a GetWrap function that does this and have this fail on out of range index.
   T operator[](size_t idx) const {
     // return buffer[idx % len];
-    const size_t buf_size = buffer.size();
-    return buffer[(idx < buf_size) ? idx : idx % buf_size];
+    return data[(idx < data_size) ? idx : idx % data_size];
   }
 
-  size_t size() const { return buffer.size(); }
+  size_t size() const { return data_size; }
+
+  // Is this ring buffer a view over contents owned elsewhere?
+  bool IsView() const { return viewing; }
+
+  // Read / write positions (e.g., to save and restore a buffer's state).
+  size_t GetReadPos() const { return read_ptr; }
+  size_t GetWritePos() const { return write_ptr; }
+  void SetPositions(size_t read_pos, size_t write_pos) {
+    emp_assert(read_pos < data_size || data_size == 0);
+    emp_assert(write_pos < buffer.size() || viewing || buffer.size() == 0);
+    read_ptr = read_pos;
+    write_ptr = write_pos;
+  }
 
   // Reset contents of buffer to given fill value.
   void Reset(size_t buf_size, T fill_val) {
@@ -71,6 +127,7 @@ public:
       buffer.end(),
       fill_val
     );
+    UseOwnBuffer();
   }
 
   void SetBuffer(const emp::vector<T>& contents) {
@@ -85,7 +142,25 @@ public:
       contents.end(),
       buffer.begin()
     );
+    UseOwnBuffer();
+  }
+
+  /**
+   * Input: Contents to view.
+   *
+   * Output: None
+   *
+   * Purpose: Makes this ring buffer a read-only view over contents (resetting
+   * the read and write positions) without copying them.
+   *
+   * NOTE - contents must stay alive and unchanged (no reallocation) for as long
+   *        as this ring buffer views them.
+   */
+  void SetView(const emp::vector<T>& contents) {
+    write_ptr = 0;
+    read_ptr = 0;
+    SetViewData(contents.data(), contents.size());
   }
 };
 
-}
\ No newline at end of file
+}
@@ -13,7 +13,9 @@
 #include "sgpl/utility/ThreadLocalRandom.hpp"
 #include "emp/datastructs/set_utils.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
 
 namespace sgpmode {
@@ -30,16 +32,38 @@ public:
   using spec_t = HW_SPEC_T;
   using cpu_t = sgpl::Cpu<spec_t>;
   using program_t = sgpl::Program<spec_t>;
+  using shared_program_t = std::shared_ptr<const program_t>;
+  using jump_dests_t = emp::vector<size_t>;
+  using shared_jump_dests_t = std::shared_ptr<const jump_dests_t>;
   using inst_t = sgpl::Instruction<spec_t>;
   using jump_table_t = sgpl::JumpTable<spec_t, typename spec_t::global_matching_t>;
   using world_t = typename spec_t::world_t;
   using cpu_state_t = CPUState<world_t>;
   using tag_t = typename spec_t::tag_t;
 
+  // A program plus the local jump table resolved for it, shared by clonal
+  // organisms. jump_dests may be null if it has not been resolved yet.
+  struct SharedGenome {
+    shared_program_t program;
+    shared_jump_dests_t jump_dests;
+  };
+
 protected:
   cpu_t cpu;
-  program_t program;
+  // Programs are immutable once built and shared between clonal organisms.
+  // Changing a program means swapping in a new shared program.
+  shared_program_t program;
+  // Local jump table resolved for program (null if not resolved yet). Jump
+  // destinations only depend on the program (anchors are matched on a freshly
+  // initialized CPU), so they are shared along with the program.
+  shared_jump_dests_t jump_dests;
   cpu_state_t state;       // cpu_t Peripheral
+  // True while the CPU and state are exactly as InitializeState left them
+  // (i.e., nothing has run or been handed out for writing since).
+  bool pristine = false;
+  // Does program contain an instruction that can interrupt execution (e.g.,
+  // Reproduce)? If not, RunCPUCycles never needs to stop early.
+  bool program_can_interrupt = true;
   /**
    * Input: The instruction to print, and the context needed to print it.
    *
@@ -55,27 +79,37 @@ protected:
     std::ostream& out = std::cout
   ) ;
 
+  // Internal helper function: resolves the destination of the jump
+  // instruction at idx against the CPU's global anchors.
+  size_t ResolveJumpDest(size_t idx) {
+    auto& table = cpu.GetActiveCore().GetGlobalJumpTable();
+    const auto entry{table.MatchRegulated((*program)[idx].tag)};
+    return (entry.size() > 0) ? table.GetVal(entry.front()) : idx + 1;
+  }
+
   // Internal helper function for initializing local jump table used by
-  // symbulation jump instructions.
+  // symbulation jump instructions. Copies the shared jump table if this
+  // program's jump destinations were already resolved.
   void InitializeLocalJumpTable() {
-    // Get global jump table in sgplite cpu
-    auto& table = cpu.GetActiveCore().GetGlobalJumpTable();
     auto& state_jump_table = state.GetJumpTable();
+    if (jump_dests) {
+      emp_assert(jump_dests->size() == program->size());
+      state_jump_table = *jump_dests;
+      return;
+    }
     const auto& jump_opcodes = state.GetWorld().GetJumpInstOpcodes();
     // NOTE - jump table was previously size 100. Seemed like that was because
     //        program size is 100?
-    state_jump_table.resize(program.size(), 0);
+    state_jump_table.resize(program->size(), 0);
     size_t idx = 0;
-    for (auto& inst : program) {
+    for (auto& inst : *program) {
       const uint8_t inst_opcode = inst.op_code;
       if (emp::Has(jump_opcodes, inst_opcode)) {
-        const auto entry{table.MatchRegulated(inst.tag)};
-        state_jump_table[idx] = (entry.size() > 0) ?
-          table.GetVal(entry.front()) :
-          idx + 1;
+        state_jump_table[idx] = ResolveJumpDest(idx);
       }
       ++idx;
     }
+    jump_dests = std::make_shared<const jump_dests_t>(state_jump_table);
   }
 
   /**
@@ -88,13 +122,36 @@ protected:
    */
   // TODO - should this be launching cores? At the moment, it needs to.
   void InitializeState() {
-    cpu.InitializeAnchors(program);
+    cpu.InitializeAnchors(*program);
     LaunchCPU(state.GetWorld().START_TAG);
 
     // NOTE - this is awkward: it requires that a CPU core be launched to run.
     //        This means that we need the start tag for any operation that would reset the CPU.
     // Initialize local jump table for program.
     InitializeLocalJumpTable();
+    ScanInterruptOps();
+    pristine = true;
+  }
+
+  // Internal helper function: caches whether program contains any instruction
+  // that can interrupt execution.
+  void ScanInterruptOps() {
+    const auto& interrupt_opcodes = state.GetWorld().GetInterruptInstOpcodes();
+    program_can_interrupt = std::any_of(
+      program->begin(),
+      program->end(),
+      [&interrupt_opcodes](const inst_t& inst) {
+        return emp::Has(interrupt_opcodes, inst.op_code);
+      }
+    );
+  }
+
+  bool IsAnchorOp(uint8_t op_code) const {
+    return op_code == state.GetWorld().GetAnchorInstOpcode();
+  }
+
+  bool IsJumpOp(uint8_t op_code) const {
+    return emp::Has(state.GetWorld().GetJumpInstOpcodes(), op_code);
   }
 
 public:
@@ -106,7 +163,7 @@ public:
     emp::Ptr<world_t> world_ptr,
     emp::Ptr<Organism> organism
   ) :
-    program(),
+    program(std::make_shared<const program_t>()),
     state(
       world_ptr,
       organism,
@@ -126,13 +183,38 @@ public:
     emp::Ptr<Organism> organism,
     const program_t& program
   ) :
-    program(program),
+    SGPHardware(world_ptr, organism, std::make_shared<const program_t>(program))
+  { }
+
+  /**
+   * Constructs a new CPU that shares another CPU's genome (without copying it).
+   */
+  SGPHardware(
+    emp::Ptr<world_t> world_ptr,
+    emp::Ptr<Organism> organism,
+    shared_program_t program
+  ) :
+    SGPHardware(world_ptr, organism, SharedGenome{std::move(program), nullptr})
+  { }
+
+  /**
+   * Constructs a new CPU that shares another CPU's genome and its resolved
+   * jump table, so building it does not need any tag matching.
+   */
+  SGPHardware(
+    emp::Ptr<world_t> world_ptr,
+    emp::Ptr<Organism> organism,
+    const SharedGenome& genome
+  ) :
+    program(genome.program),
+    jump_dests(genome.jump_dests),
     state(
       world_ptr,
       organism,
       world_ptr->GetTaskCount()
     )
   {
+    emp_assert(this->program);
     // State constructor (above) will reset cpu state.
     // InitializeState (below) will configure the local jump table using program.
     InitializeState();
@@ -165,8 +247,114 @@ public:
     InitializeState();
   }
 
+  /**
+   * Input: The program as it was before it was mutated, and the indices of
+   * the instructions the mutation changed.
+   *
+   * Output: None
+   *
+   * Purpose: Resets the CPU after the program was mutated. If nothing has run
+   * since the CPU was initialized (e.g., a new offspring), its state is still
+   * valid apart from what the mutation invalidated. Otherwise, the CPU is fully
+   * reset. Either way, the jump table resolved for the old program is reused:
+   * only entries for mutated jump instructions are re-resolved, unless an
+   * anchor changed (which can move any destination).
+   */
+  void ResetAfterMutation(
+    const program_t& old_program,
+    const emp::vector<size_t>& mutated_insts
+  ) {
+    emp_assert(old_program.size() == program->size());
+    ScanInterruptOps();
+    if (mutated_insts.empty()) {
+      if (!pristine) Reset();
+      return;
+    }
+    if (AnchorsChanged(old_program, mutated_insts)) {
+      jump_dests = nullptr;
+      if (pristine) {
+        state.GetJumpTable().clear();
+        InitializeState();
+      } else {
+        Reset();
+      }
+      return;
+    }
+    // Anchors are unchanged, so the old jump table is right for every
+    // unmutated instruction.
+    if (!pristine) Reset();
+    UpdateJumpTable(old_program, mutated_insts);
+  }
+
+  /**
+   * Input: A previous version of this CPU's program, and the indices of the
+   * instructions that may differ from it.
+   *
+   * Output: Whether any of those instructions is (or was) an anchor whose
+   * operation or tag changed.
+   *
+   * Purpose: To check whether the global anchors built for old_program are
+   * still valid for the current program.
+   */
+  bool AnchorsChanged(
+    const program_t& old_program,
+    const emp::vector<size_t>& changed_insts
+  ) const {
+    for (size_t i : changed_insts) {
+      const inst_t& old_inst = old_program[i];
+      const inst_t& inst = (*program)[i];
+      if (old_inst.op_code == inst.op_code && old_inst.tag == inst.tag) continue;
+      if (IsAnchorOp(old_inst.op_code) || IsAnchorOp(inst.op_code)) return true;
+    }
+    return false;
+  }
+
+  /**
+   * Input: A previous version of this CPU's program (with the same anchors),
+   * and the indices of the instructions that may differ from it.
+   *
+   * Output: None
+   *
+   * Purpose: Updates a local jump table resolved for old_program to match the
+   * current program, re-resolving only mutated jump instructions. If no jump
+   * destination changed, keeps sharing the old program's jump table.
+   */
+  void UpdateJumpTable(
+    const program_t& old_program,
+    const emp::vector<size_t>& changed_insts
+  ) {
+    auto& state_jump_table = state.GetJumpTable();
+    bool table_changed = false;
+    for (size_t i : changed_insts) {
+      const inst_t& old_inst = old_program[i];
+      const inst_t& inst = (*program)[i];
+      const bool was_jump = IsJumpOp(old_inst.op_code);
+      const bool is_jump = IsJumpOp(inst.op_code);
+      if (!was_jump && !is_jump) continue;
+      if (was_jump && is_jump && old_inst.tag == inst.tag) continue;
+      state_jump_table[i] = is_jump ? ResolveJumpDest(i) : 0;
+      table_changed = true;
+    }
+    if (table_changed) {
+      jump_dests = std::make_shared<const jump_dests_t>(state_jump_table);
+    }
+  }
+
+  bool IsPristine() const { return pristine; }
+
+  // Can running this CPU's program be interrupted in its current state?
+  bool CanInterruptExec() const {
+    return program_can_interrupt && state.CanInterruptExec();
+  }
+
   void SetProgram(const program_t& new_program) {
-    program = new_program;
+    SetProgram(std::make_shared<const program_t>(new_program));
+  }
+
+  void SetProgram(shared_program_t new_program) {
+    emp_assert(new_program);
+    program = std::move(new_program);
+    jump_dests = nullptr;
     Reset();
   }
 
@@ -192,15 +380,46 @@ public:
     // TODO / NOTE - Why set location on every CPU step?
     // -> Moved into ProcessOrg
     // state.SetLocation(location);
+    pristine = false;
     // std::cout << "RunCPUStep" << std::endl;
     // std::cout << "  - Has active core? " << cpu.HasActiveCore() << std::endl;
     // std::cout << "  - Max cores: " << cpu.GetMaxCores() << std::endl;
     // std::cout << "  - Busy cores: " << cpu.GetNumBusyCores() << std::endl;
-    sgpl::execute_cpu_n_cycles<spec_t>(n_cycles, cpu, program, state);
+    sgpl::execute_cpu_n_cycles<spec_t>(n_cycles, cpu, *program, state);
     state.IncCPUCyclesSinceRepro(n_cycles);
     // sgpl::execute_cpu_n_cycles<spec_t>(5, cpu, program, state);
   }
 
+  /**
+   * Input: The maximum number of CPU cycles to run.
+   *
+   * Output: The number of CPU cycles actually run.
+   *
+   * Purpose: Steps the CPU forward up to max_cycles cycles in a single call,
+   * stopping early (after the current cycle) only if an instruction interrupts
+   * execution (e.g., a reproduction attempt or infection).
+   * If BATCH_CPU_EXEC is on and no instruction can interrupt execution (the
+   * program has none, or they are no-ops in the current state), all cycles are
+   * handed to signalgp-lite at once.
+   */
+  size_t RunCPUCycles(size_t max_cycles) {
+    state.ClearExecInterrupt();
+    // NOTE - signalgp-lite may switch between virtual cores differently for a
+    //        single n-cycle call than for n single-cycle calls, so batching is
+    //        opt-in.
+    if (state.GetWorld().GetConfig().BATCH_CPU_EXEC() && !CanInterruptExec()) {
+      RunCPUStep(max_cycles);
+      return max_cycles;
+    }
+    size_t cycles_run = 0;
+    while (cycles_run < max_cycles) {
+      RunCPUStep(1);
+      ++cycles_run;
+      if (state.ExecInterrupted()) break;
+    }
+    return cycles_run;
+  }
+
   /**
    * Input: None
    *
@@ -208,13 +427,19 @@ public:
    *
    * Purpose: To Get the Program of an Organism from its CPU
    */
-  const program_t& GetProgram() const { return program; }
-  program_t& GetProgram() { return program; }
+  const program_t& GetProgram() const { return *program; }
+
+  const shared_program_t& GetSharedProgram() const { return program; }
+  SharedGenome GetSharedGenome() const { return {program, jump_dests}; }
+  const shared_jump_dests_t& GetSharedJumpDests() const { return jump_dests; }
+  // NOTE - Replacing the shared program through this reference does not reset
+  //        the CPU or the cached jump table; call ResetAfterMutation afterwards.
+  shared_program_t& GetSharedProgram() { return program; }
 
   const cpu_state_t& GetCPUState() const { return state; }
-  cpu_state_t& GetCPUState() { return state; }
+  cpu_state_t& GetCPUState() { pristine = false; return state; }
 
-  cpu_t& GetCPU() { return cpu; }
+  cpu_t& GetCPU() { pristine = false; return cpu; }
   const cpu_t& GetCPU() const { return cpu; }
 
   uint32_t GetRegister(size_t reg_id) {
@@ -237,10 +462,54 @@ public:
 
   uint32_t& Reg(size_t reg_id) {
     emp_assert(cpu.HasActiveCore());
+    pristine = false;
     auto& registers = cpu.GetActiveCore().registers;
     return reinterpret_cast<uint32_t&>(registers[reg_id]);
   }
 
+  /**
+   * Input: The checkpoint stream to write to.
+   *
+   * Output: None
+   *
+   * Purpose: Writes this CPU's running state (the active core's registers and
+   * program counter) and its CPUState. The program isn't written here, as
+   * clonal organisms share it (see SGPWorld::SaveCheckpoint).
+   *
+   * NOTE - The instruction library has no fork, terminate, or regulation
+   *        instructions, so a CPU only ever runs the core launched by
+   *        InitializeState, and its global jump table is fully determined by
+   *        the program.
+   */
+  void WriteCheckpoint(CheckpointWriter& out) const {
+    emp_assert(cpu.HasActiveCore());
+    const auto& core = cpu.GetActiveCore();
+    for (size_t reg_id = 0; reg_id < spec_t::num_registers; ++reg_id) {
+      out.Write(*reinterpret_cast<const uint32_t*>(&core.registers[reg_id]));
+    }
+    out.Write<uint64_t>(core.GetProgramCounter());
+    state.WriteCheckpoint(out);
+  }
+
+  /**
+   * Input: The checkpoint stream to read from.
+   *
+   * Output: Whether the CPU was restored.
+   *
+   * Purpose: Restores running state written by WriteCheckpoint on a CPU that
+   * already has the same program.
+   */
+  bool ReadCheckpoint(CheckpointReader& in) {
+    for (size_t reg_id = 0; reg_id < spec_t::num_registers; ++reg_id) {
+      Reg(reg_id) = in.Read<uint32_t>();
+    }
+    const size_t program_counter = in.Read<uint64_t>();
+    if (program_counter > program->size()) in.Fail();
+    if (!in.Ok()) return false;
+    cpu.GetActiveCore().JumpToIndex(program_counter);
+    return state.ReadCheckpoint(in);
+  }
+
   /**
    * Input: None
    *
@@ -254,7 +523,7 @@ public:
     // TODO - refactor internal/external dependencies of these functions
     //        could also consider shifting this functionality outside of this
     //        class and into a utilities file.
-    for (auto i : program) {
+    for (auto i : *program) {
       PrintOp(
         i,
         lib_info::arities,
@@ -5,6 +5,9 @@
 // #include "sgpl/spec/Spec.hpp"
 // #include "sgpl/utility/ThreadLocalRandom.hpp"
 
+#include "Stacks.h"
+#include "../org_type_info.h"
+
 #include "emp/matching/matchbin_metrics.hpp"
 #include "emp/matching/MatchDepository.hpp"
 #include "emp/matching/regulators/PlusCountdownRegulator.hpp"
@@ -96,6 +99,14 @@ struct SGPHardwareSpec {
   /// How many registers should each virtual core contain?
   static constexpr inline size_t num_registers{ 8 };
 
+  /// How many stacks should each CPUState have, and how deep can they get?
+  static constexpr inline size_t num_stacks{ 2 };
+  static constexpr inline size_t stack_capacity{ org_info::DEFAULT_STACK_SIZE_LIMIT };
+
+  /// What stack implementation should CPUState use? InlineStacks keeps stack
+  /// memory inside the CPUState; Stacks<uint32_t> uses (unbounded) heap vectors.
+  using stacks_t = InlineStacks<uint32_t, num_stacks, stack_capacity>;
+
   /// Maximum num steps executed on one core before next core is executed.
   static constexpr inline size_t switch_steps{ 8 };
 
@@ -3,8 +3,11 @@
 #include "emp/base/vector.hpp"
 #include "emp/base/array.hpp"
 
+#include <algorithm>
+#include <array>
 #include <limits>
 #include <optional>
+#include <span>
 
 namespace sgpmode {
 
@@ -59,6 +62,13 @@ public:
     return stacks[active_stack];
   }
 
+  const stack_t& GetStack(size_t stack_id) const {
+    emp_assert(stack_id < stacks.size());
+    return stacks[stack_id];
+  }
+
+  size_t GetActiveID() const { return active_stack; }
+
   // Change active stack to next stack.
   void ChangeActive() {
     active_stack = (++active_stack >= stacks.size()) ? 0 : active_stack;
@@ -102,4 +112,102 @@ public:
 
 };
 
-}
\ No newline at end of file
+/**
+ * Fixed-capacity version of Stacks with the same interface. All stack memory
+ * lives inside the object (no heap allocation), so a CPUState holding it
+ * needs no extra allocations and Push/Pop don't chase a pointer.
+ * The hardware spec chooses which stack implementation CPUState uses.
+ *
+ * NOTE - Stack limits can be lowered with SetStackLimit, but never raised
+ *        above CAPACITY.
+ */
+template<typename T, size_t NUM_STACKS, size_t CAPACITY>
+class InlineStacks {
+public:
+  using stack_t = std::span<const T>;
+protected:
+  std::array<std::array<T, CAPACITY>, NUM_STACKS> stacks{};
+  std::array<size_t, NUM_STACKS> sizes{};
+  size_t active_stack = 0;
+  size_t stack_size_limit = CAPACITY;
+
+public:
+  InlineStacks(size_t num_stacks = NUM_STACKS) {
+    emp_assert(num_stacks == NUM_STACKS);
+  }
+
+  // Change stack limit (clamped to CAPACITY). Will resize any stacks larger
+  // than new limit, deleting their top elements.
+  void SetStackLimit(size_t limit) {
+    stack_size_limit = std::min(limit, CAPACITY);
+    for (auto& size : sizes) {
+      size = std::min(size, stack_size_limit);
+    }
+  }
+
+  size_t GetNumStacks() const { return NUM_STACKS; }
+
+  // Clear contents of all stacks
+  void ClearAll() { sizes.fill(0); }
+
+  // Clear contents of active stack
+  void ClearActive() {
+    emp_assert(active_stack < NUM_STACKS);
+    sizes[active_stack] = 0;
+  }
+
+  // Only allow const access to entire stack to ensure stack limit is maintained.
+  stack_t GetActiveStack() const {
+    emp_assert(active_stack < NUM_STACKS);
+    return stack_t(stacks[active_stack].data(), sizes[active_stack]);
+  }
+
+  stack_t GetStack(size_t stack_id) const {
+    emp_assert(stack_id < NUM_STACKS);
+    return stack_t(stacks[stack_id].data(), sizes[stack_id]);
+  }
+
+  size_t GetActiveID() const { return active_stack; }
+
+  // Change active stack to next stack.
+  void ChangeActive() {
+    active_stack = (++active_stack >= NUM_STACKS) ? 0 : active_stack;
+  }
+
+  void SetActive(size_t new_active) {
+    emp_assert(new_active < NUM_STACKS);
+    active_stack = new_active;
+  }
+
+  // Push new value on active stack. Return true if successful, false if not.
+  bool Push(T val) {
+    emp_assert(active_stack < NUM_STACKS);
+    size_t& size = sizes[active_stack];
+    if (size < stack_size_limit) {
+      stacks[active_stack][size++] = val;
+      return true;
+    }
+    return false;
+  }
+
+  // Pop (and return) the top element of the active stack.
+  std::optional<T> Pop() {
+    emp_assert(active_stack < NUM_STACKS);
+    size_t& size = sizes[active_stack];
+    if (size > 0) {
+      return std::optional<T>{stacks[active_stack][--size]};
+    }
+    return std::nullopt;
+  }
+
+  // Return the top element of the active stack.
+  std::optional<T> GetTop() const {
+    const size_t size = sizes[active_stack];
+    return (size > 0) ?
+      std::optional<T>{stacks[active_stack][size - 1]} :
+      std::nullopt;
+  }
+
+};
+
+}
@@ -162,9 +162,32 @@ public:
   const io_bank_t& GetIOBank() const { return io_bank; }
   const LogicTaskSet& GetTaskSet() const { return task_set; }
 
-  void Setup(const std::string& env_filepath, size_t io_bank_size, bool io_unique_outputs) {
+  // Load tasks from env_filepath and build the IO bank. If io_bank_load_path
+  // is given, the bank is loaded from that file (see LogicTaskIOBank::Load)
+  // instead of being generated. Otherwise, a bank of io_bank_size
+  // environments is generated and, if io_bank_save_path is given, saved there
+  // for later runs to load.
+  void Setup(
+    const std::string& env_filepath,
+    size_t io_bank_size,
+    bool io_unique_outputs,
+    const std::string& io_bank_load_path = "",
+    const std::string& io_bank_save_path = ""
+  ) {
     LoadTasks(env_filepath); // Will reset current bank, etc.
+    if (io_bank_load_path != "") {
+      std::string error;
+      if (!io_bank.Load(io_bank_load_path, error)) {
+        std::cout << error << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      return;
+    }
     io_bank.GenerateBank(io_bank_size, io_unique_outputs);
+    if (io_bank_save_path != "" && !io_bank.Save(io_bank_save_path)) {
+      std::cout << "Failed to save task IO bank file: " << io_bank_save_path << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
   }
 
   // NOTE - can have a process output buffer function that triggers signals that world can attach functions to
@@ -218,6 +241,12 @@ void LogicTaskEnvironment::LoadTasks(const std::string& env_filepath) {
       task_set.AddLogicTask(task["name"]);
     }
   }
+  // Task IO banks track the tasks each output is correct for in a bit mask.
+  if (task_set.GetSize() > io_bank_t::MAX_TASKS) {
+    std::cout << "Environment file has " << task_set.GetSize() << " tasks, but at most "
+              << io_bank_t::MAX_TASKS << " tasks are supported: " << env_filepath << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
   // (2) Process shared tasks.
   if (env_json.contains("shared")) {
     auto& shared_tasks = env_json["shared"]["tasks"];
@@ -9,6 +9,15 @@
 #include "emp/datastructs/set_utils.hpp"
 #include "emp/base/Ptr.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <system_error>
 #include <unordered_set>
 #include <unordered_map>
 #include <utility>
@@ -21,7 +30,7 @@
 namespace sgpmode::tasks {
 
 // Bank of L9 instances
-// TODO - save and load functionality
+// Banks can be saved to and loaded from a binary file (see Save / Load).
 class LogicTaskIOBank {
 public:
   using this_t = LogicTaskIOBank;
@@ -33,6 +42,15 @@ public:
   static constexpr input_t MIN_LOGIC_TASK_INPUT = std::numeric_limits<input_t>::min();
   static constexpr input_t MAX_LOGIC_TASK_INPUT = std::numeric_limits<input_t>::max();
   static constexpr size_t MAX_ENV_BUILD_TRIES = 10000;
+  // Maximum number of candidate environments built at once (see GenerateBank).
+  static constexpr size_t MAX_BUILD_BATCH_SIZE = 1024;
+
+  // Bit i is set if output is correct for task i.
+  using task_mask_t = uint64_t;
+  static constexpr size_t MAX_TASKS = 64;
+  // Each task has one IO set (output slot) per input, and organisms track
+  // credited output slots for each task in a 64-bit mask (see CPUState).
+  static constexpr size_t MAX_INPUTS = 64;
 
   // Used by TaskIO struct to associate a set of inputs with their associated output for a task
   struct IOSet {
@@ -57,16 +75,43 @@ public:
     bool is_collision=false;
     bool output_is_zero=false;
 
+    // Compact, immutable output lookup (built once by BuildOutputLookup).
+    // lookup_outputs is sorted and holds each valid output once;
+    // lookup_task_masks[i] holds the tasks for which lookup_outputs[i] is correct.
+    emp::vector<output_t> lookup_outputs;
+    emp::vector<task_mask_t> lookup_task_masks;
+
     // Clear task io
     void Clear() {
       input_buffer.clear();
       valid_outputs.clear();
       correct_outputs.clear();
       task_lookup.clear();
+      lookup_outputs.clear();
+      lookup_task_masks.clear();
       is_collision=false;
       output_is_zero=false;
     }
 
+    // Build compact output lookup from task_lookup. Must be called once all
+    // task outputs have been set.
+    void BuildOutputLookup() {
+      lookup_outputs.clear();
+      lookup_task_masks.clear();
+      lookup_outputs.reserve(task_lookup.size());
+      for (const auto& [output, task_ids] : task_lookup) {
+        lookup_outputs.emplace_back(output);
+      }
+      std::sort(lookup_outputs.begin(), lookup_outputs.end());
+      lookup_task_masks.resize(lookup_outputs.size(), 0);
+      for (size_t i = 0; i < lookup_outputs.size(); ++i) {
+        for (size_t task_id : task_lookup.at(lookup_outputs[i])) {
+          emp_assert(task_id < MAX_TASKS);
+          lookup_task_masks[i] |= (task_mask_t{1} << task_id);
+        }
+      }
+    }
+
     bool operator==(const TaskIO& other) const {
       return std::tie(
         input_buffer, valid_outputs, correct_outputs, task_lookup
@@ -89,11 +134,40 @@ public:
       return task_lookup.at(output);
     }
 
+    // Get mask of all tasks for which output is correct (0 if output is not
+    // correct for any task) in a single probe of the compact output lookup.
+    task_mask_t GetTaskMask(output_t output) const {
+      // Only a handful of outputs per environment (tasks x inputs), so a
+      // branch-free count over the sorted array (which compilers vectorize)
+      // beats both binary search and hashing.
+      const output_t* outputs = lookup_outputs.data();
+      const size_t num_outputs = lookup_outputs.size();
+      size_t pos = 0;
+      for (size_t i = 0; i < num_outputs; ++i) {
+        pos += (outputs[i] < output);
+      }
+      return (pos < num_outputs && outputs[pos] == output) ? lookup_task_masks[pos] : 0;
+    }
+
     // Get number of distinct possible outputs stored for this task
     size_t GetNumTaskOutputs(size_t task_id) const {
       emp_assert(task_id < correct_outputs.size());
       return correct_outputs[task_id].size();
     }
+
+    // Get output slot (index into correct_outputs[task_id]) of the first IO set
+    // for this task that produces the given output. Organisms track which outputs
+    // have been credited by slot.
+    // Returns GetNumTaskOutputs(task_id) if output is not correct for this task.
+    size_t GetOutputSlot(size_t task_id, output_t output) const {
+      emp_assert(task_id < correct_outputs.size());
+      const auto& task_outputs = correct_outputs[task_id];
+      size_t slot = 0;
+      while (slot < task_outputs.size() && task_outputs[slot].output != output) {
+        ++slot;
+      }
+      return slot;
+    }
   };
 
 protected:
@@ -119,7 +193,7 @@ protected:
       task_io.output_is_zero = true;
     }
     task_io.correct_outputs[task_id].emplace_back(io_set);  // Add this input-output pairing for this task
-    task_io.is_collision = emp::Has(task_io.valid_outputs, output_val); // Mark if io contains an output collision.
+    task_io.is_collision |= emp::Has(task_io.valid_outputs, output_val); // Mark if io contains an output collision.
     task_io.valid_outputs.emplace(output_val);                          // Add output value to valid outputs set.
     // Add output value to task lookup (regardless of whether or not we've seen this output value before or it's zero)
     if (emp::Has(task_io.task_lookup, output_val)) {
@@ -131,50 +205,178 @@ protected:
     }
   }
 
-  TaskIO BuildTaskIO(bool unique_outputs, size_t num_inputs_per_task = 4) {
-    TaskIO task_io;
-    task_io.is_collision=false;
-    task_io.output_is_zero=false;
-    bool collision_or_zero_bail = false; // Should we bail because of a collision or zero output?
-    size_t build_tries = 0;
-    // For each task, build IO combinations for num_inputs_per_task inputs
-    do {
-      // Reset task io
-      task_io.Clear();
-      // Prepare correct outputs to hold IO combinations for each task.
-      task_io.correct_outputs.resize(task_set.GetSize(), {});
-      // Build input buffer with random values.
-      auto& input_buffer = task_io.input_buffer;
-      input_buffer.resize(num_inputs_per_task);
-      for (size_t i = 0; i < num_inputs_per_task; ++i) {
-        const input_t rand_in = (input_t)random.GetUInt(
+  // Scratch space for building the bank (see GenerateBank). A batch of
+  // candidate environments is stored column-wise, so that row k holds value k
+  // of every candidate and tasks can be evaluated over whole rows at once.
+  struct BuildArena {
+    size_t batch_size = 0;
+    size_t num_inputs = 0;
+    emp::vector<input_t> inputs;    // Row k: input k of each candidate.
+    emp::vector<output_t> outputs;  // Row (task_id * num_inputs + rotation): task outputs for each candidate.
+    emp::vector<uint8_t> rejected;  // Per candidate: has a collision or zero output?
+    emp::vector<input_t> rotated;   // Scratch for evaluating custom tasks.
+    emp::vector<output_t> sorted;   // Scratch for finding collisions.
+
+    void Resize(size_t a_batch_size, size_t a_num_inputs, size_t num_tasks) {
+      batch_size = a_batch_size;
+      num_inputs = a_num_inputs;
+      inputs.resize(num_inputs * batch_size);
+      outputs.resize(num_tasks * num_inputs * batch_size);
+      rejected.assign(batch_size, 0);
+      rotated.resize(num_inputs);
+      sorted.resize(num_tasks * num_inputs);
+    }
+
+    input_t* InputRow(size_t k) { return inputs.data() + (k * batch_size); }
+    output_t* OutputRow(size_t task_id, size_t rotation) {
+      return outputs.data() + ((task_id * num_inputs + rotation) * batch_size);
+    }
+  };
+
+  // Fill the arena's batch of candidate environments with random inputs,
+  // drawing each candidate's inputs in turn.
+  void DrawCandidateInputs(BuildArena& arena) {
+    for (size_t cand = 0; cand < arena.batch_size; ++cand) {
+      for (size_t k = 0; k < arena.num_inputs; ++k) {
+        arena.InputRow(k)[cand] = (input_t)random.GetUInt(
           this_t::MIN_LOGIC_TASK_INPUT,
           this_t::MAX_LOGIC_TASK_INPUT
         );
-        input_buffer[i] = rand_in;
       }
-      // For each task, generate output values for input pairings
-      for (size_t task_id = 0; (task_id < task_set.GetSize()) && !collision_or_zero_bail; ++task_id) {
+    }
+  }
+
+  // Evaluate every task on every input rotation of every candidate.
+  // I.e., task outputs for all sequential input pairings (not all combinations).
+  void EvaluateCandidates(BuildArena& arena) {
+    const size_t num_inputs = arena.num_inputs;
+    for (size_t task_id = 0; task_id < task_set.GetSize(); ++task_id) {
+      const logic::LogicOp op = task_set.GetLogicOp(task_id);
+      for (size_t rotation = 0; rotation < num_inputs; ++rotation) {
+        // Rotated inputs are just rows of the arena, starting from row `rotation`
+        const bool evaluated = logic::ApplyLogicOp(
+          op,
+          arena.InputRow(rotation),
+          arena.InputRow((rotation + 1) % num_inputs),
+          arena.OutputRow(task_id, rotation),
+          arena.batch_size
+        );
+        if (evaluated) continue;
+        // Not a known logic function, evaluate candidates one at a time.
         const auto& task_def = task_set.GetTaskDef(task_id);
-        for (size_t input_idx = 0; input_idx < input_buffer.size(); ++input_idx) {
-          // Call task function with rotated inputs
-          // I.e., Add input pairings for all sequential inputs (not all combinations)
-          emp::vector<input_t> buffer(input_buffer.size());
-          for (size_t i = 0; i < buffer.size(); ++i) {
-            buffer[i] = input_buffer[(i + input_idx) % buffer.size()];
+        output_t* out = arena.OutputRow(task_id, rotation);
+        for (size_t cand = 0; cand < arena.batch_size; ++cand) {
+          for (size_t i = 0; i < num_inputs; ++i) {
+            arena.rotated[i] = arena.InputRow((i + rotation) % num_inputs)[cand];
           }
-          const output_t task_output = task_def.CalcOutput(buffer);
-          SetTaskOutput(task_io, task_id, IOSet{buffer, task_output});
+          out[cand] = task_def.CalcOutput(arena.rotated);
+        }
+      }
+    }
+  }
+
+  // Mark candidates with a zero output or an output shared by two task IO
+  // sets as rejected.
+  void RejectCandidates(BuildArena& arena) {
+    const size_t batch_size = arena.batch_size;
+    const size_t num_rows = task_set.GetSize() * arena.num_inputs;
+    uint8_t* rejected = arena.rejected.data();
+    for (size_t row = 0; row < num_rows; ++row) {
+      const output_t* out = arena.outputs.data() + (row * batch_size);
+      for (size_t cand = 0; cand < batch_size; ++cand) {
+        rejected[cand] |= (out[cand] == 0);
+      }
+    }
+    for (size_t cand = 0; cand < batch_size; ++cand) {
+      if (rejected[cand]) continue;
+      for (size_t row = 0; row < num_rows; ++row) {
+        arena.sorted[row] = arena.outputs[row * batch_size + cand];
+      }
+      std::sort(arena.sorted.begin(), arena.sorted.end());
+      rejected[cand] = std::adjacent_find(arena.sorted.begin(), arena.sorted.end()) != arena.sorted.end();
+    }
+  }
+
+  // Fill in task_io's inputs and task outputs (but not its output lookup).
+  // Input k is at inputs[k * input_stride], and the output of task_id for
+  // input rotation r is at outputs[(task_id * num_inputs + r) * output_stride].
+  void FillTaskIO(
+    TaskIO& task_io,
+    size_t num_inputs,
+    const input_t* inputs,
+    size_t input_stride,
+    const output_t* outputs,
+    size_t output_stride
+  ) {
+    task_io.Clear();
+    task_io.correct_outputs.resize(task_set.GetSize(), {});
+    task_io.input_buffer.resize(num_inputs);
+    for (size_t k = 0; k < num_inputs; ++k) {
+      task_io.input_buffer[k] = inputs[k * input_stride];
+    }
+    IOSet io_set;
+    io_set.inputs.resize(num_inputs);
+    for (size_t task_id = 0; task_id < task_set.GetSize(); ++task_id) {
+      task_io.correct_outputs[task_id].reserve(num_inputs);
+      for (size_t rotation = 0; rotation < num_inputs; ++rotation) {
+        for (size_t i = 0; i < num_inputs; ++i) {
+          io_set.inputs[i] = task_io.input_buffer[(i + rotation) % num_inputs];
         }
-        // Any collisions?
-        collision_or_zero_bail = unique_outputs && (task_io.is_collision || task_io.output_is_zero);
+        io_set.output = outputs[(task_id * num_inputs + rotation) * output_stride];
+        SetTaskOutput(task_io, task_id, io_set);
       }
-      ++build_tries;
-    } while (collision_or_zero_bail && (build_tries < this_t::MAX_ENV_BUILD_TRIES));
-    emp_assert_warning(build_tries <= this_t::MAX_ENV_BUILD_TRIES, "Failed to build environment with unique, non-zero outputs for each task.");
+    }
+  }
+
+  // Build the environment for candidate cand of the arena.
+  TaskIO MakeTaskIO(BuildArena& arena, size_t cand) {
+    TaskIO task_io;
+    FillTaskIO(
+      task_io,
+      arena.num_inputs,
+      arena.InputRow(0) + cand,
+      arena.batch_size,
+      arena.OutputRow(0, 0) + cand,
+      arena.batch_size
+    );
+    task_io.BuildOutputLookup();
     return task_io;
   }
 
+  // Binary bank file layout (see Save). All values are stored in native byte
+  // order, and every section starts on an 8-byte boundary, so the file can be
+  // read (or memory-mapped) as one block and used in place.
+  //   - FileHeader
+  //   - Task names, each followed by '\n' (padded with '\0' to 8 bytes)
+  //   - Lookup offsets (uint64, num_envs + 1): environment i's output lookup is
+  //     entries [offsets[i], offsets[i+1])
+  //   - Lookup task masks (uint64, one per lookup entry)
+  //   - Inputs (input_t, num_envs x num_inputs)
+  //   - Task outputs (output_t, num_envs x num_tasks x num_inputs), ordered by
+  //     environment, then task, then input rotation
+  //   - Lookup outputs (output_t, one per lookup entry)
+  struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_tasks;
+    uint64_t num_envs;
+    uint64_t num_inputs;
+    uint64_t num_lookup_entries;
+    uint64_t task_names_size; // Including padding
+  };
+  static constexpr char FILE_MAGIC[8] = {'S', 'Y', 'M', 'T', 'I', 'O', 'B', 'K'};
+  static constexpr uint32_t FILE_VERSION = 1;
+
+  static size_t PadTo8(size_t num_bytes) { return (num_bytes + 7) & ~size_t{7}; }
+
+  std::string GetTaskNames() const {
+    std::string names;
+    for (size_t task_id = 0; task_id < task_set.GetSize(); ++task_id) {
+      names += task_set.GetName(task_id) + "\n";
+    }
+    return names;
+  }
+
 public:
 
   LogicTaskIOBank(
@@ -192,20 +394,237 @@ public:
   // Generate count number of task io instances, adding each to the io bank.
   // Each task io is guaranteed to have unique outputs for teach possible task.
   // WARNING - calling this function will delete any existing task ios in this bank, invalidating references to them.
+  //
+  // Candidate environments are drawn, evaluated, and screened for collisions in
+  // batches (see BuildArena). Candidates are then used in the order they were
+  // drawn, and a batch is never larger than the number of environments still
+  // needed, so the bank (and the random number generator's state afterward)
+  // is the same as if candidates had been built and checked one at a time.
   void GenerateBank(size_t count, bool unique_outputs=true, size_t input_buffer_size=4) {
+    emp_assert(input_buffer_size <= MAX_INPUTS, "Input buffer size must be <= 64", input_buffer_size);
+    // Task masks (see TaskIO::GetTaskMask) have one bit per task.
+    if (task_set.GetSize() > MAX_TASKS) {
+      std::cout << "Cannot build a task IO bank for " << task_set.GetSize()
+                << " tasks (at most " << MAX_TASKS << " tasks are supported)." << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
     Clear();
     io_bank.resize(count);
-    for (size_t n = 0; n < count; ++n) {
-      io_bank[n] = BuildTaskIO(unique_outputs, input_buffer_size);
+    BuildArena arena;
+    size_t num_built = 0;
+    size_t build_tries = 0; // Candidates tried for the next environment
+    while (num_built < count) {
+      arena.Resize(
+        std::min(count - num_built, MAX_BUILD_BATCH_SIZE),
+        input_buffer_size,
+        task_set.GetSize()
+      );
+      DrawCandidateInputs(arena);
+      EvaluateCandidates(arena);
+      if (unique_outputs) RejectCandidates(arena);
+      for (size_t cand = 0; cand < arena.batch_size; ++cand) {
+        ++build_tries;
+        if (arena.rejected[cand] && build_tries < MAX_ENV_BUILD_TRIES) continue;
+        emp_assert_warning(!arena.rejected[cand], "Failed to build environment with unique, non-zero outputs for each task.");
+        io_bank[num_built] = MakeTaskIO(arena, cand);
+        ++num_built;
+        build_tries = 0;
+      }
     }
   }
 
+  /**
+   * Input: Path of the file to write.
+   *
+   * Output: Whether the file was written.
+   *
+   * Purpose: Saves this bank (inputs, task outputs, and output lookups) in a
+   * compact binary file that Load can read back in a later run.
+   *
+   * NOTE - The bank file is written to a temporary file first and then
+   *        renamed, so that runs starting at the same time never see a
+   *        partially written bank.
+   */
+  bool Save(const std::string& filepath) const {
+    const size_t num_envs = io_bank.size();
+    const size_t num_tasks = task_set.GetSize();
+    const size_t num_inputs = num_envs ? io_bank[0].input_buffer.size() : 0;
+    std::string task_names = GetTaskNames();
+    task_names.resize(PadTo8(task_names.size()), '\0');
+
+    emp::vector<uint64_t> lookup_offsets(num_envs + 1, 0);
+    for (size_t i = 0; i < num_envs; ++i) {
+      lookup_offsets[i + 1] = lookup_offsets[i] + io_bank[i].lookup_outputs.size();
+    }
+    const size_t num_lookup_entries = lookup_offsets.back();
+    emp::vector<uint64_t> lookup_masks;
+    emp::vector<input_t> inputs;
+    emp::vector<output_t> outputs;
+    emp::vector<output_t> lookup_outputs;
+    lookup_masks.reserve(num_lookup_entries);
+    inputs.reserve(num_envs * num_inputs);
+    outputs.reserve(num_envs * num_tasks * num_inputs);
+    lookup_outputs.reserve(num_lookup_entries);
+    for (const TaskIO& task_io : io_bank) {
+      emp_assert(task_io.input_buffer.size() == num_inputs);
+      inputs.insert(inputs.end(), task_io.input_buffer.begin(), task_io.input_buffer.end());
+      for (size_t task_id = 0; task_id < num_tasks; ++task_id) {
+        // One IO set per input rotation, in order (see FillTaskIO)
+        emp_assert(task_io.correct_outputs[task_id].size() == num_inputs);
+        for (const IOSet& io_set : task_io.correct_outputs[task_id]) {
+          outputs.emplace_back(io_set.output);
+        }
+      }
+      lookup_masks.insert(lookup_masks.end(), task_io.lookup_task_masks.begin(), task_io.lookup_task_masks.end());
+      lookup_outputs.insert(lookup_outputs.end(), task_io.lookup_outputs.begin(), task_io.lookup_outputs.end());
+    }
+
+    FileHeader header{};
+    std::copy(std::begin(FILE_MAGIC), std::end(FILE_MAGIC), header.magic);
+    header.version = FILE_VERSION;
+    header.num_tasks = (uint32_t)num_tasks;
+    header.num_envs = num_envs;
+    header.num_inputs = num_inputs;
+    header.num_lookup_entries = num_lookup_entries;
+    header.task_names_size = task_names.size();
+
+    const std::string tmp_filepath = filepath + ".tmp";
+    {
+      std::ofstream out(tmp_filepath, std::ios::binary | std::ios::trunc);
+      if (!out) return false;
+      auto write_section = [&out](const void* data, size_t num_bytes) {
+        out.write(reinterpret_cast<const char*>(data), (std::streamsize)num_bytes);
+        // Keep sections 8-byte aligned
+        const char padding[8] = {};
+        out.write(padding, (std::streamsize)(PadTo8(num_bytes) - num_bytes));
+      };
+      write_section(&header, sizeof(header));
+      write_section(task_names.data(), task_names.size());
+      write_section(lookup_offsets.data(), lookup_offsets.size() * sizeof(uint64_t));
+      write_section(lookup_masks.data(), lookup_masks.size() * sizeof(uint64_t));
+      write_section(inputs.data(), inputs.size() * sizeof(input_t));
+      write_section(outputs.data(), outputs.size() * sizeof(output_t));
+      write_section(lookup_outputs.data(), lookup_outputs.size() * sizeof(output_t));
+      if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_filepath, filepath, ec);
+    return !ec;
+  }
+
+  /**
+   * Input: Path of a bank file written by Save, and a string to hold an error
+   * message if the bank can't be loaded.
+   *
+   * Output: Whether the bank was loaded.
+   *
+   * Purpose: Replaces this bank with one saved in an earlier run. The saved
+   * bank must have been built for the same tasks (by name, in the same order)
+   * as this bank's task set. Loading a bank doesn't use the random number
+   * generator.
+   * WARNING - invalidates references to existing task ios in this bank.
+   */
+  bool Load(const std::string& filepath, std::string& error) {
+    std::ifstream in(filepath, std::ios::binary | std::ios::ate);
+    if (!in) {
+      error = "Cannot open task IO bank file: " + filepath;
+      return false;
+    }
+    const size_t file_size = (size_t)in.tellg();
+    in.seekg(0);
+    // Read the whole file as one 8-byte aligned block
+    emp::vector<uint64_t> file_data(PadTo8(file_size) / sizeof(uint64_t));
+    in.read(reinterpret_cast<char*>(file_data.data()), (std::streamsize)file_size);
+    if (!in || file_size < sizeof(FileHeader)) {
+      error = "Cannot read task IO bank file: " + filepath;
+      return false;
+    }
+    const char* bytes = reinterpret_cast<const char*>(file_data.data());
+    FileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (!std::equal(std::begin(FILE_MAGIC), std::end(FILE_MAGIC), header.magic)
+        || header.version != FILE_VERSION) {
+      error = "Not a task IO bank file (or an unsupported version): " + filepath;
+      return false;
+    }
+    const size_t num_envs = header.num_envs;
+    const size_t num_inputs = header.num_inputs;
+    const size_t num_tasks = header.num_tasks;
+    const size_t num_lookup_entries = header.num_lookup_entries;
+    if (num_tasks > MAX_TASKS) {
+      error = "Task IO bank file has too many tasks (at most " + std::to_string(MAX_TASKS) + " are supported): " + filepath;
+      return false;
+    }
+    // Section offsets
+    const size_t names_pos = PadTo8(sizeof(FileHeader));
+    const size_t offsets_pos = names_pos + header.task_names_size;
+    const size_t masks_pos = offsets_pos + PadTo8((num_envs + 1) * sizeof(uint64_t));
+    const size_t inputs_pos = masks_pos + PadTo8(num_lookup_entries * sizeof(uint64_t));
+    const size_t outputs_pos = inputs_pos + PadTo8(num_envs * num_inputs * sizeof(input_t));
+    const size_t lookup_pos = outputs_pos + PadTo8(num_envs * num_tasks * num_inputs * sizeof(output_t));
+    const size_t end_pos = lookup_pos + PadTo8(num_lookup_entries * sizeof(output_t));
+    if (end_pos != PadTo8(file_size) || header.task_names_size % 8 != 0) {
+      error = "Task IO bank file is truncated or corrupt: " + filepath;
+      return false;
+    }
+    const std::string saved_names(bytes + names_pos, bytes + names_pos + header.task_names_size);
+    const std::string task_names = GetTaskNames();
+    if (num_tasks != task_set.GetSize() || saved_names.substr(0, task_names.size()) != task_names) {
+      error = "Task IO bank file was built for different tasks: " + filepath;
+      return false;
+    }
+    if (num_inputs > MAX_INPUTS) {
+      error = "Task IO bank file has too many inputs per environment: " + filepath;
+      return false;
+    }
+    const uint64_t* lookup_offsets = reinterpret_cast<const uint64_t*>(bytes + offsets_pos);
+    const uint64_t* lookup_masks = reinterpret_cast<const uint64_t*>(bytes + masks_pos);
+    const input_t* inputs = reinterpret_cast<const input_t*>(bytes + inputs_pos);
+    const output_t* outputs = reinterpret_cast<const output_t*>(bytes + outputs_pos);
+    const output_t* lookup_outputs = reinterpret_cast<const output_t*>(bytes + lookup_pos);
+    for (size_t i = 0; i < num_envs; ++i) {
+      if (lookup_offsets[i] > lookup_offsets[i + 1] || lookup_offsets[i + 1] > num_lookup_entries) {
+        error = "Task IO bank file is truncated or corrupt: " + filepath;
+        return false;
+      }
+    }
+
+    Clear();
+    io_bank.resize(num_envs);
+    for (size_t i = 0; i < num_envs; ++i) {
+      TaskIO& task_io = io_bank[i];
+      FillTaskIO(
+        task_io,
+        num_inputs,
+        inputs + (i * num_inputs),
+        1,
+        outputs + (i * num_tasks * num_inputs),
+        1
+      );
+      task_io.lookup_outputs.assign(
+        lookup_outputs + lookup_offsets[i],
+        lookup_outputs + lookup_offsets[i + 1]
+      );
+      task_io.lookup_task_masks.assign(
+        lookup_masks + lookup_offsets[i],
+        lookup_masks + lookup_offsets[i + 1]
+      );
+      emp_assert(task_io.lookup_outputs.size() == task_io.task_lookup.size());
+    }
+    return true;
+  }
+
   void Clear() {
     io_bank.clear();
   }
 
   size_t GetSize() const { return io_bank.size(); }
 
+  // Number of inputs (and so IO sets per task) in each environment
+  size_t GetNumInputs() const {
+    return io_bank.size() ? io_bank[0].input_buffer.size() : 0;
+  }
+
   const TaskIO& GetIO(size_t i) const {
     emp_assert(i < GetSize());
     return io_bank[i];
@@ -40,18 +40,30 @@ public:
     calc_fun_t calc;
     size_t num_inputs;
     std::string desc;
+    logic::LogicOp op; // Lets the IO bank evaluate the task in bulk (see ApplyLogicOp)
     LogicTaskSpec(
       const std::string& a_name,
       const calc_fun_t& a_calc,
       size_t a_num_inputs,
-      const std::string& a_desc
+      const std::string& a_desc,
+      logic::LogicOp a_op = logic::LogicOp::CUSTOM
     ) :
-      name(a_name), calc(a_calc), num_inputs(a_num_inputs), desc(a_desc)
+      name(a_name), calc(a_calc), num_inputs(a_num_inputs), desc(a_desc), op(a_op)
     { ; }
   };
 
 protected:
 
+  // Logic op for each task id (CUSTOM if not known).
+  emp::vector<logic::LogicOp> task_ops;
+
+  size_t AddSpecTask(const LogicTaskSpec& spec) {
+    const size_t id = AddTask(spec.name, spec.calc, spec.num_inputs, spec.desc);
+    task_ops.resize(id + 1, logic::LogicOp::CUSTOM);
+    task_ops[id] = spec.op;
+    return id;
+  }
+
 
   // Static map of valid pre-defined tasks.
   static const std::map<std::string, LogicTaskSpec> predefined_tasks;
@@ -69,13 +81,7 @@ public:
     std::vector<std::string> unused_names;
     for (const std::string& name : names) {
       if (emp::Has(this_t::predefined_tasks, name)) {
-        auto& task_spec = this_t::predefined_tasks.at(name);
-        AddTask(
-          task_spec.name,
-          task_spec.calc,
-          task_spec.num_inputs,
-          task_spec.desc
-        );
+        AddSpecTask(this_t::predefined_tasks.at(name));
       } else {
         unused_names.emplace_back(name);
       }
@@ -87,23 +93,26 @@ public:
     Add new logic task from given logic task spec.
   */
   size_t AddLogicTask(const LogicTaskSpec& spec) {
-    return AddTask(
-      spec.name,
-      spec.calc,
-      spec.num_inputs,
-      spec.desc
-    );
+    return AddSpecTask(spec);
   }
 
   size_t AddLogicTask(const std::string& name) {
     emp_assert(emp::Has(this_t::predefined_tasks, name));
-    const auto& task_spec = this_t::predefined_tasks.at(name);
-    return AddTask(
-      task_spec.name,
-      task_spec.calc,
-      task_spec.num_inputs,
-      task_spec.desc
-    );
+    return AddSpecTask(this_t::predefined_tasks.at(name));
+  }
+
+  /*
+    Get the logic op computed by a task (CUSTOM if the task wasn't added from a
+    spec with a known op).
+  */
+  logic::LogicOp GetLogicOp(size_t id) const {
+    return (id < task_ops.size()) ? task_ops[id] : logic::LogicOp::CUSTOM;
+  }
+
+  /// Reset the task set.
+  void Clear() {
+    base_t::Clear();
+    task_ops.clear();
   }
 
 };
@@ -122,7 +131,8 @@ const std::map<
         return sgpmode::logic::ECHO(inputs[0]);
       },
       1,
-      "ECHO function"
+      "ECHO function",
+      logic::LogicOp::ECHO
     }
   },
 
@@ -135,7 +145,8 @@ const std::map<
         return logic::NOT(inputs[0]);
       },
       1,
-      "NOT boolean logic function"
+      "NOT boolean logic function",
+      logic::LogicOp::NOT
     }
   },
 
@@ -148,7 +159,8 @@ const std::map<
         return logic::NAND(inputs[0], inputs[1]);
       },
       2,
-      "NAND boolean logic function"
+      "NAND boolean logic function",
+      logic::LogicOp::NAND
     }
   },
 
@@ -161,7 +173,8 @@ const std::map<
         return logic::OR_NOT(inputs[0], inputs[1]);
       },
       2,
-      "OR_NOT boolean logic function"
+      "OR_NOT boolean logic function",
+      logic::LogicOp::OR_NOT
     }
   },
 
@@ -174,7 +187,8 @@ const std::map<
         return logic::AND(inputs[0], inputs[1]);
       },
       2,
-      "AND boolean logic function"
+      "AND boolean logic function",
+      logic::LogicOp::AND
     }
   },
 
@@ -187,7 +201,8 @@ const std::map<
         return logic::OR(inputs[0], inputs[1]);
       },
       2,
-      "OR boolean logic function"
+      "OR boolean logic function",
+      logic::LogicOp::OR
     }
   },
 
@@ -200,7 +215,8 @@ const std::map<
         return logic::AND_NOT(inputs[0], inputs[1]);
       },
       2,
-      "AND_NOT boolean logic function"
+      "AND_NOT boolean logic function",
+      logic::LogicOp::AND_NOT
     }
   },
 
@@ -213,7 +229,8 @@ const std::map<
         return logic::NOR(inputs[0], inputs[1]);
       },
       2,
-      "NOR boolean logic function"
+      "NOR boolean logic function",
+      logic::LogicOp::NOR
     }
   },
 
@@ -226,7 +243,8 @@ const std::map<
         return logic::XOR(inputs[0], inputs[1]);
       },
       2,
-      "XOR boolean logic function"
+      "XOR boolean logic function",
+      logic::LogicOp::XOR
     }
   },
 
@@ -239,7 +257,8 @@ const std::map<
         return logic::EQU(inputs[0], inputs[1]);
       },
       2,
-      "EQU boolean logic function"
+      "EQU boolean logic function",
+      logic::LogicOp::EQU
     }
   }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace sgpmode::logic {
@@ -51,4 +52,29 @@ uint32_t EQU(uint32_t a, uint32_t b) {
 //////////////////////////////////////////////
 // 3-input
 
+//////////////////////////////////////////////
+// Bulk evaluation
+
+// Identifies the functions above (CUSTOM for any other task function).
+enum class LogicOp { CUSTOM = 0, ECHO, NOT, NAND, OR_NOT, AND, OR, AND_NOT, NOR, XOR, EQU };
+
+// Applies op lane-wise over n lanes: out[i] = op(a[i], b[i]) (one-input ops
+// ignore b). These are plain loops over contiguous arrays so that the compiler
+// vectorizes them. Returns false (leaving out untouched) for CUSTOM.
+bool ApplyLogicOp(LogicOp op, const uint32_t* a, const uint32_t* b, uint32_t* out, size_t n) {
+  switch (op) {
+    case LogicOp::ECHO:    for (size_t i = 0; i < n; ++i) out[i] = ECHO(a[i]);          return true;
+    case LogicOp::NOT:     for (size_t i = 0; i < n; ++i) out[i] = NOT(a[i]);           return true;
+    case LogicOp::NAND:    for (size_t i = 0; i < n; ++i) out[i] = NAND(a[i], b[i]);    return true;
+    case LogicOp::OR_NOT:  for (size_t i = 0; i < n; ++i) out[i] = OR_NOT(a[i], b[i]);  return true;
+    case LogicOp::AND:     for (size_t i = 0; i < n; ++i) out[i] = AND(a[i], b[i]);     return true;
+    case LogicOp::OR:      for (size_t i = 0; i < n; ++i) out[i] = OR(a[i], b[i]);      return true;
+    case LogicOp::AND_NOT: for (size_t i = 0; i < n; ++i) out[i] = AND_NOT(a[i], b[i]); return true;
+    case LogicOp::NOR:     for (size_t i = 0; i < n; ++i) out[i] = NOR(a[i], b[i]);     return true;
+    case LogicOp::XOR:     for (size_t i = 0; i < n; ++i) out[i] = XOR(a[i], b[i]);     return true;
+    case LogicOp::EQU:     for (size_t i = 0; i < n; ++i) out[i] = EQU(a[i], b[i]);     return true;
+    default: return false;
+  }
+}
+
 } // end logic namespace
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "../../default_mode/AsyncOutput.h"
+#include "../../default_mode/ColumnarDataFile.h"
+#include "../../default_mode/DataNodes.h"
+#include "../../default_mode/Host.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+TEST_CASE("AsyncWriter runs jobs in order with back-pressure", "[default]"){
+  GIVEN( "a writer with a small queue" ) {
+    AsyncWriter writer(2);
+    REQUIRE(writer.GetCapacity() == 2);
+    emp::vector<size_t> done;
+    for (size_t i = 0; i < 100; ++i) {
+      writer.Push([&done, i]() { done.push_back(i); });
+    }
+    writer.Wait();
+
+    THEN( "every job ran, in the order it was pushed" ) {
+      REQUIRE(done.size() == 100);
+      for (size_t i = 0; i < done.size(); ++i) REQUIRE(done[i] == i);
+      REQUIRE(writer.IsIdle());
+    }
+  }
+
+  GIVEN( "a writer whose queue fills up" ) {
+    AsyncWriter writer(1);
+    std::mutex gate;
+    gate.lock();
+    size_t count = 0;
+    // The first job holds up the writer until the gate opens
+    writer.Push([&gate, &count]() { std::lock_guard<std::mutex> guard(gate); ++count; });
+    writer.Push([&count]() { ++count; });
+    std::thread pusher([&writer, &count]() { writer.Push([&count]() { ++count; }); });
+    // Give the pusher time to find the queue full
+    while (writer.GetBlockedPushes() == 0) std::this_thread::yield();
+    gate.unlock();
+    pusher.join();
+    writer.Stop();
+
+    THEN( "the blocked push waits for space and its job still runs" ) {
+      REQUIRE(writer.GetBlockedPushes() >= 1);
+      REQUIRE(count == 3);
+    }
+  }
+}
+
+TEST_CASE("AsyncDataFile writes the same data as a synchronous data file", "[default]"){
+  auto read_file = [](const std::string & filename) {
+    std::ifstream in_file(filename);
+    return std::string((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+  };
+
+  GIVEN( "a CSV async data file and an emp::DataFile with the same columns" ) {
+    const std::string async_filename = "async_test.data";
+    const std::string sync_filename = "async_test_sync.data";
+    size_t update = 0;
+    double mean = 0;
+    {
+      AsyncWriter writer(4);
+      AsyncDataFile async_file(async_filename, &writer, false);
+      emp::DataFile sync_file(sync_filename);
+      for (emp::DataFile * file : {(emp::DataFile *) &async_file, &sync_file}) {
+        file->AddVar(update, "update", "Update");
+        file->AddVar(mean, "mean", "Mean value");
+        file->AddFun<std::string>([&update](){ return "row" + std::to_string(update); }, "label", "Row label");
+        file->SetTimingRepeat(2);
+        file->PrintHeaderKeys();
+      }
+      for (update = 0; update < 50; ++update) {
+        mean = update * 0.1 - 1;
+        async_file.Update(update);
+        sync_file.Update(update);
+      }
+      async_file.Finish();
+      writer.Stop();
+      // Updates after Finish are ignored
+      async_file.Update();
+    }
+
+    THEN( "the files are identical" ) {
+      const std::string async_contents = read_file(async_filename);
+      REQUIRE(async_contents.substr(0, 31) == "update,mean,label\n0,-1,row0\n2,-");
+      REQUIRE(async_contents == read_file(sync_filename));
+    }
+    std::remove(async_filename.c_str());
+    std::remove(sync_filename.c_str());
+  }
+
+  GIVEN( "a columnar async data file" ) {
+    const std::string filename = "async_test.cols";
+    size_t update = 0;
+    double mean = 0;
+    {
+      AsyncWriter writer(8);
+      AsyncDataFile file(filename, &writer, true);
+      file.AddVar(update, "update", "Update");
+      file.AddVar(mean, "mean", "Mean value");
+      file.PrintHeaderKeys();
+      for (update = 0; update < 2 * columnar::BlockEncoder::BLOCK_ROWS + 3; ++update) {
+        mean = update * 0.5;
+        file.Update();
+      }
+      // The file finishes itself (and waits for the writer) when destroyed
+    }
+
+    ColumnarDataReader reader;
+    std::string error;
+    REQUIRE(reader.Load(filename, error));
+    THEN( "every row is read back exactly" ) {
+      REQUIRE(reader.GetNumColumns() == 2);
+      REQUIRE(reader.GetColumn(1).key == "mean");
+      REQUIRE(reader.GetNumRows() == 2 * columnar::BlockEncoder::BLOCK_ROWS + 3);
+      for (size_t row = 0; row < reader.GetNumRows(); ++row) {
+        REQUIRE(reader.GetDouble(0, row) == row);
+        REQUIRE(reader.GetDouble(1, row) == row * 0.5);
+      }
+    }
+    std::remove(filename.c_str());
+  }
+}
+
+TEST_CASE("SymWorld writes its data files in the background when ASYNC_OUTPUT is on", "[default]"){
+  GIVEN( "a world with ASYNC_OUTPUT on" ) {
+    const std::string filename = "async_test_HostVals.data";
+    const std::string dump_filename = "async_test_OrgDump.data";
+    {
+      emp::Random random(17);
+      SymConfigBase config;
+      config.ASYNC_OUTPUT(1);
+      config.OUTPUT_QUEUE_SIZE(2);
+      SymWorld world(random, &config);
+      world.Resize(4);
+      world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, 0.5), 0);
+      world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, -0.5), 1);
+      world.SetupHostIntValFile(filename);
+      for (size_t i = 0; i < 3; ++i) world.Update();
+      world.WriteOrgDumpFile(dump_filename);
+      REQUIRE(world.GetOutputWriter() != nullptr);
+      // The world finishes its output when destroyed
+    }
+
+    std::ifstream data_file(filename);
+    std::ifstream dump_file(dump_filename);
+    THEN( "every row is in the files" ) {
+      std::string line;
+      size_t lines = 0;
+      while (std::getline(data_file, line)) ++lines;
+      REQUIRE(lines == 4); // header and three updates
+      lines = 0;
+      while (std::getline(dump_file, line)) ++lines;
+      REQUIRE(lines == 3); // header and two hosts
+    }
+    std::remove(filename.c_str());
+    std::remove(dump_filename.c_str());
+  }
+}
@@ -0,0 +1,106 @@
+#include "../../default_mode/ColumnarDataFile.h"
+#include "../../default_mode/DataNodes.h"
+#include "../../default_mode/Host.h"
+
+#include <cstdio>
+
+TEST_CASE("ColumnarDataFile round-trips columns through ColumnarDataReader", "[default]"){
+  GIVEN( "a columnar data file with integer, floating-point, and text columns" ) {
+    const std::string filename = "columnar_test.cols";
+    size_t update = 0;
+    int change = 0;
+    double mean = 0;
+    {
+      ColumnarDataFile file(filename);
+      file.AddVar(update, "update", "Update");
+      file.AddVar(change, "change", "Signed change");
+      file.AddVar(mean, "mean", "Mean value");
+      file.AddFun<std::string>([&update](){ return "row" + std::to_string(update); }, "label", "Row label");
+      file.PrintHeaderKeys();
+      // Enough rows for several blocks
+      for (update = 0; update < 3 * ColumnarDataFile::BLOCK_ROWS + 5; ++update) {
+        change = (update % 2) ? -(int)update : (int)update;
+        mean = update * 0.1;
+        file.Update();
+      }
+    }
+
+    ColumnarDataReader reader;
+    std::string error;
+    REQUIRE(reader.Load(filename, error));
+
+    THEN( "the schema matches the columns that were added" ) {
+      REQUIRE(reader.GetNumColumns() == 4);
+      REQUIRE(reader.GetColumn(0).key == "update");
+      REQUIRE(reader.GetColumn(0).desc == "Update");
+      REQUIRE(reader.GetColumn(0).type == columnar::ColumnType::UINT);
+      REQUIRE(reader.GetColumn(1).type == columnar::ColumnType::INT);
+      REQUIRE(reader.GetColumn(2).type == columnar::ColumnType::FLOAT);
+      REQUIRE(reader.GetColumn(3).type == columnar::ColumnType::TEXT);
+      REQUIRE(reader.FindColumn("mean") == 2);
+      REQUIRE(reader.FindColumn("missing") == reader.GetNumColumns());
+    }
+    THEN( "every row is read back exactly" ) {
+      REQUIRE(reader.GetNumRows() == 3 * ColumnarDataFile::BLOCK_ROWS + 5);
+      for (size_t row = 0; row < reader.GetNumRows(); ++row) {
+        REQUIRE(reader.GetDouble(0, row) == row);
+        REQUIRE(reader.GetDouble(1, row) == ((row % 2) ? -(double)row : (double)row));
+        REQUIRE(reader.GetDouble(2, row) == row * 0.1);
+        REQUIRE(reader.GetText(3, row) == "row" + std::to_string(row));
+      }
+    }
+    THEN( "it converts to the CSV an emp::DataFile would have written" ) {
+      std::ostringstream csv;
+      reader.WriteCSV(csv);
+      const std::string expected_start = "update,change,mean,label\n0,0,0,row0\n1,-1,0.1,row1\n2,2,0.2,row2\n";
+      REQUIRE(csv.str().substr(0, expected_start.size()) == expected_start);
+    }
+    std::remove(filename.c_str());
+  }
+
+  GIVEN( "a file that is not a columnar data file" ) {
+    const std::string filename = "columnar_test_bad.cols";
+    {
+      std::ofstream out_file(filename);
+      out_file << "update,mean\n0,0.5\n";
+    }
+    ColumnarDataReader reader;
+    std::string error;
+    THEN( "it can't be read" ) {
+      REQUIRE(!reader.Load(filename, error));
+      REQUIRE(error != "");
+    }
+    std::remove(filename.c_str());
+  }
+}
+
+TEST_CASE("SymWorld writes data files in the configured DATA_FILE_FORMAT", "[default]"){
+  GIVEN( "a world configured for columnar data files" ) {
+    const std::string filename = "columnar_test_HostVals.data";
+    const std::string columnar_filename = ColumnarDataFile::GetFilename(filename);
+    REQUIRE(columnar_filename == "columnar_test_HostVals.cols");
+    {
+      emp::Random random(17);
+      SymConfigBase config;
+      config.DATA_FILE_FORMAT("columnar");
+      SymWorld world(random, &config);
+      world.Resize(4);
+      world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, 0.5), 0);
+      world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, -0.5), 1);
+      world.SetupHostIntValFile(filename);
+      for (size_t i = 0; i < 3; ++i) world.Update();
+      // The world closes its files (writing the last block) when destroyed
+    }
+
+    ColumnarDataReader reader;
+    std::string error;
+    REQUIRE(reader.Load(columnar_filename, error));
+    THEN( "the file has the same columns as the CSV version" ) {
+      REQUIRE(reader.GetNumRows() == 3);
+      REQUIRE(reader.GetColumn(0).key == "update");
+      REQUIRE(reader.GetColumn(1).key == "mean_intval");
+      REQUIRE(reader.GetDouble(1, 0) == 0);
+    }
+    std::remove(columnar_filename.c_str());
+  }
+}
@@ -1095,4 +1095,37 @@ TEST_CASE("GetHostTagPermissiveness", "[default]") {
       }
     }
   }
+}
+TEST_CASE("Data nodes are only recalculated on data node interval updates", "[default]"){
+  GIVEN( "a world with a data node interval of 2" ) {
+    emp::Random random(17);
+    SymConfigBase config;
+    int int_val = 0;
+    SymWorld world(random, &config);
+    world.Resize(4);
+    world.SetDataNodeInterval(2);
+
+    emp::DataMonitor<int>& host_count_node = world.GetHostCountDataNode();
+    world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, int_val), 0);
+
+    WHEN("the world updates on a collection update"){
+      world.Update(); // update 0
+      THEN("the data node is recalculated"){
+        REQUIRE(host_count_node.GetTotal() == 1);
+      }
+
+      WHEN("hosts are added and the world updates between collection updates"){
+        world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, int_val), 1);
+        world.Update(); // update 1
+        THEN("the data node keeps its previous values"){
+          REQUIRE(host_count_node.GetTotal() == 1);
+        }
+
+        world.Update(); // update 2
+        THEN("the data node is recalculated on the next collection update"){
+          REQUIRE(host_count_node.GetTotal() == 2);
+        }
+      }
+    }
+  }
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "../../default_mode/SymWorld.h"
+#include "../../default_mode/Host.h"
+#include "../../default_mode/Symbiont.h"
+
+#include <thread>
+
+TEST_CASE("OrganismPool recycles organism memory", "[default]"){
+  GIVEN( "a world" ) {
+    emp::Random random(17);
+    SymConfigBase config;
+    SymWorld world(random, &config);
+    OrganismPool& pool = OrganismPool::Get();
+
+    WHEN("a host is deleted"){
+      emp::Ptr<Host> host = emp::NewPtr<Host>(&random, &world, &config, 0.5);
+      Host* old_address = host.Raw();
+      size_t num_free = pool.GetNumFree(sizeof(Host));
+      emp::Ptr<Organism> org = host;
+      org.Delete(); // deleted through the base class, like the graveyard does
+
+      THEN("its memory is put on the free list for its size"){
+        REQUIRE(pool.GetNumFree(sizeof(Host)) == num_free + 1);
+      }
+      THEN("the next host reuses it"){
+        emp::Ptr<Host> new_host = emp::NewPtr<Host>(&random, &world, &config, -0.5);
+        REQUIRE(new_host.Raw() == old_address);
+        REQUIRE(pool.GetNumFree(sizeof(Host)) == num_free);
+        REQUIRE(new_host->GetIntVal() == -0.5);
+        new_host.Delete();
+      }
+    }
+
+    WHEN("symbionts are deleted by their host"){
+      emp::Ptr<Host> host = emp::NewPtr<Host>(&random, &world, &config, 0.5);
+      host->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, 0.1));
+      size_t num_free = pool.GetNumFree(sizeof(Symbiont));
+      host.Delete();
+      THEN("their memory is recycled too"){
+        REQUIRE(pool.GetNumFree(sizeof(Symbiont)) == num_free + 1);
+      }
+    }
+
+    WHEN("a host is deleted on a different thread than it was built on"){
+      emp::Ptr<Host> host = emp::NewPtr<Host>(&random, &world, &config, 0.5);
+      Host* old_address = host.Raw();
+      size_t num_free = pool.GetNumFree(sizeof(Host));
+      std::thread([host]() mutable { host.Delete(); }).join();
+
+      THEN("its memory is recycled for the next host on this thread"){
+        REQUIRE(pool.GetNumFree(sizeof(Host)) == num_free + 1);
+        emp::Ptr<Host> new_host = emp::NewPtr<Host>(&random, &world, &config, -0.5);
+        REQUIRE(new_host.Raw() == old_address);
+        new_host.Delete();
+      }
+    }
+  }
+}
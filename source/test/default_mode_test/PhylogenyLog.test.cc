@@ -0,0 +1,197 @@
+#include "../../default_mode/PhylogenyLog.h"
+#include "../../default_mode/DataNodes.h"
+#include "../../default_mode/Host.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <tuple>
+
+TEST_CASE("PhylogenyLog rebuilds the snapshots the systematics would have written", "[default]") {
+  emp::Random random(17);
+  SymConfigBase config;
+  config.MUTATION_RATE(0);
+  config.PHYLOGENY(1);
+  config.PHYLOGENY_TAXON_TYPE(3);
+  config.PHYLOGENY_LOG(1);
+  config.FILE_PATH("");
+  config.FILE_NAME("_phylolog_test");
+  config.SEED(17);
+  const std::string host_log_filename = "HostPhylogenyLog_phylolog_test_SEED17.phylolog";
+  const std::string sym_log_filename = "SymPhylogenyLog_phylolog_test_SEED17.phylolog";
+
+  // id -> (parent id + 1, info, num_orgs, num_offspring) of every taxon a
+  // full snapshot would have
+  using taxa_t = std::map<size_t, std::tuple<size_t, double, size_t, size_t>>;
+  emp::vector<taxa_t> expected;
+  emp::vector<size_t> expected_ancestors;
+  {
+    SymWorld world(random, &config);
+    world.Resize(5);
+    REQUIRE(world.GetHostPhylogenyLog() != nullptr);
+    REQUIRE(world.GetHostPhylogenyLog()->GetFilename() == host_log_filename);
+    auto host_sys = world.GetHostSys();
+
+    auto record_expected = [&]() {
+      taxa_t taxa;
+      auto add_taxa = [&taxa](const auto & set) {
+        for (auto t : set) {
+          taxa[t->GetID()] = {t->GetParent() ? t->GetParent()->GetID() + 1 : 0, t->GetInfo(), t->GetNumOrgs(), t->GetNumOff()};
+        }
+      };
+      add_taxa(host_sys->GetActive());
+      add_taxa(host_sys->GetAncestors());
+      expected.push_back(taxa);
+      expected_ancestors.push_back(host_sys->GetNumAncestors());
+    };
+
+    emp::Ptr<Organism> host_grandparent = emp::NewPtr<Host>(&random, &world, &config, 0);
+    emp::Ptr<Organism> host_parent = host_grandparent->Reproduce();
+    emp::Ptr<Organism> host = host_parent->Reproduce();
+    emp::WorldPosition grandparent_pos = emp::WorldPosition(0, 0);
+    world.AddOrgAt(host_grandparent, grandparent_pos);
+    emp::WorldPosition parent_pos = world.DoBirth(host_parent, grandparent_pos);
+    emp::WorldPosition pos = world.DoBirth(host, parent_pos);
+
+    world.WritePhylogenyFile("phylolog_test.data");
+    record_expected();
+
+    // The tip's ancestors die, but stay in the phylogeny
+    world.DoDeath(grandparent_pos);
+    world.DoDeath(parent_pos);
+    world.Update();
+    world.WritePhylogenyFile("phylolog_test.data");
+    record_expected();
+
+    // The whole lineage dies and is pruned, and an unrelated host appears
+    world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, 0.5), emp::WorldPosition(4, 0));
+    world.DoDeath(pos);
+    world.Update();
+    world.WritePhylogenyFile("phylolog_test.data");
+    record_expected();
+
+    REQUIRE(world.GetHostPhylogenyLog()->GetNumSnapshots() == 3);
+    REQUIRE(world.GetHostPhylogenyLog()->GetBufferedBytes() == 0);
+  }
+
+  PhylogenyLogReader reader;
+  std::string error;
+  REQUIRE(reader.Load(host_log_filename, error));
+
+  THEN("Every snapshot has the same taxa as the systematics did") {
+    REQUIRE(reader.GetNumSnapshots() == 3);
+    REQUIRE(reader.GetSnapshotUpdate(0) == 0);
+    REQUIRE(reader.GetSnapshotUpdate(2) == 2);
+    REQUIRE(reader.GetColumnKey(0) == "info");
+    for (size_t snapshot = 0; snapshot < reader.GetNumSnapshots(); ++snapshot) {
+      taxa_t rebuilt;
+      size_t extinct = 0;
+      for (const auto & taxon : reader.GetSnapshot(snapshot)) {
+        rebuilt[taxon.id] = {taxon.has_parent ? taxon.parent_id + 1 : 0, taxon.values[0], taxon.counts[0], taxon.counts[2]};
+        if (taxon.destruction_time != std::numeric_limits<double>::infinity()) ++extinct;
+      }
+      REQUIRE(rebuilt == expected[snapshot]);
+      REQUIRE(extinct == expected_ancestors[snapshot]);
+    }
+    REQUIRE(expected[0].size() == 3);
+    REQUIRE(expected_ancestors[1] == 2);
+  }
+  THEN("A snapshot can be found by update and written as CSV") {
+    REQUIRE(reader.FindSnapshot(1) == 1);
+    REQUIRE(reader.FindSnapshot(100) == 2);
+    std::ostringstream csv;
+    reader.WriteSnapshotCSV(0, csv);
+    const std::string expected_header = "info,mean_int_val,id,ancestor_list,origin_time,destruction_time,num_orgs,tot_orgs,num_offspring,total_offspring\n";
+    REQUIRE(csv.str().substr(0, expected_header.size()) == expected_header);
+    REQUIRE(csv.str().find("[NONE]") != std::string::npos);
+  }
+  THEN("A truncated log can't be read") {
+    std::string contents;
+    {
+      std::ifstream in_file(host_log_filename, std::ios::binary);
+      contents.assign((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+    }
+    {
+      std::ofstream out_file(host_log_filename, std::ios::binary | std::ios::trunc);
+      // Cut off the last snapshot record
+      out_file.write(contents.data(), contents.size() - 1);
+    }
+    PhylogenyLogReader truncated_reader;
+    REQUIRE(!truncated_reader.Load(host_log_filename, error));
+    REQUIRE(error != "");
+  }
+  std::remove(host_log_filename.c_str());
+  std::remove(sym_log_filename.c_str());
+}
+
+// Stands in for an emp::Systematics taxon
+struct TestTaxon {
+  size_t id = 0;
+  size_t num_orgs = 1;
+  size_t num_offspring = 0;
+  double value = 0;
+  double destruction_time = 0;
+  size_t GetID() const { return id; }
+  const TestTaxon* GetParent() const { return nullptr; }
+  double GetOriginationTime() const { return 0; }
+  double GetDestructionTime() const { return destruction_time; }
+  size_t GetNumOrgs() const { return num_orgs; }
+  size_t GetTotOrgs() const { return num_orgs; }
+  size_t GetNumOff() const { return num_offspring; }
+  size_t GetTotalOffspring() const { return num_offspring; }
+};
+
+TEST_CASE("PhylogenyLog logs the values living taxa have at each snapshot", "[default]") {
+  const std::string filename = "phylolog_live_test.phylolog";
+  TestTaxon changing{0};
+  TestTaxon unchanged{1};
+  {
+    PhylogenyLog<TestTaxon> log(filename);
+    log.AddColumn([](const TestTaxon& taxon) { return taxon.value; }, "value");
+    log.RecordNew(&changing);
+    log.RecordNew(&unchanged);
+    log.WriteSnapshot(0);
+
+    changing.value = 2.5;
+    changing.num_offspring = 3;
+    log.WriteSnapshot(10);
+    const size_t logged_bytes = std::filesystem::file_size(filename);
+
+    // Nothing changed, so only the snapshot marker (kind and update) is written
+    log.WriteSnapshot(20);
+    REQUIRE(std::filesystem::file_size(filename) == logged_bytes + 2);
+
+    changing.num_orgs = 0;
+    changing.destruction_time = 25;
+    log.RecordExtinct(&changing);
+    log.WriteSnapshot(30);
+  }
+
+  PhylogenyLogReader reader;
+  std::string error;
+  REQUIRE(reader.Load(filename, error));
+  REQUIRE(reader.GetNumSnapshots() == 4);
+  auto find_taxon = [&reader](size_t snapshot, size_t id) {
+    for (const auto & taxon : reader.GetSnapshot(snapshot)) {
+      if (taxon.id == id) return taxon;
+    }
+    return PhylogenyLogReader::Taxon{};
+  };
+
+  THEN("Each snapshot has the values from that snapshot") {
+    REQUIRE(find_taxon(0, 0).values[0] == 0);
+    REQUIRE(find_taxon(0, 0).counts[2] == 0);
+    REQUIRE(find_taxon(1, 0).values[0] == 2.5);
+    REQUIRE(find_taxon(1, 0).counts[2] == 3);
+    REQUIRE(find_taxon(2, 0).values[0] == 2.5);
+    REQUIRE(find_taxon(3, 0).counts[0] == 0);
+    REQUIRE(find_taxon(3, 0).destruction_time == 25);
+    for (size_t snapshot = 0; snapshot < reader.GetNumSnapshots(); ++snapshot) {
+      REQUIRE(find_taxon(snapshot, 1).counts[0] == 1);
+      REQUIRE(find_taxon(snapshot, 1).values[0] == 0);
+    }
+  }
+  std::remove(filename.c_str());
+}
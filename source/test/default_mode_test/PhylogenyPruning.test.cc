@@ -0,0 +1,132 @@
+#include "../../default_mode/PhylogenyPruning.h"
+#include "../../default_mode/DataNodes.h"
+#include "../../default_mode/Host.h"
+
+TEST_CASE("Phylogeny ancestor limits bound the number of ancestor taxa", "[default]") {
+  emp::Random random(17);
+  SymConfigBase config;
+  config.MUTATION_RATE(0);
+  config.PHYLOGENY(1);
+  config.PHYLOGENY_TAXON_TYPE(3);
+  config.PHYLOGENY_PRUNE_INTERVAL(1);
+
+  // Sets up a lineage of three hosts, killing the grandparent during update 1
+  // and the parent during update 2
+  auto run_lineage = [&random, &config](SymWorld & world) {
+    world.Resize(5);
+    emp::Ptr<Organism> host_grandparent = emp::NewPtr<Host>(&random, &world, &config, 0);
+    emp::Ptr<Organism> host_parent = host_grandparent->Reproduce();
+    emp::Ptr<Organism> host = host_parent->Reproduce();
+    emp::WorldPosition grandparent_pos = emp::WorldPosition(0, 0);
+    world.AddOrgAt(host_grandparent, grandparent_pos);
+    emp::WorldPosition parent_pos = world.DoBirth(host_parent, grandparent_pos);
+    world.DoBirth(host, parent_pos);
+    world.Update();
+    world.DoDeath(grandparent_pos);
+    world.Update();
+    world.DoDeath(parent_pos);
+    return host;
+  };
+
+  WHEN("There are no limits") {
+    SymWorld world(random, &config);
+    run_lineage(world);
+    for (size_t i = 0; i < 5; ++i) world.Update();
+    THEN("Every ancestor is kept") {
+      REQUIRE(world.GetHostSys()->GetNumAncestors() == 2);
+      REQUIRE(world.GetHostPhylogenyMemoryUse().removed == 0);
+    }
+  }
+
+  WHEN("Ancestors are limited by age") {
+    config.PHYLOGENY_MAX_ANCESTOR_AGE(2);
+    SymWorld world(random, &config);
+    emp::Ptr<Organism> host = run_lineage(world);
+    world.Update();
+    world.Update();
+    THEN("Only the ancestor that went extinct too long ago is removed") {
+      REQUIRE(world.GetUpdate() == 4);
+      REQUIRE(world.GetHostSys()->GetNumAncestors() == 1);
+      REQUIRE(world.GetHostPhylogenyMemoryUse().removed == 1);
+      REQUIRE(host->GetTaxon()->GetParent() != nullptr);
+    }
+    world.Update();
+    THEN("Later, every ancestor is removed") {
+      REQUIRE(world.GetHostSys()->GetNumAncestors() == 0);
+      REQUIRE(world.GetHostPhylogenyMemoryUse().removed == 2);
+      REQUIRE(host->GetTaxon()->GetParent() == nullptr);
+    }
+  }
+
+  WHEN("Ancestors are limited by depth") {
+    config.PHYLOGENY_MAX_ANCESTOR_DEPTH(1);
+    SymWorld world(random, &config);
+    emp::Ptr<Organism> host = run_lineage(world);
+    for (size_t i = 0; i < 5; ++i) world.Update();
+    THEN("Each living taxon keeps one generation of ancestors") {
+      REQUIRE(world.GetHostSys()->GetNumAncestors() == 1);
+      REQUIRE(world.GetHostPhylogenyMemoryUse().removed == 1);
+      REQUIRE(host->GetTaxon()->GetParent() != nullptr);
+      REQUIRE(host->GetTaxon()->GetParent()->GetParent() == nullptr);
+    }
+  }
+}
+
+TEST_CASE("Coalescing extinct taxa counts them instead of storing them", "[default]") {
+  emp::Random random(17);
+  SymConfigBase config;
+  config.MUTATION_RATE(0);
+  config.PHYLOGENY(1);
+  config.PHYLOGENY_TAXON_TYPE(3);
+  config.STORE_EXTINCT(1);
+
+  for (bool coalesce : {false, true}) {
+    WHEN(std::string("A host with no descendants dies and PHYLOGENY_COALESCE_EXTINCT is ") + (coalesce ? "on" : "off")) {
+      config.PHYLOGENY_COALESCE_EXTINCT(coalesce);
+      SymWorld world(random, &config);
+      world.Resize(5);
+      emp::WorldPosition pos = emp::WorldPosition(0, 0);
+      world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, 0), pos);
+      world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, 0), emp::WorldPosition(1, 0));
+      world.Update();
+      world.DoDeath(pos);
+      world.Update();
+
+      PhylogenyMemoryUse memory = world.GetHostPhylogenyMemoryUse();
+      THEN("Its taxon is stored only without coalescing") {
+        REQUIRE(memory.active == 1);
+        REQUIRE(memory.outside == (coalesce ? 0u : 1u));
+        REQUIRE(memory.coalesced == (coalesce ? 1u : 0u));
+        REQUIRE(memory.GetNumTaxa() == world.GetHostSys()->GetNumTaxa());
+        REQUIRE(memory.bytes > 0);
+      }
+    }
+  }
+}
+
+TEST_CASE("Compacted host taxon data keeps its interactions", "[default]") {
+  datastruct::HostTaxonData data;
+  for (unsigned long long int sym_id = 0; sym_id < 20; ++sym_id) {
+    data.associated_syms[sym_id * 7] = (int)sym_id + 1;
+  }
+  const size_t bytes = data.GetExtraBytes();
+  data.Compact();
+
+  THEN("The interactions are moved into a smaller, sorted flat array") {
+    REQUIRE(data.associated_syms.empty());
+    REQUIRE(data.compact_syms.size() == 20);
+    REQUIRE(std::is_sorted(data.compact_syms.begin(), data.compact_syms.end()));
+    REQUIRE(data.GetExtraBytes() < bytes);
+  }
+  THEN("Every interaction can still be visited") {
+    size_t count = 0;
+    int total = 0;
+    data.ForEachInteraction([&count, &total](unsigned long long int sym_id, int interactions) {
+      REQUIRE(sym_id == (unsigned long long int)(interactions - 1) * 7);
+      ++count;
+      total += interactions;
+    });
+    REQUIRE(count == 20);
+    REQUIRE(total == 210);
+  }
+}
@@ -0,0 +1,171 @@
+#include "../../default_mode/DataNodes.h"
+#include "../../default_mode/Symbiont.h"
+#include "../../default_mode/Host.h"
+
+TEST_CASE("StatsEngine visits hosts, hosted symbionts, and free-living symbionts", "[default]"){
+  GIVEN( "a world with hosts, hosted symbionts, and free-living symbionts" ) {
+    emp::Random random(17);
+    SymConfigBase config;
+    config.FREE_LIVING_SYMS(1);
+    config.SYM_LIMIT(3);
+    SymWorld world(random, &config);
+    world.Resize(4);
+
+    emp::Ptr<Host> host_0 = emp::NewPtr<Host>(&random, &world, &config, 0.5);
+    emp::Ptr<Host> host_2 = emp::NewPtr<Host>(&random, &world, &config, -0.5);
+    world.AddOrgAt(host_0, 0);
+    world.AddOrgAt(host_2, 2);
+    host_0->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, 0.1));
+    host_2->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, 0.3));
+    world.AddOrgAt(emp::NewPtr<Symbiont>(&random, &world, &config, -0.7), emp::WorldPosition(0,0));
+    world.AddOrgAt(emp::NewPtr<Symbiont>(&random, &world, &config, 0.9), emp::WorldPosition(0,3));
+
+    emp::DataMonitor<double> node;
+    StatsEngine engine;
+    size_t channel = engine.AddChannel(node);
+    engine.AddVisitor(channel, [channel](Organism& host, StatsEngine::Emitter& out){
+      out.Emit(channel, host.GetIntVal());
+    }, [channel](Organism&, Organism& sym, StatsEngine::Emitter& out){
+      out.Emit(channel, sym.GetIntVal());
+    }, [channel](Organism& sym, StatsEngine::Emitter& out){
+      out.Emit(channel, sym.GetIntVal());
+    });
+
+    WHEN("the engine runs"){
+      node.AddDatum(100); // should be reset by the pass
+      engine.Run(world.GetPop(), world.GetSymPop());
+      THEN("every organism is visited once, in world position order"){
+        REQUIRE(node.GetCount() == 6);
+        REQUIRE(node.GetCurrent() == 0.9);
+        REQUIRE(node.GetMin() == -0.7);
+        REQUIRE(node.GetMax() == 0.9);
+        REQUIRE(node.GetTotal() == Approx(0.6));
+      }
+    }
+  }
+}
+
+TEST_CASE("StatsEngine visits every block of a large world", "[default]"){
+  GIVEN( "a world with more positions than fit in one block" ) {
+    emp::Random random(17);
+    SymConfigBase config;
+    SymWorld world(random, &config);
+    const size_t world_size = StatsEngine::BLOCK_SIZE * 3 + 5;
+    world.Resize(world_size);
+    for (size_t i = 0; i < world_size; i += 2) {
+      world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, (double) i / world_size), i);
+    }
+
+    emp::DataMonitor<double> node;
+    StatsEngine engine;
+    size_t channel = engine.AddChannel(node);
+    engine.AddHostVisitor(channel, [channel](Organism& host, StatsEngine::Emitter& out){
+      out.Emit(channel, host.GetIntVal());
+    });
+
+    WHEN("the engine runs twice"){
+      engine.Run(world.GetPop(), world.GetSymPop());
+      engine.Run(world.GetPop(), world.GetSymPop());
+      THEN("each pass visits every host once, ending with the last one"){
+        REQUIRE(node.GetCount() == (world_size + 1) / 2);
+        REQUIRE(node.GetCurrent() == (double) (world_size - 1) / world_size);
+      }
+    }
+  }
+}
+
+TEST_CASE("The fused pass fills data nodes the same as a loop over the world per data node", "[default]"){
+  GIVEN( "a populated world" ) {
+    emp::Random random(29);
+    SymConfigBase config;
+    config.FREE_LIVING_SYMS(1);
+    config.SYM_LIMIT(3);
+    SymWorld world(random, &config);
+    const size_t world_size = 1000;
+    world.Resize(world_size);
+    for (size_t i = 0; i < world_size; i++) {
+      if (random.P(0.7)) {
+        emp::Ptr<Host> host = emp::NewPtr<Host>(&random, &world, &config, random.GetDouble(-1, 1));
+        world.AddOrgAt(host, i);
+        size_t num_syms = random.GetUInt(4);
+        for (size_t j = 0; j < num_syms; j++) {
+          host->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, random.GetDouble(-1, 1)));
+        }
+      }
+      if (random.P(0.3)) {
+        world.AddOrgAt(emp::NewPtr<Symbiont>(&random, &world, &config, random.GetDouble(-1, 1)), emp::WorldPosition(0,i));
+      }
+    }
+    const emp::vector<emp::Ptr<Organism>>& pop = world.GetPop();
+    const emp::vector<emp::Ptr<Organism>>& sym_pop = world.GetSymPop();
+
+    // Build each data node's contents with a loop of its own
+    emp::DataMonitor<int> sym_count;
+    emp::DataMonitor<int> uninf_hosts;
+    emp::DataMonitor<double, emp::data::Histogram> host_int_val;
+    host_int_val.SetupBins(-1.0, 1.1, 21);
+    emp::DataMonitor<double, emp::data::Histogram> sym_int_val;
+    sym_int_val.SetupBins(-1.0, 1.1, 21);
+    emp::DataMonitor<double, emp::data::Histogram> sym_infect_chance;
+    sym_infect_chance.SetupBins(0, 1.1, 11);
+    emp::DataMonitor<double, emp::data::Histogram> within_host_variance;
+    emp::DataMonitor<size_t> host_repro_count;
+    emp::DataMonitor<size_t> sym_repro_count;
+    for (size_t i = 0; i < pop.size(); i++) {
+      if (pop[i]) {
+        emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
+        sym_count.AddDatum(syms.size());
+        if (syms.empty()) uninf_hosts.AddDatum(1);
+        host_int_val.AddDatum(pop[i]->GetIntVal());
+        host_repro_count.AddDatum(pop[i]->GetReproCount());
+        emp::vector<double> int_vals;
+        for (emp::Ptr<Organism> sym : syms) {
+          sym_int_val.AddDatum(sym->GetIntVal());
+          sym_infect_chance.AddDatum(sym->GetInfectionChance());
+          sym_repro_count.AddDatum(sym->GetReproCount());
+          int_vals.push_back(sym->GetIntVal());
+        }
+        if (int_vals.size() > 1) within_host_variance.AddDatum(emp::Variance(int_vals));
+        else if (int_vals.size() == 1) within_host_variance.AddDatum(0);
+      }
+      if (sym_pop[i]) {
+        sym_count.AddDatum(1);
+        sym_int_val.AddDatum(sym_pop[i]->GetIntVal());
+        sym_infect_chance.AddDatum(sym_pop[i]->GetInfectionChance());
+      }
+    }
+
+    WHEN("the world's data nodes are filled by the fused pass"){
+      world.GetSymCountDataNode();
+      world.GetUninfectedHostsDataNode();
+      world.GetHostIntValDataNode();
+      world.GetSymIntValDataNode();
+      world.GetSymInfectChanceDataNode();
+      world.GetWithinHostVarianceDataNode();
+      world.GetHostReproCountDataNode();
+      world.GetStatsEngine().Run(pop, sym_pop);
+
+      THEN("every data node holds the same data"){
+        auto require_same = [](auto& node, auto& expected) {
+          REQUIRE(node.GetCount() == expected.GetCount());
+          REQUIRE(node.GetTotal() == expected.GetTotal());
+          REQUIRE(node.GetMin() == expected.GetMin());
+          REQUIRE(node.GetMax() == expected.GetMax());
+          REQUIRE(node.GetCurrent() == expected.GetCurrent());
+        };
+        REQUIRE(sym_count.GetCount() > 0);
+        require_same(world.GetSymCountDataNode(), sym_count);
+        require_same(world.GetUninfectedHostsDataNode(), uninf_hosts);
+        require_same(world.GetHostIntValDataNode(), host_int_val);
+        REQUIRE(world.GetHostIntValDataNode().GetHistCounts() == host_int_val.GetHistCounts());
+        require_same(world.GetSymIntValDataNode(), sym_int_val);
+        REQUIRE(world.GetSymIntValDataNode().GetHistCounts() == sym_int_val.GetHistCounts());
+        require_same(world.GetSymInfectChanceDataNode(), sym_infect_chance);
+        REQUIRE(world.GetSymInfectChanceDataNode().GetHistCounts() == sym_infect_chance.GetHistCounts());
+        require_same(world.GetWithinHostVarianceDataNode(), within_host_variance);
+        require_same(world.GetHostReproCountDataNode(), host_repro_count);
+        require_same(world.GetSymReproCountDataNode(), sym_repro_count);
+      }
+    }
+  }
+}
@@ -0,0 +1,202 @@
+#include "../../default_mode/TagDistanceMatrix.h"
+#include "../../default_mode/DataNodes.h"
+#include "../../default_mode/Host.h"
+#include "../../default_mode/Symbiont.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+TEST_CASE("TagDistanceMatrix computes the same distances as the Hamming metric", "[default]") {
+  emp::Random random(17);
+  emp::HammingMetric<TAG_LENGTH> metric;
+
+  // Enough rows and columns for partial row blocks and column tiles
+  const size_t num_rows = TagDistanceMatrix<TAG_LENGTH>::ROW_BLOCK * 2 + 5;
+  const size_t num_columns = TagDistanceMatrix<TAG_LENGTH>::COL_BLOCK + 7;
+  emp::vector<emp::BitSet<TAG_LENGTH>> row_tags;
+  emp::vector<emp::BitSet<TAG_LENGTH>> column_tags;
+  for (size_t i = 0; i < num_rows; ++i) row_tags.push_back(emp::BitSet<TAG_LENGTH>(random, 0.5));
+  for (size_t i = 0; i < num_columns; ++i) column_tags.push_back(emp::BitSet<TAG_LENGTH>(random, 0.5));
+
+  for (size_t threads : {1, 3}) {
+    WHEN("The matrix is computed with " + std::to_string(threads) + " thread(s)") {
+      TagDistanceMatrix<TAG_LENGTH> matrix;
+      for (auto & tag : row_tags) matrix.AddRow(tag);
+      for (auto & tag : column_tags) matrix.AddColumn(tag);
+      matrix.Compute(threads);
+
+      THEN("Every distance matches") {
+        REQUIRE(matrix.GetNumRows() == num_rows);
+        REQUIRE(matrix.GetNumColumns() == num_columns);
+        size_t mismatches = 0;
+        for (size_t row = 0; row < num_rows; ++row) {
+          for (size_t column = 0; column < num_columns; ++column) {
+            if (matrix.GetDistance(row, column) != metric(row_tags[row], column_tags[column])) ++mismatches;
+          }
+        }
+        REQUIRE(mismatches == 0);
+      }
+    }
+  }
+
+  WHEN("Tags are longer than one word") {
+    emp::HammingMetric<100> long_metric;
+    emp::BitSet<100> row_tag(random, 0.5);
+    emp::BitSet<100> column_tag(random, 0.5);
+    TagDistanceMatrix<100> matrix;
+    matrix.AddRow(row_tag);
+    matrix.AddColumn(column_tag);
+    matrix.AddColumn(row_tag);
+    matrix.Compute();
+    THEN("Every word is counted") {
+      REQUIRE(matrix.GetDistance(0, 0) == long_metric(row_tag, column_tag));
+      REQUIRE(matrix.GetCount(0, 1) == 0);
+    }
+  }
+}
+
+TEST_CASE("Binary tag matrices can be read back", "[default]") {
+  emp::Random random(17);
+  const std::string filename = "tag_matrix_test.tagm";
+  emp::vector<size_t> row_labels = {3, 1, 4};
+  emp::vector<size_t> column_labels = {1, 5, 9, 2, 6, 5, 3, 5};
+
+  // The first two rows are all alike, so they are written as runs
+  TagDistanceMatrix<TAG_LENGTH> matrix;
+  emp::BitSet<TAG_LENGTH> tag(random, 0.5);
+  matrix.AddRow(tag);
+  matrix.AddRow(tag);
+  matrix.AddRow(emp::BitSet<TAG_LENGTH>(random, 0.5));
+  for (size_t i = 0; i < column_labels.size(); ++i) matrix.AddColumn(tag);
+  matrix.Compute();
+
+  std::string binary;
+  matrix.AppendBinary(binary, row_labels, column_labels);
+  {
+    std::ofstream out_file(filename, std::ios::binary);
+    out_file << binary;
+  }
+
+  TagMatrixReader reader;
+  std::string error;
+  REQUIRE(reader.Load(filename, error));
+
+  THEN("The reader has the same labels and distances") {
+    REQUIRE(reader.GetValueKind() == tagmatrix::ValueKind::COUNTS);
+    REQUIRE(reader.GetTagBits() == TAG_LENGTH);
+    REQUIRE(reader.GetNumRows() == row_labels.size());
+    REQUIRE(reader.GetNumColumns() == column_labels.size());
+    REQUIRE(reader.GetRowLabel(2) == 4);
+    REQUIRE(reader.GetColumnLabel(7) == 5);
+    for (size_t row = 0; row < row_labels.size(); ++row) {
+      for (size_t column = 0; column < column_labels.size(); ++column) {
+        REQUIRE(reader.GetDistance(row, column) == matrix.GetDistance(row, column));
+      }
+    }
+  }
+  THEN("The reader writes the same CSV the matrix does") {
+    std::string csv;
+    matrix.AppendCSV(csv, row_labels, column_labels);
+    std::ostringstream read_csv;
+    reader.WriteCSV(read_csv);
+    REQUIRE(read_csv.str() == csv);
+  }
+  THEN("A truncated matrix can't be read") {
+    {
+      std::ofstream out_file(filename, std::ios::binary | std::ios::trunc);
+      out_file.write(binary.data(), binary.size() - 1);
+    }
+    TagMatrixReader truncated_reader;
+    REQUIRE(!truncated_reader.Load(filename, error));
+    REQUIRE(error != "");
+  }
+  std::remove(filename.c_str());
+}
+
+TEST_CASE("WriteTagMatrixFile writes the same matrix in every format", "[default]") {
+  emp::Random random(17);
+  SymConfigBase config;
+  config.GRID_X(3);
+  config.GRID_Y(1);
+  config.SYM_LIMIT(2);
+  config.TAG_MATCHING(1);
+  config.TAG_MATRIX_SAMPLE_PROPORTION(1);
+  const std::string csv_filename = "TagMatrix_test.data";
+  const std::string binary_filename = "TagMatrix_test.tagm";
+
+  auto read_file = [](const std::string & filename) {
+    std::ifstream in_file(filename, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+  };
+
+  for (int tag_metric : {0, 1}) {
+    WHEN("TAG_METRIC is " + std::to_string(tag_metric)) {
+      config.TAG_METRIC(tag_metric);
+      SymWorld world(random, &config);
+      world.Resize(3);
+      for (size_t i = 0; i < 2; ++i) {
+        emp::Ptr<Host> host = emp::NewPtr<Host>(&random, &world, &config, 0);
+        emp::BitSet<TAG_LENGTH> host_tag(random, 0.5);
+        host->SetTag(host_tag);
+        world.AddOrgAt(host, i);
+        for (size_t j = 0; j <= i; ++j) {
+          emp::Ptr<Symbiont> sym = emp::NewPtr<Symbiont>(&random, &world, &config, 0);
+          emp::BitSet<TAG_LENGTH> sym_tag(random, 0.5);
+          sym->SetTag(sym_tag);
+          host->AddSymbiont(sym);
+        }
+      }
+
+      // What the matrix looked like when it was written one pair at a time,
+      // sampling positions with a copy of the world's random number generator
+      auto expected_matrix = [&world]() {
+        emp::Random sample_random = world.GetRandom();
+        emp::vector<size_t> sampled_positions = emp::Choose(sample_random, world.GetSize(), world.GetSize());
+        std::ostringstream expected;
+        expected << ',';
+        for (size_t i : sampled_positions) {
+          if (world.IsOccupied(i)) {
+            for (size_t j = 0; j < world.GetOrg(i).GetSymbionts().size(); ++j) expected << i << ",";
+          }
+        }
+        expected << "\n";
+        for (size_t k : sampled_positions) {
+          if (!world.IsOccupied(k)) continue;
+          expected << k << ',';
+          for (size_t i : sampled_positions) {
+            if (!world.IsOccupied(i)) continue;
+            for (emp::Ptr<Organism> sym : world.GetOrg(i).GetSymbionts()) {
+              expected << (*world.GetTagMetric())(world.GetOrg(k).GetTag(), sym->GetTag()) << ",";
+            }
+          }
+          expected << "\n";
+        }
+        return expected.str();
+      };
+
+      config.TAG_MATRIX_FORMAT("csv");
+      const std::string expected_csv = expected_matrix();
+      world.WriteTagMatrixFile(csv_filename);
+      config.TAG_MATRIX_FORMAT("binary");
+      const std::string expected_binary_csv = expected_matrix();
+      world.WriteTagMatrixFile(csv_filename);
+
+      TagMatrixReader reader;
+      std::string error;
+      REQUIRE(reader.Load(binary_filename, error));
+      std::ostringstream read_csv;
+      reader.WriteCSV(read_csv);
+
+      THEN("The CSV and binary matrices match the per-pair matrix") {
+        REQUIRE(read_file(csv_filename) == expected_csv);
+        REQUIRE(read_csv.str() == expected_binary_csv);
+        REQUIRE(reader.GetNumRows() == 2);
+        REQUIRE(reader.GetNumColumns() == 3);
+        REQUIRE(reader.GetValueKind() == (tag_metric == 0 ? tagmatrix::ValueKind::COUNTS : tagmatrix::ValueKind::DISTANCES));
+      }
+      std::remove(csv_filename.c_str());
+      std::remove(binary_filename.c_str());
+    }
+  }
+}
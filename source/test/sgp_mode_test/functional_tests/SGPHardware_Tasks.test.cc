@@ -71,4 +71,73 @@ TEST_CASE("Ancestor hardware can attempt reproduction and do NOT", "[sgp]") {
   }
 
 
-}
\ No newline at end of file
+}
+
+TEST_CASE("Batched and unbatched CPU execution match for a genome with no interrupting instructions", "[sgp]") {
+  auto run_host = [](bool batch_cpu_exec) {
+    sgpmode::SymConfigSGP config;
+    config.SEED(61);
+    config.POP_SIZE(0);
+    config.START_MOI(0);
+    config.GRID_X(2);
+    config.GRID_Y(2);
+    config.CYCLES_PER_UPDATE(30);
+    config.BATCH_CPU_EXEC(batch_cpu_exec);
+    config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+    config.FILE_PATH("SGPHardware_test_output");
+
+    emp::Random random(config.SEED());
+    world_t world(random, &config);
+    world.Setup();
+
+    // Does tasks, but never reproduces
+    auto& builder = world.GetProgramBuilder();
+    program_t program;
+    builder.AddStartAnchor(program);
+    for (int i = 0; i < 3; i++) {
+      builder.AddTask_NotIO(program);
+      builder.AddTask_NandIO(program);
+    }
+    emp::Ptr<sgp_host_t> host = emp::NewPtr<sgp_host_t>(&random, &world, &config, program);
+    world.AddOrgAt(host, emp::WorldPosition(0, 0));
+    REQUIRE(!host->GetHardware().CanInterruptExec());
+
+    for (int i = 0; i < 10; i++) {
+      world.Update();
+    }
+
+    hardware_t& hw = host->GetHardware();
+    emp::vector<double> results;
+    results.emplace_back(host->GetPoints());
+    results.emplace_back(hw.GetCPUState().GetCPUCyclesSinceRepro());
+    for (size_t task_count : hw.GetCPUState().GetTaskPerformanceCounts()) {
+      results.emplace_back(task_count);
+    }
+    for (size_t reg_id = 0; reg_id < hw_spec_t::num_registers; ++reg_id) {
+      results.emplace_back(hw.GetRegister(reg_id));
+    }
+    return results;
+  };
+
+  const emp::vector<double> unbatched_results = run_host(false);
+  const emp::vector<double> batched_results = run_host(true);
+  REQUIRE(unbatched_results[1] > 0); // The host ran
+  REQUIRE(unbatched_results == batched_results);
+}
+
+TEST_CASE("Hardware running a genome with a reproduce instruction can be interrupted", "[sgp]") {
+  sgpmode::SymConfigSGP config;
+  config.SEED(61);
+  config.POP_SIZE(1);
+  config.START_MOI(0);
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  config.FILE_PATH("SGPHardware_test_output");
+
+  emp::Random random(config.SEED());
+  world_t world(random, &config);
+  world.Setup();
+
+  // The ancestor genome reproduces
+  auto& sgp_host = static_cast<sgp_host_t&>(world.GetOrg(0));
+  REQUIRE(sgp_host.GetHardware().CanInterruptExec());
+}
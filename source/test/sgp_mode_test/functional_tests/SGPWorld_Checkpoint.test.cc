@@ -0,0 +1,187 @@
+#include "../../../sgp_mode/SGPWorld.h"
+#include "../../../sgp_mode/SGPHost.h"
+#include "../../../sgp_mode/SGPWorldSetup.cc"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+/**
+ * This file is dedicated to testing SGPWorld checkpoints (SaveCheckpoint and
+ * LoadCheckpoint)
+ */
+
+TEST_CASE("A restored SGPWorld checkpoint continues the run exactly", "[sgp][sgp-functional]") {
+  const std::string checkpoint_path = "sgp_checkpoint_test.bin";
+
+  auto configure = [](sgpmode::SymConfigSGP& config, size_t thread_count) {
+    config.SEED(17);
+    config.GRID(1);
+    config.GRID_X(10);
+    config.GRID_Y(10);
+    config.POP_SIZE(50);
+    config.START_MOI(1);
+    config.HORIZ_TRANS(1);
+    config.FREE_LIVING_SYMS(1);
+    config.THREAD_COUNT(thread_count);
+    config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  };
+
+  // One record per organism (by position): its genome, followed by its state
+  // and CPU state (registers, program counter, stacks, IO buffers, and task
+  // tracking) as written for a checkpoint
+  auto snapshot = [](sgpmode::SGPWorld& world) {
+    emp::vector<std::string> records;
+    records.emplace_back("update " + std::to_string(world.GetUpdate()) + ", " + std::to_string(world.GetNumOrgs()) + " organisms");
+    auto write_genome = [](sgpmode::CheckpointWriter& out, const auto& program) {
+      out.Write<uint64_t>(program.size());
+      for (const auto& inst : program) {
+        out.Write<uint8_t>(inst.op_code);
+        out.Write(inst.args);
+        out.WriteBits(inst.tag);
+      }
+    };
+    auto record_sym = [&records, &write_genome](const std::string& label, emp::Ptr<Organism> org) {
+      const auto& sym = static_cast<const sgpmode::SGPWorld::sgp_sym_t&>(*org);
+      std::ostringstream record;
+      sgpmode::CheckpointWriter out(record);
+      write_genome(out, *sym.GetHardware().GetSharedProgram());
+      sym.WriteCheckpoint(out);
+      records.emplace_back(label + record.str());
+    };
+    for (size_t pos = 0; pos < world.GetSize(); ++pos) {
+      const std::string label = std::to_string(pos);
+      if (world.IsOccupied(pos)) {
+        auto& host = static_cast<sgpmode::SGPWorld::sgp_host_t&>(world.GetOrg(pos));
+        std::ostringstream record;
+        sgpmode::CheckpointWriter out(record);
+        write_genome(out, host.GetProgram());
+        host.WriteCheckpoint(out);
+        records.emplace_back("host " + label + record.str());
+        for (emp::Ptr<Organism> sym : host.GetSymbionts()) record_sym("hosted sym " + label, sym);
+      }
+      if (world.IsSymPopOccupied(pos)) record_sym("free sym " + label, world.GetSymAt(pos));
+    }
+    return records;
+  };
+
+  // Counts the organisms (or world summaries) that differ between snapshots
+  auto count_mismatches = [](const emp::vector<std::string>& a, const emp::vector<std::string>& b) {
+    size_t mismatches = (a.size() > b.size()) ? a.size() - b.size() : b.size() - a.size();
+    for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
+      if (a[i] != b[i]) ++mismatches;
+    }
+    return mismatches;
+  };
+
+  for (size_t thread_count : {1, 4}) {
+    // Results don't depend on the thread count, so the checkpoint is restored
+    // with a different one
+    const size_t restored_thread_count = (thread_count == 1) ? 4 : 1;
+    WHEN("A world is checkpointed partway through a run with " + std::to_string(thread_count) + " thread(s)") {
+      // Worlds share the main thread's random number generator, so the
+      // original run finishes before the restored world is built.
+      emp::Random random(17);
+      sgpmode::SymConfigSGP config;
+      configure(config, thread_count);
+      sgpmode::SGPWorld world(random, &config);
+      world.Setup();
+      for (size_t i = 0; i < 20; ++i) world.Update();
+      REQUIRE(world.SaveCheckpoint(checkpoint_path));
+      const auto original_checkpointed = snapshot(world);
+      world.Update();
+      const auto original_next_update = snapshot(world);
+      for (size_t i = 0; i < 19; ++i) world.Update();
+      const auto original_run = snapshot(world);
+
+      emp::Random restored_random(17);
+      sgpmode::SymConfigSGP restored_config;
+      configure(restored_config, restored_thread_count);
+      sgpmode::SGPWorld restored_world(restored_random, &restored_config);
+      restored_world.Setup();
+      std::string error;
+      const bool loaded = restored_world.LoadCheckpoint(checkpoint_path, error);
+
+      THEN("The restored world continues from the checkpointed update") {
+        REQUIRE(loaded);
+        REQUIRE(error == "");
+        REQUIRE(restored_world.GetUpdate() == 20);
+        REQUIRE(count_mismatches(snapshot(restored_world), original_checkpointed) == 0);
+      }
+      THEN("Every organism's genome and CPU state match the original run after one more update") {
+        REQUIRE(loaded);
+        restored_world.Update();
+        const auto restored_next_update = snapshot(restored_world);
+        REQUIRE(restored_next_update.size() > 1);
+        REQUIRE(count_mismatches(restored_next_update, original_next_update) == 0);
+      }
+      THEN("Running the restored world matches the original run") {
+        REQUIRE(loaded);
+        for (size_t i = 0; i < 20; ++i) restored_world.Update();
+        REQUIRE(count_mismatches(snapshot(restored_world), original_run) == 0);
+      }
+      std::remove(checkpoint_path.c_str());
+    }
+  }
+
+  WHEN("A checkpoint file is missing or corrupt") {
+    emp::Random random(17);
+    sgpmode::SymConfigSGP config;
+    configure(config, 1);
+    sgpmode::SGPWorld world(random, &config);
+    world.Setup();
+    REQUIRE(world.SaveCheckpoint(checkpoint_path));
+    std::string error;
+
+    THEN("Loading a missing file fails") {
+      REQUIRE(!world.LoadCheckpoint("no_such_sgp_checkpoint.bin", error));
+      REQUIRE(error != "");
+    }
+    THEN("Loading a truncated file fails") {
+      {
+        std::ifstream in_file(checkpoint_path, std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+        in_file.close();
+        std::ofstream out_file(checkpoint_path, std::ios::binary | std::ios::trunc);
+        out_file.write(contents.data(), contents.size() / 2);
+      }
+      REQUIRE(!world.LoadCheckpoint(checkpoint_path, error));
+      REQUIRE(error != "");
+    }
+    THEN("Loading into a world with a different configuration fails") {
+      emp::Random other_random(18);
+      sgpmode::SymConfigSGP other_config;
+      configure(other_config, 1);
+      other_config.SEED(18);
+      sgpmode::SGPWorld other_world(other_random, &other_config);
+      other_world.Setup();
+      REQUIRE(!other_world.LoadCheckpoint(checkpoint_path, error));
+      REQUIRE(error.find("SEED") != std::string::npos);
+      REQUIRE(other_world.GetUpdate() == 0);
+    }
+    THEN("Loading into a world with a different mutation rate fails") {
+      emp::Random other_random(17);
+      sgpmode::SymConfigSGP other_config;
+      configure(other_config, 1);
+      other_config.SGP_MUT_PER_BIT_RATE(0.02);
+      sgpmode::SGPWorld other_world(other_random, &other_config);
+      other_world.Setup();
+      REQUIRE(!other_world.LoadCheckpoint(checkpoint_path, error));
+      REQUIRE(error.find("SGP_MUT_PER_BIT_RATE") != std::string::npos);
+      REQUIRE(other_world.GetUpdate() == 0);
+    }
+    THEN("Loading into a world that only changes output and run length settings works") {
+      emp::Random other_random(17);
+      sgpmode::SymConfigSGP other_config;
+      configure(other_config, 1);
+      other_config.UPDATES(5000);
+      other_config.DATA_INT(7);
+      other_config.CHECKPOINT_INTERVAL(50);
+      sgpmode::SGPWorld other_world(other_random, &other_config);
+      other_world.Setup();
+      REQUIRE(other_world.LoadCheckpoint(checkpoint_path, error));
+      REQUIRE(error == "");
+    }
+    std::remove(checkpoint_path.c_str());
+  }
+}
@@ -0,0 +1,153 @@
+#include "../../../sgp_mode/SGPWorld.h"
+#include "../../../sgp_mode/SGPHost.h"
+#include "../../../sgp_mode/SGPWorldSetup.cc"
+
+/**
+ * This file is dedicated to testing multi-threaded processing of SGPWorld updates
+ */
+
+TEST_CASE("Scheduler splits world into per-thread batches", "[sgp][sgp-functional]") {
+  emp::Random random(2);
+  sgpmode::Scheduler scheduler(random, 10, 3);
+
+  WHEN("The thread count is less than the world size") {
+    THEN("The requested number of threads is used") {
+      REQUIRE(scheduler.GetThreadCount() == 3);
+      REQUIRE(scheduler.IsThreaded());
+      REQUIRE(scheduler.GetScheduleSize() == 10);
+    }
+  }
+
+  WHEN("The thread count is greater than the world size") {
+    scheduler.SetupScheduler(2, 8);
+    THEN("No more threads than world locations are used") {
+      REQUIRE(scheduler.GetThreadCount() == 2);
+      REQUIRE(scheduler.IsThreaded());
+    }
+  }
+
+  WHEN("A single thread is requested") {
+    scheduler.SetupScheduler(10, 1);
+    THEN("The scheduler does not run in threaded mode") {
+      REQUIRE(scheduler.GetThreadCount() == 1);
+      REQUIRE(!scheduler.IsThreaded());
+    }
+  }
+
+  THEN("The main thread is not treated as a scheduler worker outside of Run") {
+    REQUIRE(!sgpmode::Scheduler::InWorker());
+    REQUIRE(sgpmode::Scheduler::GetWorkerID() == 0);
+  }
+}
+
+// Stands in for a world: records the random draws made at each location
+struct RandomDrawRecorder {
+  emp::vector<emp::vector<uint32_t>> draws;
+  emp::vector<int> processed_in_worker;
+
+  RandomDrawRecorder(size_t size) : draws(size), processed_in_worker(size, 0) { ; }
+
+  size_t GetSize() const { return draws.size(); }
+
+  // Each location is only processed by one thread per update, so no locking
+  void ProcessOrgsAt(size_t world_id) {
+    draws[world_id].push_back(sgpl::tlrand.Get().GetUInt());
+    processed_in_worker[world_id] = sgpmode::Scheduler::InWorker();
+  }
+};
+
+TEST_CASE("Scheduler gives each location the same random draws with THREAD_COUNT=1 and THREAD_COUNT>1", "[sgp][sgp-functional]") {
+  const size_t world_size = 37;
+  const size_t updates = 5;
+  auto run_scheduler = [&](size_t thread_count) {
+    emp::Random random(5);
+    sgpmode::Scheduler scheduler(random, world_size, thread_count);
+    RandomDrawRecorder recorder(world_size);
+    for (size_t i = 0; i < updates; ++i) {
+      scheduler.UpdateSchedule();
+      scheduler.Run(recorder);
+    }
+    return recorder;
+  };
+
+  const RandomDrawRecorder serial_run = run_scheduler(1);
+  THEN("Every location is processed once per update, as a worker") {
+    for (size_t world_id = 0; world_id < world_size; ++world_id) {
+      REQUIRE(serial_run.draws[world_id].size() == updates);
+      REQUIRE(serial_run.processed_in_worker[world_id]);
+    }
+    REQUIRE(!sgpmode::Scheduler::InWorker());
+  }
+
+  THEN("Locations don't share random number streams") {
+    REQUIRE(serial_run.draws[0] != serial_run.draws[1]);
+  }
+
+  for (size_t thread_count : {2, 4, 8}) {
+    WHEN("The same schedule is run on " + std::to_string(thread_count) + " threads") {
+      const RandomDrawRecorder threaded_run = run_scheduler(thread_count);
+      THEN("Every location makes the same random draws") {
+        REQUIRE(threaded_run.draws == serial_run.draws);
+        REQUIRE(threaded_run.processed_in_worker == serial_run.processed_in_worker);
+      }
+    }
+  }
+}
+
+TEST_CASE("SGPWorld updates match with THREAD_COUNT=1 and THREAD_COUNT>1 for a given seed", "[sgp][sgp-functional]") {
+  auto run_world = [](size_t thread_count) {
+    emp::Random random(17);
+    sgpmode::SymConfigSGP config;
+    config.SEED(17);
+    config.GRID(1);
+    config.GRID_X(10);
+    config.GRID_Y(10);
+    config.POP_SIZE(50);
+    config.START_MOI(1);
+    config.HORIZ_TRANS(1);
+    config.THREAD_COUNT(thread_count);
+    config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+
+    sgpmode::SGPWorld world(random, &config);
+    world.Setup();
+    for (size_t i = 0; i < 50; ++i) {
+      world.Update();
+    }
+
+    emp::vector<double> summary;
+    summary.emplace_back(world.GetNumOrgs());
+    for (size_t task_successes : world.GetHostTaskSuccesses()) {
+      summary.emplace_back(task_successes);
+    }
+    for (size_t task_successes : world.GetSymTaskSuccesses()) {
+      summary.emplace_back(task_successes);
+    }
+    // Every host's points and symbiont count, by location
+    for (size_t pos = 0; pos < world.GetSize(); ++pos) {
+      if (!world.IsOccupied(pos)) continue;
+      summary.emplace_back(pos);
+      summary.emplace_back(world.GetOrg(pos).GetPoints());
+      summary.emplace_back(world.GetOrg(pos).GetSymbionts().size());
+    }
+    return summary;
+  };
+
+  WHEN("Two worlds are run with the same seed on multiple threads") {
+    const auto first_run = run_world(4);
+    const auto second_run = run_world(4);
+    THEN("They end in the same state") {
+      REQUIRE(first_run == second_run);
+    }
+  }
+
+  for (size_t thread_count : {2, 3, 4}) {
+    WHEN("Worlds with the same seed are run on one thread and on " + std::to_string(thread_count) + " threads") {
+      const auto serial_run = run_world(1);
+      const auto threaded_run = run_world(thread_count);
+      THEN("They end in the same state") {
+        REQUIRE(serial_run.size() > 3);
+        REQUIRE(serial_run == threaded_run);
+      }
+    }
+  }
+}
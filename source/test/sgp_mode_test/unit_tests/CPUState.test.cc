@@ -0,0 +1,108 @@
+#include "../../../sgp_mode/SGPWorld.h"
+#include "../../../sgp_mode/hardware/CPUState.h"
+#include "../../../sgp_mode/tasks/LogicTaskIOBank.h"
+
+#include "../../../catch/catch.hpp"
+
+/**
+ * This file is dedicated to unit tests for CPUState
+ */
+
+TEST_CASE("CPUState credits each task output slot once", "[sgp]") {
+  using cpu_state_t = sgpmode::CPUState<sgpmode::SGPWorld>;
+  using io_bank_t = sgpmode::tasks::LogicTaskIOBank;
+
+  // Task 0 has two IO sets with the same output
+  io_bank_t::TaskIO task_io;
+  task_io.correct_outputs = {
+    {io_bank_t::IOSet({1, 2}, 5), io_bank_t::IOSet({2, 1}, 5), io_bank_t::IOSet({3, 4}, 7)},
+    {io_bank_t::IOSet({1, 2}, 9)}
+  };
+  cpu_state_t cpu_state(nullptr, nullptr, 2);
+
+  THEN("Outputs map to the slot of the first IO set that produces them") {
+    REQUIRE(task_io.GetNumTaskOutputs(0) == 3);
+    REQUIRE(task_io.GetOutputSlot(0, 5) == 0);
+    REQUIRE(task_io.GetOutputSlot(0, 7) == 2);
+    REQUIRE(task_io.GetOutputSlot(1, 9) == 0);
+    // Outputs that aren't correct for the task get the slot past the end
+    REQUIRE(task_io.GetOutputSlot(0, 9) == task_io.GetNumTaskOutputs(0));
+  }
+
+  THEN("Nothing is credited at first") {
+    for (size_t slot = 0; slot < cpu_state_t::MAX_CREDITED_OUTPUT_SLOTS; ++slot) {
+      REQUIRE(!cpu_state.OutputCredited(0, slot));
+    }
+    REQUIRE(cpu_state.GetNumOutputsCredited(0) == 0);
+    REQUIRE(cpu_state.GetNumOutputsCredited(1) == 0);
+  }
+
+  WHEN("A duplicated output is credited twice") {
+    cpu_state.CreditOutput(0, task_io.GetOutputSlot(0, 5));
+    cpu_state.CreditOutput(0, task_io.GetOutputSlot(0, 5));
+    THEN("It only counts once, and only for its task") {
+      REQUIRE(cpu_state.OutputCredited(0, 0));
+      REQUIRE(!cpu_state.OutputCredited(0, 1));
+      REQUIRE(cpu_state.GetNumOutputsCredited(0) == 1);
+      REQUIRE(cpu_state.GetNumOutputsCredited(1) == 0);
+    }
+    cpu_state.CreditOutput(0, task_io.GetOutputSlot(0, 7));
+    THEN("Each distinct output is counted") {
+      REQUIRE(cpu_state.OutputCredited(0, 2));
+      REQUIRE(cpu_state.GetNumOutputsCredited(0) == 2);
+      REQUIRE(cpu_state.GetOutputsCredited(0) == 0b101);
+    }
+  }
+
+  WHEN("The last slot in the mask is credited") {
+    const size_t last_slot = cpu_state_t::MAX_CREDITED_OUTPUT_SLOTS - 1;
+    cpu_state.CreditOutput(1, last_slot);
+    THEN("It is tracked like any other slot") {
+      REQUIRE(cpu_state.OutputCredited(1, last_slot));
+      REQUIRE(!cpu_state.OutputCredited(1, 0));
+      REQUIRE(cpu_state.GetNumOutputsCredited(1) == 1);
+    }
+  }
+
+  WHEN("Credits are reset") {
+    cpu_state.CreditOutput(0, 0);
+    cpu_state.CreditOutput(0, 2);
+    cpu_state.CreditOutput(1, 0);
+    cpu_state.ResetCreditedOutputs(0);
+    THEN("Resetting one task leaves the others") {
+      REQUIRE(cpu_state.GetNumOutputsCredited(0) == 0);
+      REQUIRE(!cpu_state.OutputCredited(0, 2));
+      REQUIRE(cpu_state.OutputCredited(1, 0));
+    }
+    cpu_state.ResetCreditedOutputs();
+    THEN("Resetting every task clears every credit") {
+      REQUIRE(cpu_state.GetNumOutputsCredited(0) == 0);
+      REQUIRE(cpu_state.GetNumOutputsCredited(1) == 0);
+    }
+    cpu_state.CreditOutput(1, 0);
+    cpu_state.ResetTaskPerformance(1);
+    THEN("Resetting a task's performance clears its credits") {
+      REQUIRE(cpu_state.GetNumOutputsCredited(1) == 0);
+    }
+  }
+}
+
+TEST_CASE("Task IO banks fit in organisms' output credit masks", "[sgp]") {
+  emp::Random random(61);
+  sgpmode::SymConfigSGP config;
+  config.GRID_X(2);
+  config.GRID_Y(2);
+  config.TASK_IO_BANK_SIZE(10);
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  sgpmode::SGPWorld world(random, &config);
+  world.Setup();
+
+  const auto& io_bank = world.GetTaskEnv().GetIOBank();
+  REQUIRE(io_bank.GetNumInputs() > 0);
+  REQUIRE(io_bank.GetNumInputs() <= sgpmode::SGPWorld::sgp_cpu_peripheral_t::MAX_CREDITED_OUTPUT_SLOTS);
+  for (size_t env_id = 0; env_id < io_bank.GetSize(); ++env_id) {
+    for (size_t task_id = 0; task_id < world.GetTaskEnv().GetTaskCount(); ++task_id) {
+      REQUIRE(io_bank.GetIO(env_id).GetNumTaskOutputs(task_id) == io_bank.GetNumInputs());
+    }
+  }
+}
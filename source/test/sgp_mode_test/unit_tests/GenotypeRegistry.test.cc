@@ -0,0 +1,94 @@
+#include "../../../sgp_mode/SGPWorld.h"
+#include "../../../sgp_mode/SGPWorld.cc"
+#include "../../../sgp_mode/SGPHost.h"
+#include "../../../sgp_mode/SGPWorldSetup.cc"
+#include "../../../sgp_mode/SGPWorldData.cc"
+#include "../../../sgp_mode/GenotypeRegistry.h"
+#include "../../../catch/catch.hpp"
+
+TEST_CASE("GenotypeRegistry counts programs by content", "[sgp]") {
+  using world_t = sgpmode::SGPWorld;
+  using program_t = world_t::sgp_prog_t;
+
+  emp::Random random(5);
+  sgpmode::SymConfigSGP config;
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  world_t world(random, &config);
+  world.Setup();
+  auto& prog_builder = world.GetProgramBuilder();
+
+  const program_t not_program = prog_builder.CreateNotProgram(100);
+  const program_t nand_program = prog_builder.CreateNandProgram(100);
+  sgpmode::GenotypeRegistry<program_t> registry;
+
+  REQUIRE(registry.HashProgram(not_program) == registry.HashProgram(prog_builder.CreateNotProgram(100)));
+  REQUIRE(registry.HashProgram(not_program) != registry.HashProgram(nand_program));
+
+  const size_t not_id = registry.Add(0, not_program);
+  registry.Add(3, nand_program);
+  registry.Add(5, not_program);
+
+  THEN("Identical programs share a genotype") {
+    REQUIRE(registry.GetNumOrgs() == 3);
+    REQUIRE(registry.GetNumGenotypes() == 2);
+    REQUIRE(registry.GetGenotypeAt(5) == not_id);
+    REQUIRE(registry.GetGenotype(not_id).count == 2);
+    REQUIRE(registry.GetTopGenotypes(1) == emp::vector<size_t>{not_id});
+  }
+
+  WHEN("Organisms are removed or replaced") {
+    registry.Remove(5);
+    registry.Add(0, nand_program);
+    THEN("Counts and representatives follow the living organisms") {
+      REQUIRE(registry.GetNumOrgs() == 2);
+      REQUIRE(registry.GetNumGenotypes() == 1);
+      const size_t nand_id = registry.GetGenotypeAt(3);
+      REQUIRE(registry.GetGenotypeAt(0) == nand_id);
+      REQUIRE(registry.GetGenotype(nand_id).count == 2);
+      const size_t first_pos = registry.GetGenotype(nand_id).first_pos;
+      REQUIRE((first_pos == 0 || first_pos == 3));
+      REQUIRE(registry.GetTopGenotypes(10) == emp::vector<size_t>{nand_id});
+    }
+  }
+}
+
+TEST_CASE("SGPWorld tracks dominant host genotypes", "[sgp]") {
+  using world_t = sgpmode::SGPWorld;
+  using sgp_host_t = world_t::sgp_host_t;
+
+  emp::Random random(5);
+  sgpmode::SymConfigSGP config;
+  config.GRID_X(4);
+  config.GRID_Y(1);
+  config.DOMINANT_COUNT(2);
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  world_t world(random, &config);
+  world.Setup();
+  world.Resize(4);
+  auto& prog_builder = world.GetProgramBuilder();
+
+  world.AddOrgAt(emp::NewPtr<sgp_host_t>(&random, &world, &config, prog_builder.CreateNandProgram(100)), 0);
+  world.AddOrgAt(emp::NewPtr<sgp_host_t>(&random, &world, &config, prog_builder.CreateNotProgram(100)), 1);
+  world.AddOrgAt(emp::NewPtr<sgp_host_t>(&random, &world, &config, prog_builder.CreateNotProgram(100)), 2);
+  world.AddOrgAt(emp::NewPtr<sgp_host_t>(&random, &world, &config, prog_builder.CreateReproProgram(100)), 3);
+
+  WHEN("Dominant hosts are requested") {
+    auto dominant = world.GetDominantInfo();
+    THEN("The most abundant genotype comes first") {
+      REQUIRE(dominant.size() == 2);
+      REQUIRE(dominant[0].second == 2);
+      REQUIRE(*dominant[0].first == *world.GetOrgPtr(1));
+      REQUIRE(dominant[1].second == 1);
+      REQUIRE(*dominant[1].first == *world.GetOrgPtr(0));
+    }
+  }
+
+  WHEN("A host dies") {
+    world.DoDeath(1);
+    THEN("It is no longer counted") {
+      REQUIRE(world.GetHostGenotypes().GetNumOrgs() == 3);
+      REQUIRE(world.GetHostGenotypes().GetNumGenotypes() == 3);
+      REQUIRE(world.GetDominantInfo()[0].first == world.GetOrgPtr(0));
+    }
+  }
+}
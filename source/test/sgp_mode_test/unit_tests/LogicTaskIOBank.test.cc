@@ -0,0 +1,156 @@
+#include "../../../sgp_mode/tasks/LogicTaskIOBank.h"
+
+TEST_CASE("LogicTaskIOBank task masks match task lookup", "[sgp]") {
+  emp::Random random(3);
+  sgpmode::tasks::LogicTaskSet task_set;
+  task_set.AddTasksByName({"NOT", "NAND", "OR_NOT", "AND", "OR", "AND_NOT", "NOR", "XOR", "EQU"});
+  sgpmode::tasks::LogicTaskIOBank io_bank(random, task_set);
+
+  WHEN("Outputs are unique across tasks") {
+    io_bank.GenerateBank(20);
+    THEN("Every correct output maps to exactly the tasks it is correct for") {
+      for (size_t env_id = 0; env_id < io_bank.GetSize(); ++env_id) {
+        const auto& task_io = io_bank.GetIO(env_id);
+        for (const auto& [output, task_ids] : task_io.task_lookup) {
+          sgpmode::tasks::LogicTaskIOBank::task_mask_t expected_mask = 0;
+          for (size_t task_id : task_ids) {
+            expected_mask |= (sgpmode::tasks::LogicTaskIOBank::task_mask_t{1} << task_id);
+          }
+          REQUIRE(task_io.GetTaskMask(output) == expected_mask);
+        }
+      }
+    }
+    THEN("Incorrect outputs map to no tasks") {
+      const auto& task_io = io_bank.GetIO(0);
+      for (size_t i = 0; i < 100; ++i) {
+        const uint32_t output = random.GetUInt();
+        if (task_io.IsValidOutput(output)) continue;
+        REQUIRE(task_io.GetTaskMask(output) == 0);
+      }
+    }
+  }
+
+  WHEN("Outputs may be shared by multiple tasks") {
+    io_bank.GenerateBank(20, false);
+    THEN("Shared outputs map to all of their tasks") {
+      for (size_t env_id = 0; env_id < io_bank.GetSize(); ++env_id) {
+        const auto& task_io = io_bank.GetIO(env_id);
+        for (const auto& [output, task_ids] : task_io.task_lookup) {
+          const auto task_mask = task_io.GetTaskMask(output);
+          for (size_t task_id : task_ids) {
+            REQUIRE((task_mask >> task_id) & 1);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("LogicTaskIOBank builds environments with correct, unique outputs", "[sgp]") {
+  using io_bank_t = sgpmode::tasks::LogicTaskIOBank;
+  emp::Random random(4);
+  sgpmode::tasks::LogicTaskSet task_set;
+  task_set.AddTasksByName({"ECHO", "NOT", "NAND", "OR_NOT", "AND", "OR", "AND_NOT", "NOR", "XOR", "EQU"});
+  // A task without a known logic op is evaluated through its task function.
+  const size_t custom_id = task_set.AddLogicTask(
+    sgpmode::tasks::LogicTaskSet::LogicTaskSpec{
+      "ADD",
+      [](const emp::vector<uint32_t>& inputs) -> uint32_t { return inputs[0] + inputs[1]; },
+      2,
+      "Sum of two inputs"
+    }
+  );
+  REQUIRE(task_set.GetLogicOp(custom_id) == sgpmode::logic::LogicOp::CUSTOM);
+  REQUIRE(task_set.GetLogicOp(task_set.GetID("NAND")) == sgpmode::logic::LogicOp::NAND);
+
+  io_bank_t io_bank(random, task_set);
+  // More environments than fit in a single build batch
+  const size_t bank_size = io_bank_t::MAX_BUILD_BATCH_SIZE + 100;
+  io_bank.GenerateBank(bank_size);
+  REQUIRE(io_bank.GetSize() == bank_size);
+
+  for (size_t env_id = 0; env_id < io_bank.GetSize(); ++env_id) {
+    const auto& task_io = io_bank.GetIO(env_id);
+    REQUIRE(task_io.input_buffer.size() == 4);
+    REQUIRE(!task_io.is_collision);
+    REQUIRE(!task_io.output_is_zero);
+    REQUIRE(task_io.valid_outputs.size() == task_set.GetSize() * 4);
+    for (size_t task_id = 0; task_id < task_set.GetSize(); ++task_id) {
+      const auto& task_outputs = task_io.correct_outputs[task_id];
+      REQUIRE(task_outputs.size() == 4);
+      for (size_t rotation = 0; rotation < 4; ++rotation) {
+        const auto& io_set = task_outputs[rotation];
+        REQUIRE(io_set.inputs[0] == task_io.input_buffer[rotation]);
+        REQUIRE(io_set.output == task_set.GetTaskDef(task_id).CalcOutput(io_set.inputs));
+      }
+    }
+  }
+
+  WHEN("A bank is generated again from the same seed") {
+    emp::Random random2(4);
+    io_bank_t io_bank2(random2, task_set);
+    io_bank2.GenerateBank(bank_size);
+    THEN("It is the same bank") {
+      for (size_t env_id = 0; env_id < io_bank.GetSize(); ++env_id) {
+        REQUIRE(io_bank.GetIO(env_id) == io_bank2.GetIO(env_id));
+      }
+    }
+  }
+}
+
+TEST_CASE("LogicTaskIOBank can be saved and loaded", "[sgp]") {
+  using io_bank_t = sgpmode::tasks::LogicTaskIOBank;
+  const std::string bank_path = "LogicTaskIOBank_test.bin";
+  emp::Random random(6);
+  sgpmode::tasks::LogicTaskSet task_set;
+  task_set.AddTasksByName({"NOT", "NAND", "AND", "XOR"});
+  io_bank_t io_bank(random, task_set);
+  io_bank.GenerateBank(50);
+  REQUIRE(io_bank.Save(bank_path));
+
+  WHEN("The bank is loaded for the same tasks") {
+    io_bank_t loaded_bank(random, task_set);
+    std::string error;
+    REQUIRE(loaded_bank.Load(bank_path, error));
+    THEN("It is the same bank") {
+      REQUIRE(loaded_bank.GetSize() == io_bank.GetSize());
+      for (size_t env_id = 0; env_id < io_bank.GetSize(); ++env_id) {
+        const auto& task_io = io_bank.GetIO(env_id);
+        const auto& loaded_io = loaded_bank.GetIO(env_id);
+        REQUIRE(loaded_io == task_io);
+        REQUIRE(loaded_io.lookup_outputs == task_io.lookup_outputs);
+        REQUIRE(loaded_io.lookup_task_masks == task_io.lookup_task_masks);
+      }
+    }
+  }
+
+  WHEN("The bank is loaded for different tasks") {
+    sgpmode::tasks::LogicTaskSet other_task_set;
+    other_task_set.AddTasksByName({"NOT", "NAND", "AND", "OR"});
+    io_bank_t other_bank(random, other_task_set);
+    std::string error;
+    THEN("Loading fails") {
+      REQUIRE(!other_bank.Load(bank_path, error));
+      REQUIRE(error != "");
+      REQUIRE(other_bank.GetSize() == 0);
+    }
+  }
+
+  WHEN("The bank file has more tasks than task masks can hold") {
+    // num_tasks follows the 8-byte magic and 4-byte version in the header
+    std::fstream bank_file(bank_path, std::ios::binary | std::ios::in | std::ios::out);
+    const uint32_t num_tasks = io_bank_t::MAX_TASKS + 1;
+    bank_file.seekp(12);
+    bank_file.write(reinterpret_cast<const char*>(&num_tasks), sizeof(num_tasks));
+    bank_file.close();
+    io_bank_t loaded_bank(random, task_set);
+    std::string error;
+    THEN("Loading fails with a clear message") {
+      REQUIRE(!loaded_bank.Load(bank_path, error));
+      REQUIRE(error.find("too many tasks") != std::string::npos);
+      REQUIRE(loaded_bank.GetSize() == 0);
+    }
+  }
+
+  std::filesystem::remove(bank_path);
+}
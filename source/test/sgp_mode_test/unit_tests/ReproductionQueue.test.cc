@@ -0,0 +1,57 @@
+#include "../../../sgp_mode/ReproductionQueue.h"
+#include "../../../default_mode/Host.h"
+#include "../../../default_mode/SymWorld.h"
+
+TEST_CASE("ReproductionQueue shards encode queue positions", "[sgp]") {
+  emp::Random random(5);
+  SymConfigBase config;
+  SymWorld world(random, &config);
+  sgpmode::ReproductionQueue queue;
+
+  emp::vector<emp::Ptr<Host>> hosts;
+  for (size_t i = 0; i < 3; ++i) {
+    hosts.emplace_back(emp::NewPtr<Host>(&random, &world, &config, 0));
+  }
+
+  emp::vector<size_t> reproduced;
+  queue.SetReproduceOrgFun([&](sgpmode::ReproEvent& repro_info) {
+    reproduced.emplace_back(repro_info.pos.GetIndex());
+  });
+
+  WHEN("The queue has a single shard") {
+    THEN("Queue positions are indices into the queue") {
+      for (size_t i = 0; i < hosts.size(); ++i) {
+        REQUIRE(queue.Enqueue(hosts[i], {0, i}) == i);
+      }
+      REQUIRE(queue.GetSize() == 3);
+      REQUIRE(queue.GetQueue()[1].org == hosts[1]);
+    }
+  }
+
+  WHEN("The queue has multiple shards and is used outside of a scheduler thread") {
+    queue.SetNumShards(3);
+    emp::vector<size_t> queue_ids;
+    for (size_t i = 0; i < hosts.size(); ++i) {
+      queue_ids.emplace_back(queue.Enqueue(hosts[i], {0, i}));
+    }
+    THEN("Events go to the first shard and positions still decode to them") {
+      REQUIRE(queue.GetNumShards() == 3);
+      REQUIRE(queue.GetQueue(0).size() == 3);
+      REQUIRE(queue.GetQueue(1).size() == 0);
+      for (size_t i = 0; i < hosts.size(); ++i) {
+        REQUIRE(queue.GetEvent(queue_ids[i]).org == hosts[i]);
+      }
+    }
+    THEN("Invalidated events are skipped and the rest are processed in order") {
+      queue.Invalidate(queue_ids[1]);
+      REQUIRE(!queue.GetEvent(queue_ids[1]).valid);
+      queue.Process();
+      REQUIRE(reproduced == emp::vector<size_t>{0, 2});
+      REQUIRE(queue.GetSize() == 0);
+    }
+  }
+
+  for (auto host : hosts) {
+    host.Delete();
+  }
+}
@@ -79,3 +79,47 @@ TEST_CASE("Reset RingBuffer", "[sgp]") {
 }
 
 
+
+TEST_CASE("RingBuffer views contents without copying them", "[sgp]") {
+    const emp::vector<int> contents = {1, 2, 3};
+    sgpmode::RingBuffer<int> buffer;
+    buffer.SetView(contents);
+
+    REQUIRE(buffer.IsView());
+    REQUIRE(buffer.size() == 3);
+    REQUIRE(buffer[1] == 2);
+    REQUIRE(buffer.read() == 1);
+    REQUIRE(buffer.read() == 2);
+    REQUIRE(buffer.read() == 3);
+    REQUIRE(buffer.read() == 1);
+
+    WHEN("The view is copied") {
+        sgpmode::RingBuffer<int> copy(buffer);
+        THEN("The copy views the same contents and keeps its read position") {
+            REQUIRE(copy.IsView());
+            REQUIRE(copy.read() == 2);
+        }
+    }
+
+    WHEN("A value is pushed into the view") {
+        buffer.push(10);
+        THEN("Only the ring buffer's own copy changes") {
+            REQUIRE(!buffer.IsView());
+            REQUIRE(buffer[0] == 10);
+            REQUIRE(buffer[1] == 2);
+            REQUIRE(contents[0] == 1);
+        }
+    }
+
+    WHEN("An owning buffer is copied") {
+        sgpmode::RingBuffer<int> owner(3, 0);
+        owner.push(5);
+        sgpmode::RingBuffer<int> copy(owner);
+        owner.push(6);
+        THEN("The copy has its own storage") {
+            REQUIRE(!copy.IsView());
+            REQUIRE(copy[0] == 5);
+            REQUIRE(copy[1] == 0);
+        }
+    }
+}
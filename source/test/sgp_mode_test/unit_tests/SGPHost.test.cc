@@ -5,6 +5,8 @@
 
 #include "../../../catch/catch.hpp"
 
+#include <utility>
+
 /**
  * This file is dedicated to unit tests for SGPHost
  */
@@ -89,6 +91,93 @@ TEST_CASE("No Mutate", "[sgp]") {
   second_host.Delete();
 }
 
+TEST_CASE("Mutating a new offspring leaves its hardware as a full reset would", "[sgp]") {
+
+  emp::Random random(61);
+  sgpmode::SymConfigSGP config;
+  config.GRID_X(2);
+  config.GRID_Y(2);
+  config.SGP_MUT_PER_BIT_RATE(0.01);
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+
+  world_t world(random, &config);
+  world.Setup();
+  world.Resize(2,2);
+
+  auto& prog_builder = world.GetProgramBuilder();
+
+  // Follow a lineage so that mutations accumulate (including in anchor and
+  // jump instructions).
+  emp::Ptr<sgp_host_t> parent = emp::NewPtr<sgp_host_t>(&random, &world, &config, prog_builder.CreateReproProgram(100));
+  for (int i = 0; i < 50; i++) {
+    emp::Ptr<sgp_host_t> offspring = parent->MakeNew().DynamicCast<sgp_host_t>();
+    const hardware_t& hw = offspring->GetHardware();
+    REQUIRE(hw.IsPristine());
+    offspring->Mutate();
+    REQUIRE(hw.IsPristine());
+
+    // Compare to hardware that resolved every jump from scratch
+    emp::Ptr<sgp_host_t> rebuilt = emp::NewPtr<sgp_host_t>(&random, &world, &config, offspring->GetProgram());
+    REQUIRE(hw.GetCPUState().GetJumpTable() == std::as_const(*rebuilt).GetHardware().GetCPUState().GetJumpTable());
+    REQUIRE(*hw.GetSharedJumpDests() == hw.GetCPUState().GetJumpTable());
+    rebuilt.Delete();
+    parent.Delete();
+    parent = offspring;
+  }
+  parent.Delete();
+
+  THEN("Organisms that have run get a full reset") {
+    emp::Ptr<sgp_host_t> host = emp::NewPtr<sgp_host_t>(&random, &world, &config, prog_builder.CreateReproProgram(100));
+    host->GetHardware().RunCPUStep(10);
+    REQUIRE(!host->GetHardware().IsPristine());
+    host->Mutate();
+    REQUIRE(host->GetHardware().IsPristine());
+    REQUIRE(host->GetHardware().GetCPUState().GetCPUCyclesSinceRepro() == 0);
+    host.Delete();
+  }
+}
+
+TEST_CASE("Offspring share their parent's genome until a mutation changes it", "[sgp]") {
+
+  emp::Random random(61);
+  sgpmode::SymConfigSGP config;
+  config.GRID_X(2);
+  config.GRID_Y(2);
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+
+  world_t world(random, &config);
+  world.Setup();
+  world.Resize(2,2);
+
+  auto& prog_builder = world.GetProgramBuilder();
+  emp::Ptr<sgp_host_t> parent = emp::NewPtr<sgp_host_t>(&random, &world, &config, prog_builder.CreateReproProgram(100));
+  const sgp_host_t::program_t parent_program = parent->GetProgram();
+
+  WHEN("The mutation rate is 0") {
+    world.GetMutator().SetPerBitMutationRate(0.0);
+    emp::Ptr<Organism> offspring = parent->Reproduce();
+    THEN("The offspring uses the parent's genome buffer and jump table") {
+      emp::Ptr<sgp_host_t> sgp_offspring = offspring.DynamicCast<sgp_host_t>();
+      REQUIRE(&sgp_offspring->GetProgram() == &parent->GetProgram());
+      REQUIRE(sgp_offspring->GetHardware().GetSharedJumpDests() == parent->GetHardware().GetSharedJumpDests());
+    }
+    offspring.Delete();
+  }
+
+  WHEN("Every bit is mutated") {
+    world.GetMutator().SetPerBitMutationRate(1.0);
+    emp::Ptr<Organism> offspring = parent->Reproduce();
+    THEN("The offspring gets its own genome and the parent's is unchanged") {
+      emp::Ptr<sgp_host_t> sgp_offspring = offspring.DynamicCast<sgp_host_t>();
+      REQUIRE(&sgp_offspring->GetProgram() != &parent->GetProgram());
+      REQUIRE(sgp_offspring->GetProgram() != parent_program);
+      REQUIRE(parent->GetProgram() == parent_program);
+    }
+    offspring.Delete();
+  }
+  parent.Delete();
+}
+
 TEST_CASE("SGPHost destructor cleans up shared pointers and in-progress reproduction", "[sgp][sgp-unit]") {
     GIVEN("A host"){
         emp::Random random(31);
@@ -0,0 +1,84 @@
+#include "../../../sgp_mode/SGPWorld.h"
+#include "../../../sgp_mode/SGPWorld.cc"
+#include "../../../sgp_mode/SGPWorldSetup.cc"
+#include "../../../sgp_mode/SGPWorldData.cc"
+#include "../../../sgp_mode/SGPMutator.h"
+#include "../../../catch/catch.hpp"
+
+TEST_CASE("SGPMutator reports the instructions it changes", "[sgp]") {
+  using world_t = sgpmode::SGPWorld;
+  using program_t = world_t::sgp_prog_t;
+
+  emp::Random random(7);
+  sgpmode::SymConfigSGP config;
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  world_t world(random, &config);
+  world.Setup();
+  auto& mutator = world.GetMutator();
+  const program_t original = world.GetProgramBuilder().CreateNotProgram(100);
+
+  WHEN("The mutation rate is 0") {
+    mutator.SetPerBitMutationRate(0.0);
+    program_t program(original);
+    THEN("Nothing changes") {
+      REQUIRE(mutator.MutateProgram(program).empty());
+      REQUIRE(program == original);
+    }
+  }
+
+  WHEN("Every bit is mutated") {
+    mutator.SetPerBitMutationRate(1.0);
+    program_t program(original);
+    const emp::vector<size_t> mutated_insts = mutator.MutateProgram(program);
+    THEN("Every instruction changes") {
+      REQUIRE(mutated_insts.size() == program.size());
+      for (size_t i = 0; i < program.size(); ++i) {
+        REQUIRE(mutated_insts[i] == i);
+      }
+    }
+  }
+
+  WHEN("The mutation rate is low") {
+    mutator.SetPerBitMutationRate(0.005);
+    size_t total_mutated = 0;
+    for (size_t trial = 0; trial < 100; ++trial) {
+      program_t program(original);
+      const emp::vector<size_t> mutated_insts = mutator.MutateProgram(program);
+      total_mutated += mutated_insts.size();
+      // Exactly the reported instructions differ, and all are valid
+      size_t next = 0;
+      for (size_t i = 0; i < program.size(); ++i) {
+        const bool reported = next < mutated_insts.size() && mutated_insts[next] == i;
+        if (reported) ++next;
+        const bool changed = !(
+          program[i].op_code == original[i].op_code
+          && program[i].args == original[i].args
+          && program[i].tag == original[i].tag
+        );
+        REQUIRE(reported == changed);
+        for (auto arg : program[i].args) {
+          REQUIRE((size_t)arg < world_t::hw_spec_t::num_registers);
+        }
+      }
+      REQUIRE(next == mutated_insts.size());
+    }
+    THEN("Some, but not all, instructions are mutated") {
+      REQUIRE(total_mutated > 0);
+      REQUIRE(total_mutated < 100 * original.size());
+    }
+  }
+
+  WHEN("A shared program is mutated") {
+    auto shared = std::make_shared<const program_t>(original);
+    auto before = shared;
+    mutator.SetPerBitMutationRate(0.0);
+    mutator.MutateProgram(shared);
+    THEN("It is only replaced if it changed") {
+      REQUIRE(shared == before);
+      mutator.SetPerBitMutationRate(1.0);
+      mutator.MutateProgram(shared);
+      REQUIRE(shared != before);
+      REQUIRE(*before == original);
+    }
+  }
+}
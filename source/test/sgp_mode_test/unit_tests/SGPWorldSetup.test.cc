@@ -175,4 +175,47 @@ TEST_CASE("Setup correctly sets symbiont task profile functions", "[sgp][sgp-uni
 		symbiont.Delete();
 	}
 }
-	
\ No newline at end of file
+	
+TEST_CASE("Setup caches the config values used by instructions", "[sgp][sgp-unit]") {
+	sgpmode::SymConfigSGP config;
+	config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+	config.GRID_X(2);
+	config.GRID_Y(2);
+	config.SEED(44);
+	config.POP_SIZE(0);
+	config.HOST_MIN_CYCLES_BEFORE_REPRO(5);
+	config.SYM_MIN_CYCLES_BEFORE_REPRO(7);
+	config.HOST_ONLY_FIRST_TASK_CREDIT(1);
+	config.DONATION_STEAL_INST(0);
+	config.FREE_LIVING_SYMS(1);
+	emp::Random random(config.SEED());
+	world_t world(random, &config);
+	world.Setup();
+	const auto& settings = world.GetInstSettings();
+
+	THEN("Instruction settings match the config") {
+		REQUIRE(settings.host_min_cycles_before_repro == 5);
+		REQUIRE(settings.sym_min_cycles_before_repro == 7);
+		REQUIRE(settings.host_only_first_task_credit == true);
+	}
+
+	THEN("Only configured-out instructions are missing after rectification") {
+		const std::unordered_set<std::string> disabled = {"Donate", "Steal", "SenseTask"};
+		std::unordered_set<size_t> rectified_ops;
+		for (const auto op : world.GetOpcodeRectifier().mapper) rectified_ops.insert(op);
+		for (size_t op = 0; op < sgpmode::Library::GetSize(); ++op) {
+			const std::string name = sgpmode::Library::GetOpName(op);
+			REQUIRE(rectified_ops.contains(op) == !disabled.contains(name));
+		}
+	}
+
+	WHEN("The config changes between updates") {
+		config.HOST_MIN_CYCLES_BEFORE_REPRO(0);
+		config.HOST_ONLY_FIRST_TASK_CREDIT(0);
+		world.Update();
+		THEN("The next update uses the new values") {
+			REQUIRE(settings.host_min_cycles_before_repro == 0);
+			REQUIRE(settings.host_only_first_task_credit == false);
+		}
+	}
+}
@@ -132,3 +132,47 @@ TEST_CASE("Stack pops after limit resize", "[sgp]") {
     REQUIRE(stacks.GetActiveStack()[1] == 20);
 }
 
+
+TEST_CASE("InlineStacks push, pop, and switch stacks like Stacks", "[sgp]") {
+    sgpmode::InlineStacks<int, 2, 4> stacks;
+    REQUIRE(stacks.GetNumStacks() == 2);
+    REQUIRE(stacks.GetActiveStack().size() == 0);
+    REQUIRE(!stacks.GetTop().has_value());
+    REQUIRE(!stacks.Pop().has_value());
+
+    REQUIRE(stacks.Push(10));
+    REQUIRE(stacks.Push(20));
+    REQUIRE(stacks.GetTop().value() == 20);
+
+    stacks.ChangeActive();
+    REQUIRE(stacks.GetActiveStack().size() == 0);
+    REQUIRE(stacks.Push(30));
+
+    stacks.ChangeActive();
+    REQUIRE(stacks.GetActiveStack().size() == 2);
+    REQUIRE(stacks.GetActiveStack()[0] == 10);
+    REQUIRE(stacks.GetActiveStack()[1] == 20);
+    REQUIRE(stacks.Pop().value() == 20);
+    REQUIRE(stacks.Pop().value() == 10);
+    REQUIRE(!stacks.Pop().has_value());
+
+    stacks.ClearAll();
+    stacks.SetActive(1);
+    REQUIRE(stacks.GetActiveStack().size() == 0);
+}
+
+TEST_CASE("InlineStacks respect their capacity and stack limit", "[sgp]") {
+    sgpmode::InlineStacks<int, 1, 4> stacks;
+
+    // Limit can't be raised above capacity
+    stacks.SetStackLimit(100);
+    for (int i = 0; i < 4; ++i) REQUIRE(stacks.Push(i));
+    REQUIRE(stacks.Push(4) == false);
+
+    // Lowering the limit drops the top elements
+    stacks.SetStackLimit(2);
+    REQUIRE(stacks.GetActiveStack().size() == 2);
+    REQUIRE(stacks.GetActiveStack()[0] == 0);
+    REQUIRE(stacks.GetActiveStack()[1] == 1);
+    REQUIRE(stacks.Push(5) == false);
+}